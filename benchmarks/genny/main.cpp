@@ -0,0 +1,178 @@
+// Synthetic benchmark for the Genny SDK generator.
+// Builds a tree shaped like what ObjectExplorer::generate_sdk produces (dotted namespaces, parents,
+// fields, methods, arrays) and times building it, generating into an empty folder,
+// regenerating over the unchanged output and regenerating after touching a single class.
+// Also checks a few invariants of the name index the tree relies on before timing anything.
+//
+// usage: genny_benchmark [classes] [output dir]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <Genny.hpp>
+
+namespace {
+using Clock = std::chrono::high_resolution_clock;
+
+long long elapsed_ms(Clock::time_point start) {
+    return (long long)std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+}
+
+bool check(bool condition, const char* what) {
+    if (!condition) {
+        std::printf("FAILED: %s\n", what);
+    }
+
+    return condition;
+}
+
+// Array::count renames the array, which has to go through the name index,
+// otherwise the next array_() call finds the renamed array under its old name.
+bool check_arrays() {
+    genny::Sdk sdk{};
+    auto g = sdk.global_ns();
+    auto i32 = g->type("int32_t")->size(4);
+
+    auto a4 = i32->array_(4);
+    auto a8 = i32->array_(8);
+
+    auto ok = check(a4 != a8, "array_(4) and array_(8) returned the same type");
+    ok &= check(a4->count() == 4 && a8->count() == 8, "array counts");
+    ok &= check(a4->size() == 16 && a8->size() == 32, "array sizes");
+    ok &= check(a4->name() == "int32_t[4]" && a8->name() == "int32_t[8]", "array names");
+    ok &= check(g->find<genny::Array>("int32_t[4]") == a4, "find by the renamed name");
+    ok &= check(g->find<genny::Array>("int32_t[8]") == a8, "find by the renamed name");
+    ok &= check(g->find<genny::Array>("int32_t[0]") == nullptr, "the placeholder name is still indexed");
+
+    // Arrays of arrays keep the outer count first
+    auto a8x4 = a4->array_(8);
+    ok &= check(a8x4 != a4 && a8x4 != a8, "array_ of an array returned an existing type");
+    ok &= check(a8x4->name() == "int32_t[8][4]", "nested array name");
+
+    return ok;
+}
+
+bool check_index() {
+    genny::Sdk sdk{};
+    auto ns = sdk.global_ns()->namespace_("app")->namespace_("ropeway");
+    auto c = ns->class_("Foo");
+
+    auto ok = check(ns->class_("Foo") == c, "class_ didn't find the existing class");
+    ok &= check(ns->find<genny::Class>("Foo") == c, "find after add");
+
+    c->name("Bar");
+    ok &= check(ns->find<genny::Class>("Foo") == nullptr, "find by the old name after a rename");
+    ok &= check(ns->find<genny::Class>("Bar") == c, "find by the new name after a rename");
+
+    return ok;
+}
+
+void build_tree(genny::Sdk& sdk, size_t num_classes) {
+    auto g = sdk.global_ns();
+
+    auto i32 = g->type("int32_t")->size(4);
+    auto f32 = g->type("float")->size(4);
+    auto u64 = g->type("uint64_t")->size(8);
+
+    std::vector<genny::Namespace*> namespaces{};
+
+    // app.<area>.<subsystem>, like the game types
+    for (size_t i = 0; i < 64; ++i) {
+        namespaces.push_back(g->namespace_("app")->namespace_("area" + std::to_string(i % 8))->namespace_("sub" + std::to_string(i)));
+    }
+
+    std::vector<genny::Class*> classes{};
+    classes.reserve(num_classes);
+
+    for (size_t i = 0; i < num_classes; ++i) {
+        auto ns = namespaces[i % namespaces.size()];
+        auto c = ns->class_("Type" + std::to_string(i));
+
+        c->size(0x40);
+
+        // A wide hierarchy (depth ~log8(n)) like the game's, with most parents in other namespaces
+        if (i >= 8) {
+            c->parent(classes[i / 8]);
+        }
+
+        c->variable("m_id")->type(i32)->offset(0x10);
+        c->variable("m_scale")->type(f32)->offset(0x14);
+        c->variable("m_values")->type(f32->array_(4))->offset(0x18);
+        c->variable("m_flags")->type(u64)->offset(0x28);
+
+        if (i > 0) {
+            c->variable("m_other")->type(classes[i / 2]->ptr())->offset(0x30);
+        }
+
+        c->function("get_id")->returns(i32)->procedure("return m_id;");
+        c->function("set_scale")->param("scale")->type(f32);
+        c->static_function("get_instance")->returns(c->ptr());
+
+        classes.push_back(c);
+    }
+}
+}
+
+int main(int argc, char** argv) {
+    const auto num_classes = argc > 1 ? (size_t)std::strtoull(argv[1], nullptr, 10) : (size_t)100'000;
+    const auto out_dir = argc > 2 ? std::filesystem::path{argv[2]} : std::filesystem::temp_directory_path() / "genny_benchmark";
+
+    if (!check_arrays() || !check_index()) {
+        return 1;
+    }
+
+    std::error_code ec{};
+    std::filesystem::remove_all(out_dir, ec);
+
+    auto start = Clock::now();
+    genny::Sdk sdk{};
+    build_tree(sdk, num_classes);
+    const auto build_ms = elapsed_ms(start);
+
+    start = Clock::now();
+    sdk.generate(out_dir);
+    const auto generate_ms = elapsed_ms(start);
+
+    start = Clock::now();
+    sdk.generate(out_dir);
+    const auto regenerate_ms = elapsed_ms(start);
+
+    std::unordered_map<std::string, std::filesystem::file_time_type> write_times{};
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator{out_dir}) {
+        if (entry.is_regular_file()) {
+            write_times[entry.path().string()] = entry.last_write_time();
+        }
+    }
+
+    // Only the touched class' files should be rewritten
+    sdk.global_ns()->namespace_("app")->namespace_("area0")->namespace_("sub0")->class_("Type0")->function("added");
+
+    start = Clock::now();
+    sdk.generate(out_dir);
+    const auto touched_ms = elapsed_ms(start);
+
+    size_t num_rewritten = 0;
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator{out_dir}) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+
+        if (auto it = write_times.find(entry.path().string()); it == write_times.end() || it->second != entry.last_write_time()) {
+            ++num_rewritten;
+        }
+    }
+
+    std::printf("%zu classes, %zu files in %s\n", num_classes, write_times.size(), out_dir.string().c_str());
+    std::printf("build tree:               %lldms\n", build_ms);
+    std::printf("generate (empty folder):  %lldms\n", generate_ms);
+    std::printf("regenerate (unchanged):   %lldms\n", regenerate_ms);
+    std::printf("regenerate (one changed): %lldms, %zu files rewritten\n", touched_ms, num_rewritten);
+
+    return 0;
+}
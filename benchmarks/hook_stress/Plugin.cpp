@@ -0,0 +1,382 @@
+// Multi-threaded stress test for HookManager, loaded as a plugin.
+// All of the hooked calls are made by the engine's own threads, in bursts from the application entries
+// listed below, with the VM context of whichever thread runs the entry. Each phase lasts PHASE_FRAMES frames:
+//   1. System.Math.Max(System.Int32, System.Int32) unhooked
+//   2. the same, hooked with a pre and post callback
+//   3. the same, while a plugin thread keeps adding and removing a second hook on it
+//   4. System.String.GetHashCode() called through a string's vtable, while a plugin thread keeps hooking and
+//      unhooking that vtable slot. Every removal drops the last hook on the vtable, retiring a facilitator the
+//      engine threads may still be in. Some removals happen while holding a lock the hook's callback waits on
+//      (what a script reset does) and some hooks remove themselves from inside their own callback.
+// Every return value is checked, and in the hooked phases every call has to have gone through the callbacks,
+// so a frame shared between threads or a callback list torn by add/remove shows up as a failure.
+// A removal that deadlocks shows up as the test never logging its result.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+#include <Windows.h>
+#include <reframework/API.hpp>
+
+using API = reframework::API;
+
+namespace {
+using MaxFn = int32_t (*)(void* ctx, int32_t a, int32_t b);
+using HashFn = int32_t (*)(void* ctx, void* obj);
+
+constexpr uint64_t PHASE_FRAMES = 600;
+constexpr uint64_t WARMUP_FRAMES = 300;
+constexpr int32_t CALLS_PER_BURST = 256;
+
+// Spread over the frame, so the bursts run on whichever threads the engine schedules these on
+constexpr const char* ENTRIES[] = {
+    "UpdateBehavior",
+    "LateUpdateBehavior",
+    "UpdateMotion",
+    "UpdateEffect",
+    "UpdateGeometry",
+    "UpdatePhysicsCharacterController",
+    "BeginRendering",
+    "EndRendering",
+};
+
+enum Phase : uint32_t {
+    PHASE_IDLE,
+    PHASE_UNHOOKED,
+    PHASE_HOOKED,
+    PHASE_CHURN,
+    PHASE_VTABLE,
+    PHASE_COUNT,
+};
+
+constexpr const char* PHASE_NAMES[] = {
+    "idle",
+    "unhooked",
+    "hooked",
+    "hooked + add/remove churn",
+    "vtable calls + hook/remove churn",
+};
+
+struct PhaseResult {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> pre_calls{0};
+    std::atomic<uint64_t> post_calls{0};
+    std::atomic<uint64_t> wrong_results{0};
+    std::atomic<uint64_t> nanoseconds{0};
+
+    std::mutex threads_mux{};
+    std::unordered_set<DWORD> threads{};
+};
+
+std::atomic<uint32_t> g_phase{PHASE_IDLE};
+std::atomic<uint64_t> g_frames{0};
+PhaseResult g_results[PHASE_COUNT]{};
+
+API::Method* g_max_method{nullptr};
+API::Method* g_hash_method{nullptr};
+std::atomic<API::ManagedObject*> g_hash_object{nullptr};
+std::atomic<int64_t> g_expected_hash{INT64_MIN};
+
+thread_local uint64_t t_pre_calls{0};
+thread_local uint64_t t_post_calls{0};
+
+int pre_max(int argc, void** argv, REFrameworkTypeDefinitionHandle* arg_tys, unsigned long long ret_addr) {
+    ++t_pre_calls;
+    return REFRAMEWORK_HOOK_CALL_ORIGINAL;
+}
+
+void post_max(void** ret_val, REFrameworkTypeDefinitionHandle ret_ty, unsigned long long ret_addr) {
+    ++t_post_calls;
+}
+
+int pre_churn(int argc, void** argv, REFrameworkTypeDefinitionHandle* arg_tys, unsigned long long ret_addr) {
+    return REFRAMEWORK_HOOK_CALL_ORIGINAL;
+}
+
+void post_churn(void** ret_val, REFrameworkTypeDefinitionHandle ret_ty, unsigned long long ret_addr) {
+}
+
+// Stands in for the script state lock a Lua hook callback takes.
+std::mutex g_callback_mux{};
+std::atomic<unsigned int> g_self_remove_id{0};
+std::atomic<uint64_t> g_vtable_hooked_calls{0};
+
+int pre_vtable(void* userdata, int argc, void** argv, REFrameworkTypeDefinitionHandle* arg_tys, unsigned long long ret_addr) {
+    std::scoped_lock _{g_callback_mux};
+
+    ++g_vtable_hooked_calls;
+
+    // The hook removes itself from inside its own callback, while this thread is still in its facilitator
+    if (const auto id = g_self_remove_id.exchange(0); id != 0) {
+        g_hash_method->remove_hook(id);
+    }
+
+    return REFRAMEWORK_HOOK_CALL_ORIGINAL;
+}
+
+void post_vtable(void* userdata, void** ret_val, REFrameworkTypeDefinitionHandle ret_ty, unsigned long long ret_addr) {
+}
+
+// The same lookup the engine does for a virtual call, so a vtable hook (see REVTableHook) is picked up
+HashFn get_virtual_hash_fn() {
+    const auto object_info = *(uintptr_t*)g_hash_object.load();
+    const auto vtable = *(void***)(object_info - 0x10);
+
+    return (HashFn)vtable[g_hash_method->get_virtual_index()];
+}
+
+void burst() {
+    const auto ctx = API::get()->get_vm_context();
+
+    if (ctx == nullptr) {
+        return;
+    }
+
+    // Created on a game thread like everything else that touches the VM
+    static std::once_flag create_hash_object{};
+
+    std::call_once(create_hash_object, []() {
+        const auto str = (API::ManagedObject*)API::get()->sdk()->functions->create_managed_string(L"HookStress");
+
+        if (str != nullptr) {
+            str->add_ref();
+            g_hash_object = str;
+        }
+    });
+
+    const auto phase = g_phase.load();
+
+    if (phase == PHASE_IDLE) {
+        return;
+    }
+
+    const auto pre_before = t_pre_calls;
+    const auto post_before = t_post_calls;
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    uint64_t wrong_results = 0;
+
+    if (phase == PHASE_VTABLE) {
+        for (int32_t i = 0; i < CALLS_PER_BURST; ++i) {
+            const auto hash = (int64_t)get_virtual_hash_fn()(ctx, g_hash_object.load());
+            auto expected = INT64_MIN;
+
+            if (!g_expected_hash.compare_exchange_strong(expected, hash) && expected != hash) {
+                ++wrong_results;
+            }
+        }
+    } else {
+        const auto fn = g_max_method->get_function<MaxFn>();
+        const auto base = (int32_t)((GetCurrentThreadId() & 0x7FF) << 20);
+
+        // Unique per thread and call so a result leaking between frames can't go unnoticed
+        for (int32_t i = 0; i < CALLS_PER_BURST; ++i) {
+            if (fn(ctx, base | i, -1) != (base | i)) {
+                ++wrong_results;
+            }
+        }
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start);
+
+    // Straddled a phase change, which can add or remove the hooks midway
+    if (g_phase.load() != phase) {
+        return;
+    }
+
+    auto& result = g_results[phase];
+
+    result.calls += CALLS_PER_BURST;
+    result.pre_calls += t_pre_calls - pre_before;
+    result.post_calls += t_post_calls - post_before;
+    result.wrong_results += wrong_results;
+    result.nanoseconds += (uint64_t)elapsed.count();
+
+    std::scoped_lock _{result.threads_mux};
+    result.threads.insert(GetCurrentThreadId());
+}
+
+void wait_frames(uint64_t count) {
+    const auto target = g_frames.load() + count;
+
+    while (g_frames.load() < target) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+}
+
+void run_phase(Phase phase) {
+    g_phase = phase;
+    wait_frames(PHASE_FRAMES);
+    g_phase = PHASE_IDLE;
+
+    // Let bursts that started in this phase finish before anything is changed
+    wait_frames(2);
+
+    auto& result = g_results[phase];
+    std::scoped_lock _{result.threads_mux};
+
+    API::get()->log_info("[HookStress] %s: %.1fns/call on %zu threads (%llu calls, %llu pre, %llu post, %llu wrong results)",
+        PHASE_NAMES[phase], result.calls > 0 ? (double)result.nanoseconds / (double)result.calls : 0.0, result.threads.size(),
+        result.calls.load(), result.pre_calls.load(), result.post_calls.load(), result.wrong_results.load());
+}
+
+// Runs on its own thread and only follows the frame count, so a hook removal that hangs
+// never takes a game thread down with it.
+void run() {
+    const auto& api = API::get();
+
+    wait_frames(WARMUP_FRAMES);
+
+    api->log_info("[HookStress] Running, %llu frames per phase", PHASE_FRAMES);
+
+    run_phase(PHASE_UNHOOKED);
+
+    const auto hook_id = g_max_method->add_hook(pre_max, post_max, false);
+    run_phase(PHASE_HOOKED);
+
+    // Keep swapping a second hook in and out while the engine calls it
+    std::atomic<bool> stop_churn{false};
+    uint64_t churn_ops = 0;
+
+    std::thread churn{[&]() {
+        while (!stop_churn.load(std::memory_order_relaxed)) {
+            const auto id = g_max_method->add_hook(pre_churn, post_churn, false);
+            g_max_method->remove_hook(id);
+            ++churn_ops;
+        }
+    }};
+
+    run_phase(PHASE_CHURN);
+    stop_churn = true;
+    churn.join();
+
+    g_max_method->remove_hook(hook_id);
+
+    api->log_info("[HookStress] %llu add/remove pairs during churn", churn_ops);
+
+    const auto hash_object = g_hash_object.load();
+
+    if (hash_object == nullptr) {
+        api->log_error("[HookStress] FAILED: could not create the string to hook");
+        return;
+    }
+
+    // Every add hooks the vtable anew and every removal retires it
+    stop_churn = false;
+    uint64_t vtable_ops[3]{};
+
+    std::thread vtable_churn{[&]() {
+        for (uint64_t i = 0; !stop_churn.load(std::memory_order_relaxed); ++i) {
+            const auto id = g_hash_method->add_vtable_hook(hash_object, pre_vtable, post_vtable, nullptr);
+
+            if (id == 0) {
+                break;
+            }
+
+            // Give the engine threads a chance to get into the facilitator
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+
+            switch (i % 3) {
+            case 0:
+                g_hash_method->remove_hook(id);
+                break;
+            case 1: {
+                // A callback in flight may be blocked on this, removal must not wait for it
+                std::scoped_lock _{g_callback_mux};
+                g_hash_method->remove_hook(id);
+                break;
+            }
+            case 2: {
+                g_self_remove_id = id;
+
+                for (auto j = 0; j < 100 && g_self_remove_id.load() != 0; ++j) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+                }
+
+                // Nothing called through it in time
+                if (auto expected = id; g_self_remove_id.compare_exchange_strong(expected, 0)) {
+                    g_hash_method->remove_hook(id);
+                }
+
+                break;
+            }
+            }
+
+            ++vtable_ops[i % 3];
+        }
+    }};
+
+    run_phase(PHASE_VTABLE);
+    stop_churn = true;
+    vtable_churn.join();
+
+    api->log_info("[HookStress] vtable: %llu plain removals, %llu under the callback lock, %llu from inside the callback, %llu hooked calls",
+        vtable_ops[0], vtable_ops[1], vtable_ops[2], g_vtable_hooked_calls.load());
+
+    // Retired facilitators are freed a few frames after the last removal, the object has to outlive them
+    wait_frames(10);
+    hash_object->release();
+
+    const auto& hooked = g_results[PHASE_HOOKED];
+    const auto& churned = g_results[PHASE_CHURN];
+    const auto& vtable = g_results[PHASE_VTABLE];
+
+    uint64_t wrong_results = 0;
+
+    for (const auto& result : g_results) {
+        wrong_results += result.wrong_results;
+    }
+
+    // The main hook stays installed for the whole of both hooked phases, so it has to see every call
+    const auto failed = wrong_results > 0 || hooked.calls == 0 || vtable.calls == 0 || g_vtable_hooked_calls == 0
+        || hooked.pre_calls != hooked.calls || hooked.post_calls != hooked.calls
+        || churned.pre_calls != churned.calls || churned.post_calls != churned.calls;
+
+    if (failed) {
+        api->log_error("[HookStress] FAILED");
+    } else {
+        api->log_info("[HookStress] Passed");
+    }
+}
+
+void on_present() {
+    ++g_frames;
+}
+}
+
+extern "C" __declspec(dllexport) void reframework_plugin_required_version(REFrameworkPluginVersion* version) {
+    version->major = REFRAMEWORK_PLUGIN_VERSION_MAJOR;
+    version->minor = REFRAMEWORK_PLUGIN_VERSION_MINOR;
+    version->patch = REFRAMEWORK_PLUGIN_VERSION_PATCH;
+}
+
+extern "C" __declspec(dllexport) bool reframework_plugin_initialize(const REFrameworkPluginInitializeParam* param) {
+    const auto& api = API::initialize(param);
+    const auto tdb = api->tdb();
+
+    g_max_method = tdb->find_method("System.Math", "Max(System.Int32, System.Int32)");
+    g_hash_method = tdb->find_method("System.String", "GetHashCode");
+
+    if (g_max_method == nullptr || g_max_method->get_function_raw() == nullptr) {
+        api->log_error("[HookStress] Could not find System.Math.Max(System.Int32, System.Int32)");
+        return false;
+    }
+
+    if (g_hash_method == nullptr || g_hash_method->get_virtual_index() < 0) {
+        api->log_error("[HookStress] Could not find a virtual System.String.GetHashCode");
+        return false;
+    }
+
+    param->functions->on_present(on_present);
+
+    for (const auto entry : ENTRIES) {
+        param->functions->on_pre_application_entry(entry, burst);
+    }
+
+    std::thread{run}.detach();
+
+    return true;
+}
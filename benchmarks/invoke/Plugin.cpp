@@ -0,0 +1,106 @@
+// Benchmark for REMethodDefinition::invoke, loaded as a plugin.
+// Once the game is running, times a cheap static method (System.Math.Max(System.Int32, System.Int32))
+// called directly through its native function, through Method::invoke of the plugin API, and
+// through the same invoke with the argument vector rebuilt per call, then logs ns/call for each.
+// Runs from a game update callback since invoke needs the VM context of a game thread.
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <Windows.h>
+#include <reframework/API.hpp>
+
+using API = reframework::API;
+
+namespace {
+using MaxFn = int32_t (*)(void* ctx, int32_t a, int32_t b);
+
+constexpr uint32_t NUM_CALLS = 1'000'000;
+
+bool g_done{false};
+
+template <typename F>
+double time_ns_per_call(F&& f) {
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    for (uint32_t i = 0; i < NUM_CALLS; ++i) {
+        f((int32_t)i);
+    }
+
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start);
+
+    return elapsed.count() / NUM_CALLS;
+}
+
+void run() {
+    const auto& api = API::get();
+    const auto method = api->tdb()->find_method("System.Math", "Max(System.Int32, System.Int32)");
+
+    if (method == nullptr || method->get_function_raw() == nullptr) {
+        api->log_error("[InvokeBenchmark] Could not find System.Math.Max(System.Int32, System.Int32)");
+        return;
+    }
+
+    const auto fn = method->get_function<MaxFn>();
+    const auto ctx = api->get_vm_context();
+
+    uint64_t wrong_results = 0;
+    std::vector<void*> args{nullptr, (void*)(intptr_t)-1};
+
+    // Builds and caches the invoke plan, and checks the arguments go through as expected
+    for (int32_t i = 0; i < 1000; ++i) {
+        args[0] = (void*)(intptr_t)i;
+
+        const auto ret = method->invoke(nullptr, args);
+
+        if (ret.exception_thrown || (int32_t)ret.dword != i) {
+            ++wrong_results;
+        }
+    }
+
+    if (wrong_results > 0) {
+        api->log_error("[InvokeBenchmark] FAILED: %llu of 1000 invokes returned the wrong value", wrong_results);
+        return;
+    }
+
+    int64_t sink = 0;
+
+    const auto direct_ns = time_ns_per_call([&](int32_t i) {
+        sink += fn(ctx, i, -1);
+    });
+
+    const auto invoke_ns = time_ns_per_call([&](int32_t i) {
+        args[0] = (void*)(intptr_t)i;
+        sink += (int32_t)method->invoke(nullptr, args).dword;
+    });
+
+    const auto invoke_fresh_args_ns = time_ns_per_call([&](int32_t i) {
+        sink += (int32_t)method->invoke(nullptr, {(void*)(intptr_t)i, (void*)(intptr_t)-1}).dword;
+    });
+
+    api->log_info("[InvokeBenchmark] %u calls each: direct %.1fns, invoke %.1fns, invoke with a new argument vector %.1fns (%lld)",
+        NUM_CALLS, direct_ns, invoke_ns, invoke_fresh_args_ns, (long long)sink);
+}
+
+void on_pre_update_behavior() {
+    if (g_done) {
+        return;
+    }
+
+    g_done = true;
+    run();
+}
+}
+
+extern "C" __declspec(dllexport) void reframework_plugin_required_version(REFrameworkPluginVersion* version) {
+    version->major = REFRAMEWORK_PLUGIN_VERSION_MAJOR;
+    version->minor = REFRAMEWORK_PLUGIN_VERSION_MINOR;
+    version->patch = REFRAMEWORK_PLUGIN_VERSION_PATCH;
+}
+
+extern "C" __declspec(dllexport) bool reframework_plugin_initialize(const REFrameworkPluginInitializeParam* param) {
+    API::initialize(param);
+    param->functions->on_pre_application_entry("UpdateBehavior", on_pre_update_behavior);
+
+    return true;
+}
@@ -0,0 +1,210 @@
+// Throughput harness for utility::ScanBatch.
+// Fills a buffer with random bytes, plants a set of patterns at known offsets (including the very
+// start and end of the buffer and across scan chunk boundaries), then checks that one batched pass
+// finds exactly those and reports GB/s. Also times the equivalent utility::scan calls for comparison.
+//
+// usage: scan_batch_benchmark [buffer MB] [patterns] [runs]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <utility/Scan.hpp>
+#include <utility/ScanBatch.hpp>
+
+namespace {
+using Clock = std::chrono::high_resolution_clock;
+
+struct PlantedPattern {
+    std::string pattern{};
+    std::vector<int> bytes{}; // -1 = wildcard
+    bool find_all{};
+    std::vector<size_t> offsets{}; // ascending
+};
+
+std::string to_pattern(const std::vector<int>& bytes) {
+    std::string out{};
+
+    for (const auto b : bytes) {
+        char buf[4]{};
+
+        if (b < 0) {
+            std::snprintf(buf, sizeof(buf), "? ");
+        } else {
+            std::snprintf(buf, sizeof(buf), "%02X ", b);
+        }
+
+        out += buf;
+    }
+
+    out.pop_back();
+    return out;
+}
+
+void plant(std::vector<uint8_t>& buffer, const PlantedPattern& p, size_t offset) {
+    for (size_t i = 0; i < p.bytes.size(); ++i) {
+        if (p.bytes[i] >= 0) {
+            buffer[offset + i] = (uint8_t)p.bytes[i];
+        }
+    }
+}
+}
+
+int main(int argc, char** argv) {
+    const auto buffer_mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256ull;
+    const auto num_patterns = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64ull;
+    const auto num_runs = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 5ull;
+
+    constexpr size_t SLOT_SIZE = 64; // every planted pattern gets its own slot so they can't overlap
+    constexpr size_t MAX_PATTERN_LENGTH = 32;
+    constexpr size_t MIN_KNOWN_BYTES = 10; // so the random bytes around them can't match by accident
+    constexpr size_t CHUNK_SIZE = 1 << 20; // same as ScanBatch's, to plant across the boundaries
+
+    std::mt19937_64 rng{1337};
+    std::vector<uint8_t> buffer(buffer_mb << 20);
+
+    for (size_t i = 0; i + 8 <= buffer.size(); i += 8) {
+        const auto value = rng();
+        std::memcpy(&buffer[i], &value, 8);
+    }
+
+    const auto num_slots = buffer.size() / SLOT_SIZE;
+    std::unordered_set<size_t> used_slots{CHUNK_SIZE / SLOT_SIZE - 1, CHUNK_SIZE / SLOT_SIZE}; // see the edges below
+
+    const auto take_slot = [&]() {
+        for (;;) {
+            const auto slot = std::uniform_int_distribution<size_t>{1, num_slots - 2}(rng);
+
+            if (used_slots.insert(slot).second) {
+                return slot * SLOT_SIZE;
+            }
+        }
+    };
+
+    std::vector<PlantedPattern> patterns(num_patterns);
+
+    for (size_t i = 0; i < num_patterns; ++i) {
+        auto& p = patterns[i];
+        const auto length = std::uniform_int_distribution<size_t>{MIN_KNOWN_BYTES, MAX_PATTERN_LENGTH}(rng);
+        size_t num_wildcards = 0;
+
+        for (size_t j = 0; j < length; ++j) {
+            // Wildcards where displacements/immediates would be, never at the ends
+            const auto wildcard = j > 0 && j + 1 < length && num_wildcards + MIN_KNOWN_BYTES < length && rng() % 5 == 0;
+
+            num_wildcards += wildcard ? 1 : 0;
+            p.bytes.push_back(wildcard ? -1 : (int)(rng() & 0xFF));
+        }
+
+        p.pattern = to_pattern(p.bytes);
+        p.find_all = i % 4 == 0;
+
+        // A few that aren't in the buffer at all
+        if (i % 16 == 15) {
+            continue;
+        }
+
+        const auto count = p.find_all ? 1 + rng() % 8 : 1 + rng() % 2;
+
+        for (size_t j = 0; j < count; ++j) {
+            p.offsets.push_back(take_slot());
+        }
+    }
+
+    // Edges: the start of the buffer, the last possible offset and straddling a chunk boundary
+    if (num_patterns >= 3 && buffer.size() > CHUNK_SIZE * 2) {
+        patterns[0].offsets.push_back(0);
+        patterns[1].offsets.push_back(buffer.size() - patterns[1].bytes.size());
+        patterns[2].offsets.push_back(CHUNK_SIZE - patterns[2].bytes.size() / 2);
+    }
+
+    for (auto& p : patterns) {
+        std::sort(p.offsets.begin(), p.offsets.end());
+
+        for (const auto offset : p.offsets) {
+            plant(buffer, p, offset);
+        }
+    }
+
+    const auto start = (uintptr_t)buffer.data();
+    uint32_t failures = 0;
+    double best_seconds = 0.0;
+
+    for (size_t run = 0; run < num_runs; ++run) {
+        utility::ScanBatch batch{};
+        std::vector<utility::ScanBatch::Id> ids{};
+
+        for (const auto& p : patterns) {
+            ids.push_back(batch.add(p.pattern, p.find_all));
+        }
+
+        const auto run_start = Clock::now();
+        batch.run(start, buffer.size());
+        const auto seconds = std::chrono::duration<double>(Clock::now() - run_start).count();
+
+        best_seconds = run == 0 ? seconds : std::min(best_seconds, seconds);
+
+        if (run > 0) {
+            continue;
+        }
+
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            const auto& p = patterns[i];
+            const auto found = batch.get(ids[i]);
+            const auto expected = p.offsets.empty() ? std::nullopt : std::optional<uintptr_t>{start + p.offsets.front()};
+
+            if (found != expected) {
+                std::printf("FAILED: %s expected %s, got %s\n", p.pattern.c_str(),
+                    expected ? std::to_string(*expected - start).c_str() : "nothing",
+                    found ? std::to_string(*found - start).c_str() : "nothing");
+                ++failures;
+            }
+
+            if (!p.find_all) {
+                continue;
+            }
+
+            std::vector<uintptr_t> expected_all{};
+
+            for (const auto offset : p.offsets) {
+                expected_all.push_back(start + offset);
+            }
+
+            if (batch.get_all(ids[i]) != expected_all) {
+                std::printf("FAILED: %s expected %zu matches, got %zu\n", p.pattern.c_str(), expected_all.size(), batch.get_all(ids[i]).size());
+                ++failures;
+            }
+        }
+    }
+
+    if (failures > 0) {
+        return 1;
+    }
+
+    const auto gb = (double)buffer.size() / (1024.0 * 1024.0 * 1024.0);
+
+    std::printf("ScanBatch: %zu patterns over %zuMB in %.2fms (best of %zu), %.2f GB/s\n",
+        patterns.size(), (size_t)buffer_mb, best_seconds * 1000.0, (size_t)num_runs, gb / best_seconds);
+
+    // What initialization used to do, one utility::scan per pattern (find_first only, find_all needs a rescan per match)
+    const auto scan_start = Clock::now();
+    size_t scan_found = 0;
+
+    for (const auto& p : patterns) {
+        if (utility::scan(start, buffer.size(), p.pattern)) {
+            ++scan_found;
+        }
+    }
+
+    const auto scan_seconds = std::chrono::duration<double>(Clock::now() - scan_start).count();
+
+    std::printf("utility::scan: %zu separate scans in %.2fms (%zu found)\n", patterns.size(), scan_seconds * 1000.0, scan_found);
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+// Compares the flat type name index RETypeDB uses for find_type/find_type_by_fqn
+// against the linear scan it replaced, over a TDB snapshot captured in-game
+// with ObjectExplorer's "Dump TDB Snapshot" button.
+//
+// usage: type_index_benchmark <tdb_snapshot.bin> [scan queries]
+//
+// The scan here compares names already sitting in the snapshot, while the old in-game scan
+// built a std::string through get_full_name for every type it passed, so the real gap is larger.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <sdk/helpers/TypeNameIndex.hpp>
+#include <tdb_snapshot/Snapshot.hpp>
+
+namespace {
+using Clock = std::chrono::high_resolution_clock;
+
+double elapsed_ns(Clock::time_point start) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+uint32_t scan_by_name(const std::vector<std::string_view>& names, std::string_view name) {
+    for (uint32_t i = 0; i < names.size(); ++i) {
+        if (names[i] == name) {
+            return i;
+        }
+    }
+
+    return sdk::helpers::TypeNameIndex::INVALID_INDEX;
+}
+
+uint32_t scan_by_fqn(const std::vector<uint32_t>& fqns, uint32_t fqn) {
+    for (uint32_t i = 0; i < fqns.size(); ++i) {
+        if (fqns[i] == fqn) {
+            return i;
+        }
+    }
+
+    return sdk::helpers::TypeNameIndex::INVALID_INDEX;
+}
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::printf("usage: %s <tdb_snapshot.bin> [scan queries]\n", argv[0]);
+        return 1;
+    }
+
+    const auto snapshot = tdb_snapshot::Snapshot::open(argv[1]);
+
+    if (snapshot == nullptr) {
+        std::printf("failed to open snapshot %s\n", argv[1]);
+        return 1;
+    }
+
+    const auto num_types = snapshot->get_num_types();
+    const auto num_scan_queries = argc > 2 ? (uint32_t)std::strtoul(argv[2], nullptr, 10) : 2000u;
+
+    std::vector<std::string_view> names(num_types);
+    std::vector<uint32_t> fqns(num_types);
+
+    for (uint32_t i = 0; i < num_types; ++i) {
+        const auto t = snapshot->get_type(i);
+
+        names[i] = t.get_full_name();
+        fqns[i] = t.get_fqn_hash();
+    }
+
+    std::printf("%.*s: %u types\n", (int)snapshot->get_game_name().size(), snapshot->get_game_name().data(), num_types);
+
+    sdk::helpers::TypeNameIndex index{};
+
+    const auto build_start = Clock::now();
+    index.build_fqn(num_types, [&](uint32_t i) { return fqns[i]; });
+    index.build_names(names);
+    const auto build_ns = elapsed_ns(build_start);
+
+    std::printf("build: %.2fms (%zu bytes of names)\n", build_ns / 1'000'000.0, index.get_name_pool_size());
+
+    // Every type once in random order, plus misses, which were the worst case for the scan
+    std::vector<std::string> queries{};
+    queries.reserve((size_t)num_types + num_types / 10);
+
+    for (const auto name : names) {
+        queries.emplace_back(name);
+    }
+
+    for (uint32_t i = 0; i < num_types / 10; ++i) {
+        queries.emplace_back(std::string{names[i]} + "_missing");
+    }
+
+    std::mt19937 rng{1337};
+    std::shuffle(queries.begin(), queries.end(), rng);
+
+    // Results have to match what the scan would return, duplicates resolve to the lowest index
+    std::unordered_map<std::string_view, uint32_t> first_by_name{};
+    std::unordered_map<uint32_t, uint32_t> first_by_fqn{};
+
+    for (uint32_t i = 0; i < num_types; ++i) {
+        first_by_name.emplace(names[i], i);
+        first_by_fqn.emplace(fqns[i], i);
+    }
+
+    uint32_t mismatches = 0;
+
+    for (const auto& query : queries) {
+        const auto it = first_by_name.find(query);
+        const auto expected = it != first_by_name.end() ? it->second : sdk::helpers::TypeNameIndex::INVALID_INDEX;
+
+        if (index.find_by_name(query) != expected) {
+            ++mismatches;
+        }
+    }
+
+    for (const auto fqn : fqns) {
+        if (index.find_by_fqn(fqn) != first_by_fqn[fqn]) {
+            ++mismatches;
+        }
+    }
+
+    if (mismatches > 0) {
+        std::printf("FAILED: %u lookups differ from the linear scan\n", mismatches);
+        return 1;
+    }
+
+    uint64_t sink = 0;
+
+    const auto index_start = Clock::now();
+
+    for (const auto& query : queries) {
+        sink += index.find_by_name(query);
+    }
+
+    const auto index_name_ns = elapsed_ns(index_start) / std::max<size_t>(queries.size(), 1);
+
+    const auto index_fqn_start = Clock::now();
+
+    for (const auto fqn : fqns) {
+        sink += index.find_by_fqn(fqn);
+    }
+
+    const auto index_fqn_ns = elapsed_ns(index_fqn_start) / std::max<size_t>(fqns.size(), 1);
+
+    const auto scan_count = std::min<size_t>(num_scan_queries, queries.size());
+    const auto scan_start = Clock::now();
+
+    for (size_t i = 0; i < scan_count; ++i) {
+        sink += scan_by_name(names, queries[i]);
+    }
+
+    const auto scan_name_ns = elapsed_ns(scan_start) / std::max<size_t>(scan_count, 1);
+
+    const auto scan_fqn_start = Clock::now();
+
+    for (size_t i = 0; i < std::min<size_t>(scan_count, fqns.size()); ++i) {
+        sink += scan_by_fqn(fqns, fqns[(i * 7919) % fqns.size()]);
+    }
+
+    const auto scan_fqn_ns = elapsed_ns(scan_fqn_start) / std::max<size_t>(std::min<size_t>(scan_count, fqns.size()), 1);
+
+    std::printf("find_type:        index %8.1fns  scan %12.1fns  (%zu / %zu queries)\n", index_name_ns, scan_name_ns, queries.size(), scan_count);
+    std::printf("find_type_by_fqn: index %8.1fns  scan %12.1fns\n", index_fqn_ns, scan_fqn_ns);
+    std::printf("checksum: %llu\n", (unsigned long long)sink);
+
+    return 0;
+}
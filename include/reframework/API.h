@@ -7,7 +7,7 @@
 #endif
 
 #define REFRAMEWORK_PLUGIN_VERSION_MAJOR 1
-#define REFRAMEWORK_PLUGIN_VERSION_MINOR 7
+#define REFRAMEWORK_PLUGIN_VERSION_MINOR 9
 #define REFRAMEWORK_PLUGIN_VERSION_PATCH 0
 
 #define REFRAMEWORK_RENDERER_D3D11 0
@@ -347,6 +347,10 @@ typedef struct {
 typedef int (*REFPreHookFn)(int argc, void** argv, REFrameworkTypeDefinitionHandle* arg_tys, unsigned long long ret_addr);
 typedef void (*REFPostHookFn)(void** ret_val, REFrameworkTypeDefinitionHandle ret_ty, unsigned long long ret_addr);
 
+/* Same as above, but called directly with the userdata passed to add_hook_with_userdata */
+typedef int (*REFPreHookWithUserdataFn)(void* userdata, int argc, void** argv, REFrameworkTypeDefinitionHandle* arg_tys, unsigned long long ret_addr);
+typedef void (*REFPostHookWithUserdataFn)(void* userdata, void** ret_val, REFrameworkTypeDefinitionHandle ret_ty, unsigned long long ret_addr);
+
 typedef struct {
     REFrameworkTDBHandle (*get_tdb)();
     REFrameworkResourceManagerHandle (*get_resource_manager)();
@@ -369,6 +373,11 @@ typedef struct {
 
     void* (*allocate)(unsigned long long size);
     void (*deallocate)(void*);
+
+    unsigned int (*add_hook_with_userdata)(REFrameworkMethodHandle, REFPreHookWithUserdataFn, REFPostHookWithUserdataFn, void* userdata, bool ignore_jmp);
+
+    /* Hooks the method in this object's vtable only, removed with remove_hook */
+    unsigned int (*add_vtable_hook_with_userdata)(REFrameworkManagedObjectHandle, REFrameworkMethodHandle, REFPreHookWithUserdataFn, REFPostHookWithUserdataFn, void* userdata);
 } REFrameworkSDKFunctions;
 
 /* these are NOT pointers to the actual objects */
@@ -540,6 +540,15 @@ public:
             return API::s_instance->sdk()->functions->add_hook(*this, pre_fn, post_fn, ignore_jmp);
         }
 
+        unsigned int add_hook(REFPreHookWithUserdataFn pre_fn, REFPostHookWithUserdataFn post_fn, void* userdata, bool ignore_jmp) const {
+            return API::s_instance->sdk()->functions->add_hook_with_userdata(*this, pre_fn, post_fn, userdata, ignore_jmp);
+        }
+
+        // Only calls made through obj's vtable are hooked.
+        unsigned int add_vtable_hook(API::ManagedObject* obj, REFPreHookWithUserdataFn pre_fn, REFPostHookWithUserdataFn post_fn, void* userdata) const {
+            return API::s_instance->sdk()->functions->add_vtable_hook_with_userdata((REFrameworkManagedObjectHandle)obj, *this, pre_fn, post_fn, userdata);
+        }
+
         void remove_hook(unsigned int hook_id) const {
             API::s_instance->sdk()->functions->remove_hook(*this, hook_id);
         }
@@ -0,0 +1,76 @@
+-- Measures how many native method calls per second scripts can make through the different call paths.
+-- Drop it in the autorun folder and hit "Run" under "Method Call Benchmark".
+
+local iterations = 100000
+local results = {}
+
+local transform_get_position = sdk.find_type_definition("via.Transform"):get_method("get_Position")
+local transform_t = sdk.find_type_definition("via.Transform")
+
+local function measure(name, fn)
+    local start = os.clock()
+    fn()
+    local elapsed = os.clock() - start
+
+    table.insert(results, string.format("%s: %.3f ms (%.0f calls/s)", name, elapsed * 1000.0, iterations / math.max(elapsed, 0.000001)))
+end
+
+local function run_benchmark()
+    results = {}
+
+    local camera = sdk.get_primary_camera()
+
+    if camera == nil then
+        table.insert(results, "No primary camera, nothing to call methods on")
+        return
+    end
+
+    local game_object = camera:get_GameObject()
+    local transform = game_object ~= nil and game_object:get_Transform() or nil
+
+    if transform == nil then
+        table.insert(results, "Camera has no transform")
+        return
+    end
+
+    measure("obj:get_Position()", function()
+        for i = 1, iterations do
+            transform:get_Position()
+        end
+    end)
+
+    measure("obj:call(\"get_Position\")", function()
+        for i = 1, iterations do
+            transform:call("get_Position")
+        end
+    end)
+
+    measure("method:call(obj)", function()
+        for i = 1, iterations do
+            transform_get_position:call(transform)
+        end
+    end)
+
+    measure("sdk.call_native_func", function()
+        for i = 1, iterations do
+            sdk.call_native_func(transform, transform_t, "get_Position")
+        end
+    end)
+end
+
+re.on_draw_ui(function()
+    if imgui.tree_node("Method Call Benchmark") then
+        local changed = false
+        changed, iterations = imgui.slider_int("Iterations", iterations, 1000, 1000000)
+
+        if imgui.button("Run") then
+            run_benchmark()
+        end
+
+        for _, result in ipairs(results) do
+            imgui.text(result)
+        end
+
+        imgui.tree_pop()
+    end
+end)
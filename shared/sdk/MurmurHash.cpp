@@ -1,3 +1,12 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+
+#include <intrin.h>
+#include <immintrin.h>
+
+#include <spdlog/spdlog.h>
 #include <utility/String.hpp>
 
 #include "RETypeDB.hpp"
@@ -6,18 +15,216 @@
 #include "MurmurHash.hpp"
 
 namespace sdk::murmur_hash {
+// Reference values from MurmurHash3_x86_32 over the UTF-16LE bytes.
+// verify_against_engine checks the same strings against the engine itself at startup.
+static_assert(calc32_constexpr(L"") == 0x81f16f39);
+static_assert(calc32_constexpr(L"root") == 0xaba7de3c);
+static_assert(calc32_constexpr(L"head") == 0x2bf882e3);
+static_assert(calc32_constexpr(L"COG") == 0xcc3297ea);
+static_assert(calc32_constexpr(L"Neck_0") == 0xc352c22b);
+static_assert(calc32_constexpr(L"l_arm_wrist") == 0xeb6aaf75);
+static_assert(calc32_constexpr(L"vfx_muzzle1") == 0xaccc466a);
+static_assert(calc32_constexpr(L"\u4E2D") == 0x82d924b3);
+
+namespace detail {
+// Set if verify_against_engine found a mismatch, calc32 then goes through the engine like it used to.
+std::atomic<bool> g_use_engine{false};
+
+uint32_t calc32_engine(std::wstring_view str) {
+    static auto calc_method = type()->get_method("calc32");
+
+    return calc_method->call<uint32_t>(sdk::get_thread_context(), sdk::VM::create_managed_string(str));
+}
+
+bool has_avx2() {
+    static const bool result = []() {
+        int regs[4]{};
+
+        __cpuid(regs, 0);
+
+        if (regs[0] < 7) {
+            return false;
+        }
+
+        __cpuid(regs, 1);
+
+        const auto osxsave = (regs[2] & (1 << 27)) != 0;
+        const auto avx = (regs[2] & (1 << 28)) != 0;
+
+        // The OS has to save the YMM registers too.
+        if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) {
+            return false;
+        }
+
+        __cpuidex(regs, 7, 0);
+
+        return (regs[1] & (1 << 5)) != 0;
+    }();
+
+    return result;
+}
+
+uint32_t load_block(const wchar_t* data) {
+    if constexpr (sizeof(wchar_t) == sizeof(uint16_t)) {
+        uint32_t k{};
+        memcpy(&k, data, sizeof(k));
+        return k;
+    } else {
+        return (uint32_t)(uint16_t)data[0] | ((uint32_t)(uint16_t)data[1] << 16);
+    }
+}
+
+template <int R>
+__m256i rotl_x8(__m256i x) {
+    return _mm256_or_si256(_mm256_slli_epi32(x, R), _mm256_srli_epi32(x, 32 - R));
+}
+
+__m256i mix_k_x8(__m256i k) {
+    k = _mm256_mullo_epi32(k, _mm256_set1_epi32((int)0xcc9e2d51));
+    k = rotl_x8<15>(k);
+    return _mm256_mullo_epi32(k, _mm256_set1_epi32(0x1b873593));
+}
+
+// Hashes 8 strings, one per lane. Lanes that run out of blocks keep their hash through a blend.
+void calc32_x8(const std::wstring_view* strs, uint32_t* out) {
+    alignas(32) int32_t num_blocks[8]{};
+    alignas(32) uint32_t k[8]{};
+    alignas(32) uint32_t lengths[8]{};
+    int32_t max_blocks = 0;
+
+    for (auto i = 0; i < 8; ++i) {
+        num_blocks[i] = (int32_t)(strs[i].size() / 2);
+        lengths[i] = (uint32_t)(strs[i].size() * sizeof(uint16_t));
+        max_blocks = std::max(max_blocks, num_blocks[i]);
+    }
+
+    const auto blocks_v = _mm256_load_si256((const __m256i*)num_blocks);
+    auto h = _mm256_set1_epi32((int)SEED);
+
+    for (int32_t b = 0; b < max_blocks; ++b) {
+        for (auto i = 0; i < 8; ++i) {
+            k[i] = b < num_blocks[i] ? load_block(strs[i].data() + b * 2) : 0;
+        }
+
+        auto mixed = _mm256_xor_si256(h, mix_k_x8(_mm256_load_si256((const __m256i*)k)));
+        mixed = rotl_x8<13>(mixed);
+        mixed = _mm256_add_epi32(_mm256_mullo_epi32(mixed, _mm256_set1_epi32(5)), _mm256_set1_epi32((int)0xe6546b64));
+
+        const auto active = _mm256_cmpgt_epi32(blocks_v, _mm256_set1_epi32(b));
+        h = _mm256_blendv_epi8(h, mixed, active);
+    }
+
+    // A zero tail mixes to zero, so lanes without one are unaffected.
+    for (auto i = 0; i < 8; ++i) {
+        k[i] = (strs[i].size() & 1) != 0 ? (uint16_t)strs[i].back() : 0;
+    }
+
+    h = _mm256_xor_si256(h, mix_k_x8(_mm256_load_si256((const __m256i*)k)));
+    h = _mm256_xor_si256(h, _mm256_load_si256((const __m256i*)lengths));
+
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+    h = _mm256_mullo_epi32(h, _mm256_set1_epi32((int)0x85ebca6b));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 13));
+    h = _mm256_mullo_epi32(h, _mm256_set1_epi32((int)0xc2b2ae35));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+
+    _mm256_storeu_si256((__m256i*)out, h);
+}
+}
+
 sdk::RETypeDefinition* type() {
     static auto t = sdk::find_type_definition("via.murmur_hash");
     return t;
 }
 
 uint32_t calc32(std::wstring_view str) {
-    static auto calc_method = type()->get_method("calc32");
+    if (detail::g_use_engine.load(std::memory_order_relaxed)) {
+        return detail::calc32_engine(str);
+    }
 
-    return calc_method->call<uint32_t>(sdk::get_thread_context(), sdk::VM::create_managed_string(str));
+    auto h = SEED;
+    size_t i = 0;
+
+    for (; i + 1 < str.size(); i += 2) {
+        h = detail::mix_h(h, detail::load_block(str.data() + i));
+    }
+
+    if (i < str.size()) {
+        h ^= detail::mix_k((uint16_t)str[i]);
+    }
+
+    return detail::fmix(h ^ (uint32_t)(str.size() * sizeof(uint16_t)));
 }
 
 uint32_t calc32(std::string_view str) {
-    return calc32(utility::widen(str));
+    if (detail::g_use_engine.load(std::memory_order_relaxed)) {
+        return detail::calc32_engine(utility::widen(str));
+    }
+
+    // ASCII maps 1:1 onto UTF-16 code units, so it can be hashed without widening.
+    for (auto c : str) {
+        if ((uint8_t)c >= 0x80) {
+            return calc32(utility::widen(str));
+        }
+    }
+
+    auto h = SEED;
+    size_t i = 0;
+
+    for (; i + 1 < str.size(); i += 2) {
+        h = detail::mix_h(h, (uint32_t)(uint8_t)str[i] | ((uint32_t)(uint8_t)str[i + 1] << 16));
+    }
+
+    if (i < str.size()) {
+        h ^= detail::mix_k((uint8_t)str[i]);
+    }
+
+    return detail::fmix(h ^ (uint32_t)(str.size() * sizeof(uint16_t)));
+}
+
+void calc32(std::span<const std::wstring_view> strs, std::span<uint32_t> out) {
+    const auto count = std::min(strs.size(), out.size());
+    size_t i = 0;
+
+    if (detail::has_avx2() && !detail::g_use_engine.load(std::memory_order_relaxed)) {
+        for (; i + 8 <= count; i += 8) {
+            detail::calc32_x8(&strs[i], &out[i]);
+        }
+    }
+
+    for (; i < count; ++i) {
+        out[i] = calc32(strs[i]);
+    }
+}
+
+bool verify_against_engine() {
+    // Joint names the mods hash, odd and even lengths, and non-ASCII. At least 8 so the AVX2 path runs too.
+    constexpr std::array<std::wstring_view, 10> strs{
+        L"", L"root", L"head", L"Head", L"COG", L"Neck_0", L"l_arm_wrist", L"vfx_muzzle1", L"\u4E2D", L"\u00E9t\u00E9_joint",
+    };
+
+    if (type() == nullptr || type()->get_method("calc32") == nullptr) {
+        spdlog::error("[MurmurHash] via.murmur_hash.calc32 not found, can't verify the native hash");
+        return false;
+    }
+
+    std::array<uint32_t, strs.size()> batched{};
+    calc32(strs, batched);
+
+    for (size_t i = 0; i < strs.size(); ++i) {
+        const auto expected = detail::calc32_engine(strs[i]);
+        const auto native = calc32(strs[i]);
+
+        if (native != expected || batched[i] != expected || calc32_constexpr(strs[i]) != expected) {
+            spdlog::error("[MurmurHash] Native hash of \"{}\" is {:x} ({:x} batched), the engine's is {:x}. Using the engine's from now on",
+                utility::narrow(strs[i]), native, batched[i], expected);
+
+            detail::g_use_engine = true;
+            return false;
+        }
+    }
+
+    spdlog::info("[MurmurHash] Native hash matches via.murmur_hash.calc32");
+    return true;
 }
 }
@@ -1,15 +1,74 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include <string_view>
 
 // via.murmur_hash internally
+// The engine hashes the UTF-16 code units of a string with MurmurHash3 (x86, 32 bit) and a seed of 0xFFFFFFFF.
 namespace sdk {
 struct RETypeDefinition;
 
 namespace murmur_hash {
+constexpr uint32_t SEED = 0xFFFFFFFF;
+
+namespace detail {
+constexpr uint32_t rotl(uint32_t x, int r) {
+    return (x << r) | (x >> (32 - r));
+}
+
+constexpr uint32_t mix_k(uint32_t k) {
+    k *= 0xcc9e2d51;
+    k = rotl(k, 15);
+    k *= 0x1b873593;
+    return k;
+}
+
+constexpr uint32_t mix_h(uint32_t h, uint32_t k) {
+    h ^= mix_k(k);
+    h = rotl(h, 13);
+    return h * 5 + 0xe6546b64;
+}
+
+constexpr uint32_t fmix(uint32_t h) {
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+    return h;
+}
+}
+
+// Same result as calc32, but usable at compile time for literal joint and resource names.
+// e.g. constexpr auto head_hash = sdk::murmur_hash::calc32_constexpr(L"head");
+constexpr uint32_t calc32_constexpr(std::wstring_view str) {
+    auto h = SEED;
+    size_t i = 0;
+
+    for (; i + 1 < str.size(); i += 2) {
+        h = detail::mix_h(h, (uint32_t)(uint16_t)str[i] | ((uint32_t)(uint16_t)str[i + 1] << 16));
+    }
+
+    if (i < str.size()) {
+        h ^= detail::mix_k((uint16_t)str[i]);
+    }
+
+    return detail::fmix(h ^ (uint32_t)(str.size() * sizeof(uint16_t)));
+}
+
 sdk::RETypeDefinition* type();
+
+// Native, doesn't touch the VM.
 uint32_t calc32(std::wstring_view str);
 uint32_t calc32(std::string_view str);
+
+// Hashes many strings at once, out must be at least as large as strs.
+// Uses AVX2 to hash 8 strings side by side when the CPU supports it.
+void calc32(std::span<const std::wstring_view> strs, std::span<uint32_t> out);
+
+// Checks calc32 against the engine's via.murmur_hash.calc32 on a few strings, needs the VM.
+// On a mismatch calc32 goes through the engine from then on (calc32_constexpr can't, it only gets logged).
+bool verify_against_engine();
+}
 }
-}
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "utility/Scan.hpp"
 #include "utility/Module.hpp"
+#include "utility/ScanBatch.hpp"
 
 #include "RETypeDB.hpp"
 #include "REType.hpp"
@@ -11,6 +12,11 @@
 
 #include "REGlobals.hpp"
 
+namespace {
+// generic pattern used for all these globals
+const utility::CachedScan globals_pattern{"48 8D ? ? ? ? ? 48 B8 00 00 00 00 00 00 00 80", true};
+}
+
 namespace reframework {
 std::unique_ptr<REGlobals>& get_globals() {
     static auto globals = std::make_unique<REGlobals>();
@@ -27,12 +33,9 @@ REGlobals::REGlobals() {
     auto start = (uintptr_t)mod;
     auto end = (uintptr_t)start + *utility::get_module_size(mod);
 
-    // generic pattern used for all these globals
-    auto pat = std::string{ "48 8D ? ? ? ? ? 48 B8 00 00 00 00 00 00 00 80" };
-
     // find all the globals
-    for (auto i = utility::scan(start, end - start, pat); i.has_value(); i = utility::scan(*i + 1, end - (*i + 1), pat)) {
-        auto ptr = utility::calculate_absolute(*i + 3);
+    for (const auto i : utility::scan_all_cached(mod, globals_pattern)) {
+        auto ptr = utility::calculate_absolute(i + 3);
 
         // Make sure the global is within the module boundaries
         if (ptr < start || ptr > (end - 8)) {
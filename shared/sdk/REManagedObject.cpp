@@ -353,6 +353,15 @@ bool is_a(::REManagedObject* object, std::string_view name) {
         return false;
     }
 
+#if TDB_VER > 49
+    // Hashed name lookup + a range check in the type hierarchy, instead of a string compare per parent
+    if (const auto td = get_type_definition(object); td != nullptr) {
+        if (const auto cmp = sdk::find_type_definition(name); cmp != nullptr) {
+            return td->is_a(cmp);
+        }
+    }
+#endif
+
     for (auto t = re_managed_object::get_type(object); t != nullptr && t->name != nullptr; t = t->super) {
         if (name == t->name) {
             return true;
@@ -367,6 +376,15 @@ bool is_a(::REManagedObject* object, REType* cmp) {
         return false;
     }
 
+#if TDB_VER > 49
+    // Native types without a type definition still need the REType walk
+    if (const auto td = get_type_definition(object); td != nullptr) {
+        if (const auto cmp_td = utility::re_type::get_type_definition(cmp); cmp_td != nullptr) {
+            return td->is_a(cmp_td);
+        }
+    }
+#endif
+
     for (auto t = re_managed_object::get_type(object); t != nullptr && t->name != nullptr; t = t->super) {
         if (cmp == t) {
             return true;
@@ -67,6 +67,12 @@ template <typename T> T get_field(::REManagedObject* obj, std::string_view field
 template <typename Arg> static std::unique_ptr<ParamWrapper> call_method(::REManagedObject* obj, FunctionDescriptor* desc, const Arg& arg);
 
 template <typename Arg> static std::unique_ptr<ParamWrapper> call_method(::REManagedObject* obj, std::string_view name, const Arg& arg);
+
+// Same as above, but the MethodParams are provided by the caller (e.g. on the stack) instead of heap allocated.
+// Returns false if the method couldn't be called, the result is in params.out_data.
+template <typename Arg> static bool call_method(::REManagedObject* obj, FunctionDescriptor* desc, const Arg& arg, MethodParams& params);
+
+template <typename Arg> static bool call_method(::REManagedObject* obj, std::string_view name, const Arg& arg, MethodParams& params);
 }
 
 #pragma once
@@ -157,4 +163,29 @@ template <typename Arg>
 std::unique_ptr<ParamWrapper> call_method(::REManagedObject* obj, std::string_view name, const Arg& arg) {
     return call_method(obj, get_method_desc(obj, name), arg);
 }
+
+template <typename Arg>
+bool call_method(::REManagedObject* obj, FunctionDescriptor* desc, const Arg& arg, MethodParams& params) {
+    if (desc == nullptr) {
+        return false;
+    }
+
+    auto method_func = (void* (*)(MethodParams*, ::REThreadContext*))desc->functionPtr;
+
+    if (method_func == nullptr) {
+        return false;
+    }
+
+    params = MethodParams{};
+    params.object_ptr = (void*)obj;
+    params.in_data = (void***)&arg;
+
+    method_func(&params, sdk::get_thread_context());
+    return true;
+}
+
+template <typename Arg>
+bool call_method(::REManagedObject* obj, std::string_view name, const Arg& arg, MethodParams& params) {
+    return call_method(obj, get_method_desc(obj, name), arg, params);
+}
 }
\ No newline at end of file
@@ -1,3 +1,9 @@
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include <xmmintrin.h>
+
 #include <sdk/REMath.hpp>
 #include <spdlog/spdlog.h>
 
@@ -202,6 +208,15 @@ REJoint* get_joint(const ::RETransform& transform, uint32_t index) {
 
     return joint;
 #else
+    // Same array get_Joints returns, without calling into the VM for every index.
+    if (transform.joints.data != nullptr) {
+        if (index >= (uint32_t)transform.joints.data->numElements) {
+            return nullptr;
+        }
+
+        return utility::re_array::get_element<REJoint>(transform.joints.data, index);
+    }
+
     static auto get_joints_method = sdk::find_method_definition("via.Transform", "get_Joints");
     auto joints = get_joints_method->call<REArrayBase*>(sdk::get_thread_context(), &transform);
 
@@ -209,11 +224,159 @@ REJoint* get_joint(const ::RETransform& transform, uint32_t index) {
 #endif
 }
 
-glm::mat4 calculate_base_transform(const ::RETransform& transform, REJoint* target) {
+namespace detail {
+int32_t get_joint_count(const ::RETransform& transform) {
+#if TDB_VER < 69
+    auto& joint_array = transform.joints;
+
+    if (joint_array.size <= 0 || joint_array.numAllocated <= 0 || joint_array.data == nullptr || joint_array.matrices == nullptr) {
+        return 0;
+    }
+
+    return joint_array.size;
+#else
+    return transform.joints.data != nullptr ? transform.joints.data->numElements : 0;
+#endif
+}
+
+REJoint* get_joint_raw(const ::RETransform& transform, int32_t index) {
+#if TDB_VER < 69
+    return transform.joints.data->joints[index];
+#else
+    return utility::re_array::get_element<REJoint>(transform.joints.data, index);
+#endif
+}
+
+// Column major, out = a * b
+void multiply(const glm::mat4& a, const glm::mat4& b, glm::mat4& out) {
+    const auto a0 = _mm_loadu_ps(&a[0][0]);
+    const auto a1 = _mm_loadu_ps(&a[1][0]);
+    const auto a2 = _mm_loadu_ps(&a[2][0]);
+    const auto a3 = _mm_loadu_ps(&a[3][0]);
+
+    for (auto i = 0; i < 4; ++i) {
+        auto col = _mm_mul_ps(a0, _mm_set1_ps(b[i][0]));
+        col = _mm_add_ps(col, _mm_mul_ps(a1, _mm_set1_ps(b[i][1])));
+        col = _mm_add_ps(col, _mm_mul_ps(a2, _mm_set1_ps(b[i][2])));
+        col = _mm_add_ps(col, _mm_mul_ps(a3, _mm_set1_ps(b[i][3])));
+
+        _mm_storeu_ps(&out[i][0], col);
+    }
+}
+
+std::shared_ptr<const Skeleton> build_skeleton(const ::RETransform& transform, int32_t joint_count) {
     static auto get_base_local_rotation_method = sdk::find_type_definition("via.Joint")->get_method("get_BaseLocalRotation");
     static auto get_base_local_position_method = sdk::find_type_definition("via.Joint")->get_method("get_BaseLocalPosition");
 
-    if (target == nullptr) {
+    auto skeleton = std::make_shared<Skeleton>();
+    const auto count = (size_t)joint_count;
+
+    skeleton->joints.resize(count);
+    skeleton->parents.resize(count, -1);
+    skeleton->base_transforms.resize(count, glm::identity<glm::mat4>());
+    skeleton->order.reserve(count);
+
+    for (int32_t i = 0; i < joint_count; ++i) {
+        skeleton->joints[i] = get_joint_raw(transform, i);
+    }
+
+    std::vector<std::vector<int32_t>> children(count);
+
+    for (int32_t i = 0; i < joint_count; ++i) {
+        const auto joint = skeleton->joints[i];
+
+        if (joint == nullptr || joint->info == nullptr) {
+            continue;
+        }
+
+        const auto parent = joint->info->parentJoint;
+
+        if (parent < 0 || parent >= joint_count || parent == i || skeleton->joints[parent] == nullptr || skeleton->joints[parent]->info == nullptr) {
+            continue;
+        }
+
+        skeleton->parents[i] = parent;
+        children[parent].push_back(i);
+    }
+
+    // Breadth first from the roots. Anything unreachable (a cycle) is treated as a root.
+    std::vector<bool> visited(count, false);
+
+    auto visit_from = [&](int32_t root) {
+        size_t head = skeleton->order.size();
+
+        visited[root] = true;
+        skeleton->order.push_back(root);
+
+        for (; head < skeleton->order.size(); ++head) {
+            for (auto child : children[skeleton->order[head]]) {
+                if (!visited[child]) {
+                    visited[child] = true;
+                    skeleton->order.push_back(child);
+                }
+            }
+        }
+    };
+
+    for (int32_t i = 0; i < joint_count; ++i) {
+        if (skeleton->parents[i] == -1) {
+            visit_from(i);
+        }
+    }
+
+    for (int32_t i = 0; i < joint_count; ++i) {
+        if (!visited[i]) {
+            skeleton->parents[i] = -1;
+            visit_from(i);
+        }
+    }
+
+    // Single forward pass, every parent is already resolved by the time its children are reached.
+    // Roots stay at identity, matching what calculate_base_transform always returned for them.
+    const auto context = sdk::get_thread_context();
+
+    for (auto i : skeleton->order) {
+        const auto parent = skeleton->parents[i];
+
+        if (parent == -1) {
+            continue;
+        }
+
+        const auto joint = skeleton->joints[i];
+
+        glm::quat base_rotation{};
+        get_base_local_rotation_method->call<glm::quat*>(&base_rotation, context, joint);
+
+        Vector4f base_position{};
+        get_base_local_position_method->call<Vector4f*>(&base_position, context, joint);
+
+        auto base_transform = glm::mat4_cast(base_rotation);
+        base_transform[3] = glm::vec4{base_position.x, base_position.y, base_position.z, 1.0f};
+
+        multiply(skeleton->base_transforms[parent], base_transform, skeleton->base_transforms[i]);
+    }
+
+    return skeleton;
+}
+
+struct CachedSkeleton {
+    int32_t joint_count{};
+    const ::REJointDesc* first_desc{};
+    std::shared_ptr<const Skeleton> skeleton{};
+};
+
+// Keyed by the transform's joint array, which gets replaced along with the skeleton (e.g. when the mesh changes).
+// Joint descriptors live in the skeleton's resource, the first one is checked in case the array's address got reused.
+std::shared_mutex g_skeletons_mutex{};
+std::unordered_map<const void*, CachedSkeleton> g_skeletons{};
+constexpr size_t MAX_CACHED_SKELETONS = 512;
+
+// Walks up the parents through the managed getters, for joints that aren't in the transform's skeleton.
+glm::mat4 calculate_base_transform_uncached(const ::RETransform& transform, REJoint* target) {
+    static auto get_base_local_rotation_method = sdk::find_type_definition("via.Joint")->get_method("get_BaseLocalRotation");
+    static auto get_base_local_position_method = sdk::find_type_definition("via.Joint")->get_method("get_BaseLocalPosition");
+
+    if (target == nullptr || target->info == nullptr) {
         return glm::identity<glm::mat4>();
     }
 
@@ -229,7 +392,7 @@ glm::mat4 calculate_base_transform(const ::RETransform& transform, REJoint* targ
         return glm::identity<glm::mat4>();
     }
 
-    auto parent_transform = calculate_base_transform(transform, parent_joint);
+    auto parent_transform = calculate_base_transform_uncached(transform, parent_joint);
 
     glm::quat base_rotation{};
     get_base_local_rotation_method->call<glm::quat*>(&base_rotation, sdk::get_thread_context(), target);
@@ -242,55 +405,98 @@ glm::mat4 calculate_base_transform(const ::RETransform& transform, REJoint* targ
 
     return parent_transform * base_transform;
 }
+}
 
-void calculate_base_transforms(const ::RETransform& transform, REJoint* target, std::unordered_map<REJoint*, glm::mat4>& out) {
-    static auto get_base_local_rotation_method = sdk::find_type_definition("via.Joint")->get_method("get_BaseLocalRotation");
-    static auto get_base_local_position_method = sdk::find_type_definition("via.Joint")->get_method("get_BaseLocalPosition");
+int32_t Skeleton::index_of(REJoint* joint) const {
+    if (joint == nullptr) {
+        return -1;
+    }
 
-    if (auto it = out.find(target); it != out.end()) {
-        return;
+    const auto index = ((sdk::Joint*)joint)->get_joint_index();
+
+    if (index >= 0 && index < (int32_t)joints.size() && joints[index] == joint) {
+        return index;
     }
 
-    if (target == nullptr) {
-        out[target] = glm::identity<glm::mat4>();
-        return;
+    // get_joint_index isn't reliable everywhere
+    for (size_t i = 0; i < joints.size(); ++i) {
+        if (joints[i] == joint) {
+            return (int32_t)i;
+        }
     }
 
-    auto parent = target->info->parentJoint;
+    return -1;
+}
 
-    if (parent == -1) {
-        out[target] = glm::identity<glm::mat4>();
-        return;
+std::shared_ptr<const Skeleton> get_skeleton(const ::RETransform& transform) {
+    const auto joint_count = detail::get_joint_count(transform);
+
+    if (joint_count <= 0) {
+        return nullptr;
     }
 
-    auto parent_joint = get_joint(transform, parent);
+    const void* joint_array = transform.joints.data;
+    const auto first_joint = detail::get_joint_raw(transform, 0);
+    const auto first_desc = first_joint != nullptr ? first_joint->info : nullptr;
 
-    if (parent_joint == nullptr) {
-        out[target] = glm::identity<glm::mat4>();
-        return;
+    {
+        std::shared_lock _{detail::g_skeletons_mutex};
+
+        if (auto it = detail::g_skeletons.find(joint_array); it != detail::g_skeletons.end()) {
+            if (it->second.joint_count == joint_count && it->second.first_desc == first_desc) {
+                return it->second.skeleton;
+            }
+        }
     }
 
-    calculate_base_transforms(transform, parent_joint, out);
+    auto skeleton = detail::build_skeleton(transform, joint_count);
 
-    auto it = out.find(parent_joint);
+    std::unique_lock _{detail::g_skeletons_mutex};
 
-    if (it == out.end()) {
-        out[target] = glm::identity<glm::mat4>();
-        return;
+    // Transforms come and go with the scene, don't let dead ones pile up.
+    if (detail::g_skeletons.size() >= detail::MAX_CACHED_SKELETONS) {
+        detail::g_skeletons.clear();
     }
 
-    const auto& parent_transform = it->second;
+    detail::g_skeletons[joint_array] = detail::CachedSkeleton{joint_count, first_desc, skeleton};
 
-    glm::quat base_rotation{};
-    get_base_local_rotation_method->call<glm::quat*>(&base_rotation, sdk::get_thread_context(), target);
+    return skeleton;
+}
 
-    Vector4f base_position{};
-    get_base_local_position_method->call<Vector4f*>(&base_position, sdk::get_thread_context(), target);
+glm::mat4 calculate_base_transform(const ::RETransform& transform, REJoint* target) {
+    if (target == nullptr) {
+        return glm::identity<glm::mat4>();
+    }
 
-    // Convert to matrix
-    const auto base_transform = glm::translate(glm::mat4(1.0f), glm::vec3(base_position.x, base_position.y, base_position.z)) * glm::mat4_cast(base_rotation);
+    const auto skeleton = get_skeleton(transform);
+    const auto index = skeleton != nullptr ? skeleton->index_of(target) : -1;
+
+    if (index == -1) {
+        return detail::calculate_base_transform_uncached(transform, target);
+    }
+
+    return skeleton->base_transforms[index];
+}
+
+void calculate_base_transforms(const ::RETransform& transform, REJoint* target, std::unordered_map<REJoint*, glm::mat4>& out) {
+    if (auto it = out.find(target); it != out.end()) {
+        return;
+    }
+
+    const auto skeleton = target != nullptr ? get_skeleton(transform) : nullptr;
+    auto index = skeleton != nullptr ? skeleton->index_of(target) : -1;
+
+    if (index == -1) {
+        out[target] = target != nullptr ? detail::calculate_base_transform_uncached(transform, target) : glm::identity<glm::mat4>();
+        return;
+    }
 
-    out[target] = parent_transform * base_transform;
+    // The target and all of its parents, like the recursive version used to leave behind.
+    for (; index != -1; index = skeleton->parents[index]) {
+        if (!out.emplace(skeleton->joints[index], skeleton->base_transforms[index]).second) {
+            break;
+        }
+    }
 }
 
 Vector4f calculate_tpose_pos_world(::RETransform& transform, REJoint* joint, uint32_t depth) {
@@ -342,16 +548,27 @@ void apply_joints_tpose(::RETransform& transform, const std::vector<REJoint*>& j
         spdlog::info("No joints to apply tpose");
         return;
     }
-    
+
+    const auto skeleton = get_skeleton(transform);
+
+    if (skeleton == nullptr) {
+        return;
+    }
+
     auto joints = joints_initial;
 
     auto player_pos = sdk::get_transform_position(&transform);
     auto player_rot = sdk::get_transform_rotation(&transform);
 
-    joints.insert(joints.begin(), sdk::get_joint_parent(joints[0]));
+    auto parent_of = [&](REJoint* joint) -> REJoint* {
+        const auto index = skeleton->index_of(joint);
+        return index != -1 && skeleton->parents[index] != -1 ? skeleton->joints[skeleton->parents[index]] : nullptr;
+    };
+
+    joints.insert(joints.begin(), parent_of(joints[0]));
 
     for (auto i = 0; i < additional_parents; i++) {
-        auto parent = sdk::get_joint_parent(joints[0]);
+        auto parent = parent_of(joints[0]);
 
         if (parent == nullptr) {
             break;
@@ -360,53 +577,56 @@ void apply_joints_tpose(::RETransform& transform, const std::vector<REJoint*>& j
         joints.insert(joints.begin(), parent);
     }
 
-    std::vector<Vector3f> original_positions(joints.size());
-    std::vector<glm::quat> original_rotations(joints.size());
-    std::vector<Vector3f> current_positions(joints.size());
+    auto get_base_transform = [&](REJoint* joint) -> const glm::mat4* {
+        const auto index = skeleton->index_of(joint);
+        return index != -1 ? &skeleton->base_transforms[index] : nullptr;
+    };
 
-    std::unordered_map<REJoint*, glm::mat4> base_transforms{};
+    // Walk down the chain, placing each joint at its parent's current position plus the bind pose offset.
+    // Only the start of the chain (or a joint right after a gap) has to be read back from the engine.
+    std::optional<Vector3f> current_pos{};
+    std::optional<Vector3f> original_pos{};
 
-    for (auto i = 0; i < joints.size(); i++) {
-        auto joint = joints[i];
+    for (auto i = 0; i < joints.size() - 1; i++) {
+        const auto joint = joints[i];
+        const auto next_joint = joints[i + 1];
 
         if (joint == nullptr) {
+            current_pos.reset();
+            original_pos.reset();
             continue;
         }
 
-        utility::re_transform::calculate_base_transforms(transform, joint, base_transforms);
+        if (!current_pos) {
+            current_pos = Vector3f{sdk::get_joint_position(joint)};
+        }
 
-        auto it = base_transforms.find(joint);
+        if (!original_pos) {
+            const auto base_transform = get_base_transform(joint);
+            original_pos = base_transform != nullptr ? Vector3f{player_pos + (player_rot * (*base_transform)[3])} : Vector3f{};
+        }
 
-        if (it == base_transforms.end()) {
+        if (next_joint == nullptr) {
             continue;
         }
 
-        const auto& base_transform = it->second;
+        const auto next_base_transform = get_base_transform(next_joint);
 
-        original_positions[i] = player_pos + (player_rot * base_transform[3]);
-        original_rotations[i] = player_rot * glm::quat_cast(base_transform);
-        current_positions[i] = sdk::get_joint_position(joints[i]);
-    }
-
-    // second pass
-    for (auto i = 0; i < joints.size() - 1; i++) {
-        auto joint = joints[i];
+        Vector3f next_original_pos{};
+        glm::quat next_original_rot{};
 
-        if (joint == nullptr) {
-            continue;
+        if (next_base_transform != nullptr) {
+            next_original_pos = Vector3f{player_pos + (player_rot * (*next_base_transform)[3])};
+            next_original_rot = player_rot * glm::quat_cast(*next_base_transform);
         }
 
-        auto next_joint = joints[i + 1];
-
-        if (next_joint != nullptr) {
-            auto diff = original_positions[i + 1] - original_positions[i];
-            auto updated_pos = Vector4f{current_positions[i] + diff, 1.0f};
+        const auto updated_pos = Vector4f{*current_pos + (next_original_pos - *original_pos), 1.0f};
 
-            sdk::set_joint_position(next_joint, updated_pos);
-            sdk::set_joint_rotation(next_joint, original_rotations[i+1]);
+        sdk::set_joint_position(next_joint, updated_pos);
+        sdk::set_joint_rotation(next_joint, next_original_rot);
 
-            current_positions[i + 1] = updated_pos;
-        }
+        current_pos = Vector3f{updated_pos};
+        original_pos = next_original_pos;
     }
 }
-}
\ No newline at end of file
+}
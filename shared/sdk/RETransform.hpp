@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <cstdint>
+#include <memory>
 
 #include "Math.hpp"
 #include "TDBVer.hpp"
@@ -248,6 +249,19 @@ namespace utility::re_transform {
         return parents;
     }
 
+    // Topology and bind pose of a transform's skeleton, indexed by joint index.
+    // Read out of the engine once and reused until the transform's joint count changes.
+    struct Skeleton {
+        std::vector<REJoint*> joints{};
+        std::vector<int32_t> parents{};            // -1 if the joint has no valid parent
+        std::vector<int32_t> order{};              // parents always come before their children
+        std::vector<glm::mat4> base_transforms{};  // same values calculate_base_transform returns
+
+        int32_t index_of(REJoint* joint) const;
+    };
+
+    std::shared_ptr<const Skeleton> get_skeleton(const ::RETransform& transform);
+
     glm::mat4 calculate_base_transform(const ::RETransform& transform, REJoint* target);
     void calculate_base_transforms(const ::RETransform& transform, REJoint* target, std::unordered_map<REJoint*, glm::mat4>& out);
     Vector4f calculate_tpose_pos_world(::RETransform& transform, REJoint* target, uint32_t depth=1);
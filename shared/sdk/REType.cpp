@@ -1,6 +1,9 @@
+#include <memory>
 #include <shared_mutex>
+#include <unordered_map>
 
 #include "ReClass.hpp"
+#include "helpers/NameTable.hpp"
 
 #include "RETypeDefinition.hpp"
 #include "REType.hpp"
@@ -83,111 +86,128 @@ void* utility::re_type::create_instance(::REType* t) {
     return out;
 }
 
-static std::shared_mutex insertion_mutex{};
-static std::unordered_map<std::string, VariableDescriptor*> var_map{};
+namespace utility::re_type::detail {
+// Every variable and function reachable from a type, derived types first, so the first match wins like the old walk.
+struct DescriptorTable {
+    sdk::helpers::NameTable<VariableDescriptor*> variables{};
+    sdk::helpers::NameTable<FunctionDescriptor*> methods{};
+};
 
-VariableDescriptor* utility::re_type::get_field_desc(::REType* t, std::string_view field) {
-    if (t == nullptr) {
-        return nullptr;
-    }
+static std::shared_mutex descriptor_tables_mtx{};
+static std::unordered_map<const ::REType*, std::unique_ptr<DescriptorTable>> descriptor_tables{};
 
-    auto full_name = std::string{t->name} + "." + field.data();
+static std::unique_ptr<DescriptorTable> build_descriptor_table(::REType* t) {
+    auto table = std::make_unique<DescriptorTable>();
 
-    {
-        std::shared_lock _{ insertion_mutex };
+    for (; t != nullptr; t = t->super) {
+        if (auto vars = utility::re_type::get_variables(t); vars != nullptr) {
+            for (auto i = 0; i < vars->num; ++i) {
+                auto var = vars->data->descriptors[i];
+
+                if (var == nullptr || var->name == nullptr) {
+                    continue;
+                }
+
+                const std::string_view name{var->name};
 
-        if (var_map.find(full_name) != var_map.end()) {
-            return var_map[full_name];
+                table->variables.insert(sdk::helpers::NameTable<VariableDescriptor*>::hash(name), var, [&](VariableDescriptor* other) {
+                    return name == other->name;
+                });
+            }
         }
-    }
 
-    for (; t != nullptr; t = t->super) {
-        auto vars = get_variables(t);
+        auto fields = t->fields;
 
-        if (vars == nullptr) {
+        if (fields == nullptr || fields->methods == nullptr) {
             continue;
         }
 
-        for (auto i = 0; i < vars->num; ++i) {
-            auto& var = vars->data->descriptors[i];
+        auto methods = fields->methods;
 
-            if (var == nullptr || var->name == nullptr) {
+        for (auto i = 0; i < fields->num; ++i) {
+            auto top = (*methods)[i];
+
+            if (top == nullptr || *top == nullptr) {
                 continue;
             }
 
-            if (field == var->name) {
-                std::unique_lock _{insertion_mutex};
-                var_map[full_name] = var;
-                return var;
+            auto& holder = **top;
+
+            if (holder.descriptor == nullptr || holder.descriptor->name == nullptr) {
+                continue;
             }
+
+            const std::string_view name{holder.descriptor->name};
+
+            table->methods.insert(sdk::helpers::NameTable<FunctionDescriptor*>::hash(name), holder.descriptor, [&](FunctionDescriptor* other) {
+                return name == other->name;
+            });
         }
     }
 
-    return nullptr;
+    return table;
 }
 
-REVariableList* utility::re_type::get_variables(::REType* t) {
-    if (t == nullptr || t->fields == nullptr || t->fields->variables == nullptr) {
-        return nullptr;
+static const DescriptorTable& get_descriptor_table(::REType* t) {
+    {
+        std::shared_lock _{descriptor_tables_mtx};
+
+        if (auto it = descriptor_tables.find(t); it != descriptor_tables.end()) {
+            return *it->second;
+        }
     }
 
-    auto vars = t->fields->variables;
+    auto table = build_descriptor_table(t);
 
-    if (vars->data == nullptr || vars->num <= 0) {
-        return nullptr;
+    std::unique_lock _{descriptor_tables_mtx};
+    auto& slot = descriptor_tables[t];
+
+    // Someone else may have built it in the meantime, keep theirs.
+    if (slot == nullptr) {
+        slot = std::move(table);
     }
 
-    return vars;
+    return *slot;
+}
 }
 
-static std::shared_mutex method_insertion_mutex{};
-static std::unordered_map<std::string, FunctionDescriptor*> method_map{};
-
-FunctionDescriptor* utility::re_type::get_method_desc(::REType* t, std::string_view name) {
+VariableDescriptor* utility::re_type::get_field_desc(::REType* t, std::string_view field) {
     if (t == nullptr) {
         return nullptr;
     }
 
-    auto full_name = std::string{t->name} + "." + name.data();
+    const auto& table = detail::get_descriptor_table(t);
+    const auto var = table.variables.find(sdk::helpers::NameTable<VariableDescriptor*>::hash(field), [&](VariableDescriptor* candidate) {
+        return field == candidate->name;
+    });
 
-    {
-        std::shared_lock _{ method_insertion_mutex };
+    return var != nullptr ? *var : nullptr;
+}
 
-        if (method_map.find(full_name) != method_map.end()) {
-            return method_map[full_name];
-        }
+REVariableList* utility::re_type::get_variables(::REType* t) {
+    if (t == nullptr || t->fields == nullptr || t->fields->variables == nullptr) {
+        return nullptr;
     }
 
-    for (; t != nullptr; t = t->super) {
-        auto fields = t->fields;
-
-        if (fields == nullptr || fields->methods == nullptr) {
-            continue;
-        }
-
-        auto methods = fields->methods;
-
-        for (auto i = 0; i < fields->num; ++i) {
-            auto top = (*methods)[i];
-
-            if (top == nullptr || *top == nullptr) {
-                continue;
-            }
+    auto vars = t->fields->variables;
 
-            auto& holder = **top;
+    if (vars->data == nullptr || vars->num <= 0) {
+        return nullptr;
+    }
 
-            if (holder.descriptor == nullptr || holder.descriptor->name == nullptr) {
-                continue;
-            }
+    return vars;
+}
 
-            if (name == holder.descriptor->name) {
-                std::unique_lock _{ method_insertion_mutex};
-                method_map[full_name] = holder.descriptor;
-                return holder.descriptor;
-            }
-        }
+FunctionDescriptor* utility::re_type::get_method_desc(::REType* t, std::string_view name) {
+    if (t == nullptr) {
+        return nullptr;
     }
 
-    return nullptr;
+    const auto& table = detail::get_descriptor_table(t);
+    const auto desc = table.methods.find(sdk::helpers::NameTable<FunctionDescriptor*>::hash(name), [&](FunctionDescriptor* candidate) {
+        return name == candidate->name;
+    });
+
+    return desc != nullptr ? *desc : nullptr;
 }
 
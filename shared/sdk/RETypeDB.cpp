@@ -1,8 +1,17 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include <spdlog/spdlog.h>
 #include <utility/Scan.hpp>
 #include <utility/Module.hpp>
 
 #include "reframework/API.hpp"
+#include "helpers/TypeNameIndex.hpp"
 #include "RETypeDB.hpp"
 
 namespace sdk {
@@ -16,8 +25,127 @@ RETypeDB* RETypeDB::get() {
     return vm->get_type_db();
 }
 
-static std::shared_mutex g_tdb_type_mtx{};
-static std::unordered_map<std::string, sdk::RETypeDefinition*> g_tdb_type_map{};
+namespace detail {
+// helpers::TypeNameIndex over the live TDB.
+// Built once over the whole TDB by the init thread, after which lookups are lock-free and never allocate.
+class TypeIndex {
+public:
+    // Queries never build the index themselves, until it's ready they should fall back to a scan.
+    bool is_ready(const RETypeDB* tdb) const {
+        return m_state.load(std::memory_order_acquire) == State::BUILT && m_tdb == tdb;
+    }
+
+    // Only the first call does anything.
+    void build_once(const RETypeDB* tdb) {
+        auto expected = State::UNBUILT;
+
+        if (!m_state.compare_exchange_strong(expected, State::BUILDING, std::memory_order_acq_rel)) {
+            return;
+        }
+
+        build(tdb);
+        m_state.store(State::BUILT, std::memory_order_release);
+    }
+
+    // The FQN table gets published before the name table because get_full_name
+    // itself needs find_type_by_fqn while the names are being gathered.
+    bool is_fqn_ready(const RETypeDB* tdb) const {
+        return m_fqn_ready.load(std::memory_order_acquire) && m_tdb == tdb;
+    }
+
+    sdk::RETypeDefinition* find_by_name(const RETypeDB* tdb, std::string_view name) const {
+        return tdb->get_type(m_index.find_by_name(name));
+    }
+
+    sdk::RETypeDefinition* find_by_fqn(const RETypeDB* tdb, uint32_t fqn) const {
+        return tdb->get_type(m_index.find_by_fqn(fqn));
+    }
+
+    std::string_view get_name(uint32_t index) const {
+        return m_index.get_name(index);
+    }
+
+    uint32_t get_num_names() const {
+        return m_index.get_num_names();
+    }
+
+    const std::vector<uint32_t>& get_sorted_by_name() const {
+        return m_index.get_sorted_by_name();
+    }
+
+private:
+    enum class State : uint8_t {
+        UNBUILT,
+        BUILDING,
+        BUILT
+    };
+
+    // Names that only need the TDB are built on every core, the rest (generics, arrays)
+    // go through get_full_name on this thread since they may call into the VM.
+    std::vector<std::string> gather_names(const RETypeDB* tdb) {
+        const auto num_types = tdb->numTypes;
+        std::vector<std::string> names(num_types);
+
+        constexpr uint32_t TYPES_PER_CHUNK = 1024;
+        const auto num_chunks = (num_types + TYPES_PER_CHUNK - 1) / TYPES_PER_CHUNK;
+
+        std::atomic<uint32_t> next_chunk{0};
+        const auto worker = [&]() {
+            for (auto chunk = next_chunk++; chunk < num_chunks; chunk = next_chunk++) {
+                const auto end = std::min<uint32_t>(num_types, (chunk + 1) * TYPES_PER_CHUNK);
+
+                for (auto i = chunk * TYPES_PER_CHUNK; i < end; ++i) {
+                    names[i] = tdb->get_type(i)->get_native_full_name();
+                }
+            }
+        };
+
+        const auto num_threads = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), num_chunks);
+        std::vector<std::thread> threads{};
+
+        for (size_t i = 1; i < num_threads; ++i) {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        for (uint32_t i = 0; i < num_types; ++i) {
+            if (names[i].empty()) {
+                names[i] = tdb->get_type(i)->get_full_name();
+            }
+        }
+
+        return names;
+    }
+
+    void build(const RETypeDB* tdb) {
+        const auto start_time = std::chrono::high_resolution_clock::now();
+        const auto num_types = tdb->numTypes;
+
+        m_tdb = tdb;
+        m_index.build_fqn(num_types, [&](uint32_t i) { return tdb->get_type(i)->get_fqn_hash(); });
+        m_fqn_ready.store(true, std::memory_order_release);
+
+        m_index.build_names(gather_names(tdb));
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start_time);
+
+        spdlog::info("[RETypeDB] Built type index for {} types ({} bytes of names) in {}ms", num_types, m_index.get_name_pool_size(), elapsed.count());
+    }
+
+    std::atomic<State> m_state{State::UNBUILT};
+    std::atomic<bool> m_fqn_ready{false};
+    const RETypeDB* m_tdb{nullptr};
+
+    helpers::TypeNameIndex m_index{};
+};
+}
+
+static detail::TypeIndex g_type_index{};
 
 reframework::InvokeRet invoke_object_func(void* obj, sdk::RETypeDefinition* t, std::string_view name, const std::vector<void*>& args) {
     const auto method = t->get_method(name);
@@ -33,31 +161,49 @@ reframework::InvokeRet invoke_object_func(::REManagedObject* obj, std::string_vi
    return invoke_object_func((void*)obj, utility::re_managed_object::get_type_definition(obj), name, args);
 }
 
-sdk::RETypeDefinition* RETypeDB::find_type(std::string_view name) const {
-    {
-        std::shared_lock _{ g_tdb_type_mtx };
+void RETypeDB::build_type_index() const {
+    g_type_index.build_once(this);
+}
 
-        if (auto it = g_tdb_type_map.find(name.data()); it != g_tdb_type_map.end()) {
-            return it->second;
-        }
+sdk::RETypeDefinition* RETypeDB::find_type(std::string_view name) const {
+    if (g_type_index.is_ready(this)) {
+        return g_type_index.find_by_name(this, name);
     }
 
+    // Only hit until the init thread has built the index
     for (uint32_t i = 0; i < this->numTypes; ++i) {
         auto t = get_type(i);
 
         if (t->get_full_name() == name) {
-            std::unique_lock _{ g_tdb_type_mtx };
-
-            g_tdb_type_map[name.data()] = t;
-            return g_tdb_type_map[name.data()];
+            return t;
         }
     }
 
-    return g_tdb_type_map[name.data()];
+    return nullptr;
+}
+
+std::optional<std::string_view> RETypeDB::get_full_name_view(uint32_t index) const {
+    if (!g_type_index.is_ready(this) || index >= g_type_index.get_num_names()) {
+        return std::nullopt;
+    }
+
+    return g_type_index.get_name(index);
+}
+
+std::span<const uint32_t> RETypeDB::get_types_sorted_by_name() const {
+    if (!g_type_index.is_ready(this)) {
+        return {};
+    }
+
+    return g_type_index.get_sorted_by_name();
 }
 
 sdk::RETypeDefinition* RETypeDB::find_type_by_fqn(uint32_t fqn) const {
-    for (uint32_t i = 0; i< this->numTypes; ++i) {
+    if (g_type_index.is_fqn_ready(this)) {
+        return g_type_index.find_by_fqn(this, fqn);
+    }
+
+    for (uint32_t i = 0; i < this->numTypes; ++i) {
         auto t = get_type(i);
 
         if (t->get_fqn_hash() == fqn) {
@@ -471,8 +617,148 @@ uint32_t sdk::REMethodDefinition::get_invoke_id() const {
     return invoke_id;
 }
 
+namespace detail {
+// Side array indexed by method index, plans are published once and never freed.
+static std::unique_ptr<std::atomic<sdk::InvokePlan*>[]> g_invoke_plans{};
+static uint32_t g_num_invoke_plans{0};
+static std::once_flag g_invoke_plans_once{};
+
+static sdk::InvokePlan::ParamKind get_param_kind(sdk::RETypeDefinition* t, size_t name_hash) {
+    using ParamKind = sdk::InvokePlan::ParamKind;
+
+    if (t == nullptr) {
+        return ParamKind::OTHER;
+    }
+
+    switch (name_hash) {
+    case "System.Boolean"_fnv:
+        return ParamKind::BOOLEAN;
+    case "System.Char"_fnv: [[fallthrough]];
+    case "System.SByte"_fnv: [[fallthrough]];
+    case "System.Byte"_fnv: [[fallthrough]];
+    case "System.Int16"_fnv: [[fallthrough]];
+    case "System.UInt16"_fnv: [[fallthrough]];
+    case "System.Int32"_fnv: [[fallthrough]];
+    case "System.UInt32"_fnv: [[fallthrough]];
+    case "System.Int64"_fnv: [[fallthrough]];
+    case "System.UInt64"_fnv: [[fallthrough]];
+    case "System.IntPtr"_fnv: [[fallthrough]];
+    case "System.UIntPtr"_fnv:
+        return ParamKind::INTEGER;
+    case "System.Single"_fnv:
+        return ParamKind::SINGLE;
+    case "System.Double"_fnv:
+        return ParamKind::DOUBLE;
+    case "System.String"_fnv:
+        return ParamKind::STRING;
+    case "via.Float2"_fnv: [[fallthrough]];
+    case "via.vec2"_fnv:
+        return ParamKind::VEC2;
+    case "via.Float3"_fnv: [[fallthrough]];
+    case "via.vec3"_fnv:
+        return ParamKind::VEC3;
+    case "via.Float4"_fnv: [[fallthrough]];
+    case "via.vec4"_fnv:
+        return ParamKind::VEC4;
+    case "via.Quaternion"_fnv:
+        return ParamKind::QUATERNION;
+    case "via.mat4"_fnv:
+        return ParamKind::MATRIX;
+    default:
+        break;
+    }
+
+    return t->is_enum() ? ParamKind::INTEGER : ParamKind::OTHER;
+}
+
+static std::unique_ptr<sdk::InvokePlan> build_invoke_plan(const sdk::REMethodDefinition* m) {
+    auto plan = std::make_unique<sdk::InvokePlan>();
+    const auto ret_ty = m->get_return_type();
+
+    plan->ret_ty = ret_ty;
+    plan->num_params = m->get_num_params();
+
+    // vec3 and stuff that is > sizeof(void*) requires special handling
+    // by preallocating the output buffer
+    if (ret_ty != nullptr && ret_ty->is_value_type()) {
+        plan->ret_in_buffer = ret_ty->get_valuetype_size() > sizeof(void*) || (!ret_ty->is_primitive() && !ret_ty->is_enum());
+    }
+
+    plan->param_types = m->get_param_types();
+
+    for (auto ty : plan->param_types) {
+        const auto hash = ty != nullptr ? utility::hash(ty->get_full_name_view()) : 0;
+
+        plan->param_kinds.push_back(get_param_kind(ty, hash));
+#if TDB_VER <= 49
+        plan->param_hashes.push_back(hash);
+#endif
+    }
+
+#if TDB_VER > 49
+    const auto invoke_tbl = sdk::get_invoke_table();
+
+    if (invoke_tbl != nullptr) {
+        plan->invoke_wrapper = invoke_tbl[m->get_invoke_id()];
+    }
+#else
+    plan->ret_hash = ret_ty != nullptr ? utility::hash(ret_ty->get_full_name_view()) : 0;
+#endif
+
+    return plan;
+}
+}
+
+sdk::InvokePlanRef sdk::REMethodDefinition::get_invoke_plan() const {
+    std::call_once(detail::g_invoke_plans_once, []() {
+        const auto tdb = RETypeDB::get();
+
+        detail::g_num_invoke_plans = tdb->numMethods;
+        detail::g_invoke_plans = std::make_unique<std::atomic<sdk::InvokePlan*>[]>(detail::g_num_invoke_plans);
+    });
+
+    const auto index = get_index();
+
+    if (index < detail::g_num_invoke_plans) {
+        auto& slot = detail::g_invoke_plans[index];
+
+        if (auto existing = slot.load(std::memory_order_acquire); existing != nullptr) {
+            return sdk::InvokePlanRef{existing};
+        }
+    }
+
+    auto plan = detail::build_invoke_plan(this);
+
+#if TDB_VER > 49
+    const auto cacheable = plan->invoke_wrapper != nullptr;
+#else
+    const auto cacheable = true;
+#endif
+
+    if (!cacheable || index >= detail::g_num_invoke_plans) {
+        // Shouldn't really happen, but don't cache anything that's incomplete.
+        return sdk::InvokePlanRef{std::move(plan)};
+    }
+
+    auto& slot = detail::g_invoke_plans[index];
+    sdk::InvokePlan* expected = nullptr;
+
+    if (slot.compare_exchange_strong(expected, plan.get(), std::memory_order_acq_rel)) {
+        return sdk::InvokePlanRef{plan.release()};
+    }
+
+    // Someone else beat us to it, use theirs.
+    return sdk::InvokePlanRef{expected};
+}
+
 reframework::InvokeRet sdk::REMethodDefinition::invoke(void* object, const std::vector<void*>& args) const {
-    const auto num_params = get_num_params();
+    return invoke_span(object, std::span{args});
+}
+
+reframework::InvokeRet sdk::REMethodDefinition::invoke_span(void* object, std::span<void* const> args) const {
+    const auto plan_ref = get_invoke_plan();
+    const auto& plan = *plan_ref;
+    const auto num_params = plan.num_params;
 
     if (num_params != args.size()) {
         //throw std::runtime_error("Invalid number of arguments");
@@ -481,8 +767,12 @@ reframework::InvokeRet sdk::REMethodDefinition::invoke(void* object, const std::
     }
 
 #if TDB_VER > 49
-    const auto invoke_tbl = sdk::get_invoke_table();
-    auto invoke_wrapper = invoke_tbl[get_invoke_id()];
+    const auto invoke_wrapper = plan.invoke_wrapper;
+
+    if (invoke_wrapper == nullptr) {
+        spdlog::warn("No invoke wrapper found for {}", get_name());
+        return reframework::InvokeRet{};
+    }
 
     struct StackFrame {
         char pad_0000[8+8]; //0x0000
@@ -499,24 +789,9 @@ reframework::InvokeRet sdk::REMethodDefinition::invoke(void* object, const std::
     stack_frame.method = this;
     stack_frame.object_ptr = object;
     stack_frame.in_data = (void*)args.data();
-    
-    auto ret_ty = get_return_type();
-    bool is_ptr = false;
- 
-    // vec3 and stuff that is > sizeof(void*) requires special handling
-    // by preallocating the output buffer
-    if (ret_ty != nullptr && ret_ty->is_value_type()) {
-        if (ret_ty->get_valuetype_size() > sizeof(void*) || (!ret_ty->is_primitive() && !ret_ty->is_enum())) {
-            stack_frame.out_data = &out;
-            is_ptr = false;
-        } else {
-            stack_frame.out_data = nullptr;
-            is_ptr = true;
-        }
-    } else {
-        stack_frame.out_data = nullptr;
-        is_ptr = true;
-    }
+
+    const bool is_ptr = !plan.ret_in_buffer;
+    stack_frame.out_data = is_ptr ? nullptr : &out;
     
     {
         auto context = sdk::get_thread_context();
@@ -587,38 +862,19 @@ reframework::InvokeRet sdk::REMethodDefinition::invoke(void* object, const std::
         return reframework::InvokeRet{};
     }
 
-    auto ret_ty = get_return_type();
-    size_t ret_hash = ret_ty != nullptr ? utility::hash(ret_ty->get_full_name()) : 0;
-    bool is_ptr = false;
- 
-    // vec3 and stuff that is > sizeof(void*) requires special handling
-    // by preallocating the output buffer
-    if (ret_ty != nullptr && ret_ty->is_value_type()) {
-        if (ret_ty->get_valuetype_size() > sizeof(void*) || (!ret_ty->is_primitive() && !ret_ty->is_enum())) {
-            is_ptr = false;
-        } else {
-            is_ptr = true;
-        }
-    } else {
-        is_ptr = true;
-    }
+    const auto ret_hash = plan.ret_hash;
+    const bool is_ptr = !plan.ret_in_buffer;
 
     reframework::InvokeRet out{};
 
-    const auto param_types = get_param_types();
-    std::vector<size_t> param_hashes{};
-    std::vector<void*> converted_args(args.size());
-
-    for (auto& ty : param_types) {
-        param_hashes.push_back(utility::hash(ty->get_full_name()));
-    }
+    const auto& param_hashes = plan.param_hashes;
+    std::array<void*, 3> converted_args{};
 
     // convert necessary args to float
     // we pass the args as double, but because there's no invoke wrappers
     // in RE7, we must convert them back to float
     for (size_t i = 0; i < args.size(); i++) {
         auto& arg = args[i];
-        auto& ty = param_types[i];
         auto& hash = param_hashes[i];
 
         switch (hash) {
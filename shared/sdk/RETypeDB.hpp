@@ -1,3 +1,6 @@
+#include <memory>
+#include <optional>
+#include <span>
 #include <string_view>
 #include <vector>
 #include <cstdint>
@@ -738,9 +741,17 @@ namespace sdk {
 struct RETypeDB : public sdk::RETypeDB_ {
     static RETypeDB* get();
 
+    // Builds the name/FQN index over every type, including the names that need managed get_FullName calls.
+    // Called once by the init thread after the TDB is loaded, lookups before then fall back to a scan.
+    void build_type_index() const;
+
     sdk::RETypeDefinition* find_type(std::string_view name) const;
     sdk::RETypeDefinition* find_type_by_fqn(uint32_t fqn) const;
     sdk::RETypeDefinition* get_type(uint32_t index) const;
+
+    // Both come from the type index, nullopt/empty until build_type_index is done.
+    std::optional<std::string_view> get_full_name_view(uint32_t index) const;
+    std::span<const uint32_t> get_types_sorted_by_name() const;
     sdk::REMethodDefinition* get_method(uint32_t index) const;
     sdk::REField* get_field(uint32_t index) const;
     sdk::REProperty* get_property(uint32_t index) const;
@@ -786,6 +797,59 @@ struct REField : public sdk::REField_ {
     template <typename T> T& get_data(void* object = nullptr, bool is_value_type = false) const { return *(T*)get_data_raw(object); }
 };
 
+// Everything REMethodDefinition::invoke needs to know about a method that doesn't change between calls.
+// Built the first time a method is invoked and kept for as long as the TDB is around.
+struct InvokePlan {
+    // What each parameter expects to be passed as, so callers that marshal
+    // arguments from somewhere else (e.g. Lua) can convert straight to it.
+    enum class ParamKind : uint8_t {
+        OTHER,
+        BOOLEAN,
+        INTEGER, // integral primitives and enums
+        SINGLE,
+        DOUBLE,
+        STRING,
+        VEC2,
+        VEC3,
+        VEC4,
+        QUATERNION,
+        MATRIX,
+    };
+
+    sdk::RETypeDefinition* ret_ty{};
+    uint32_t num_params{};
+    std::vector<sdk::RETypeDefinition*> param_types{};
+    std::vector<ParamKind> param_kinds{};
+
+    // Value types bigger than a pointer (or ones that aren't primitives/enums) are written into
+    // the out buffer, everything else comes back as a pointer sized value.
+    bool ret_in_buffer{false};
+
+#if TDB_VER > 49
+    sdk::InvokeMethod invoke_wrapper{};
+#else
+    // No invoke wrappers in RE7, floats and doubles have to be passed around as their real types.
+    size_t ret_hash{};
+    std::vector<size_t> param_hashes{};
+#endif
+};
+
+// What get_invoke_plan hands out. Usually points at the cached plan, but owns the plan
+// when it couldn't be cached, so every caller (including re-entrant invokes) gets its own.
+// Keep it alive for as long as the plan is used.
+class InvokePlanRef {
+public:
+    explicit InvokePlanRef(const InvokePlan* cached) : m_plan{cached} {}
+    explicit InvokePlanRef(std::unique_ptr<InvokePlan> uncached) : m_plan{uncached.get()}, m_owned{std::move(uncached)} {}
+
+    const InvokePlan& operator*() const { return *m_plan; }
+    const InvokePlan* operator->() const { return m_plan; }
+
+private:
+    const InvokePlan* m_plan{};
+    std::unique_ptr<InvokePlan> m_owned{};
+};
+
 struct REMethodDefinition : public sdk::REMethodDefinition_ {
     sdk::RETypeDefinition* get_declaring_type() const;
     sdk::RETypeDefinition* get_return_type() const;
@@ -917,6 +981,9 @@ struct REMethodDefinition : public sdk::REMethodDefinition_ {
     // invoking is calling a wrapper function that calls the function
     // using an array of arguments
     ::reframework::InvokeRet invoke(void* object, const std::vector<void*>& args) const;
+    ::reframework::InvokeRet invoke_span(void* object, std::span<void* const> args) const;
+
+    sdk::InvokePlanRef get_invoke_plan() const;
 
     uint32_t get_invoke_id() const;
     uint32_t get_num_params() const;
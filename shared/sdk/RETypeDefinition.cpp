@@ -1,11 +1,14 @@
+#include <atomic>
 #include <deque>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <execution>
-#include <sstream>
+#include <vector>
 
 #include "RETypeDB.hpp"
 #include "RETypeDefinition.hpp"
+#include "helpers/NameTable.hpp"
 
 namespace sdk {
 struct RETypeDefinition;
@@ -138,30 +141,16 @@ const char* RETypeDefinition::get_name() const {
 static std::unordered_map<uint32_t, std::string> g_full_names{};
 static std::shared_mutex g_full_name_mtx{};
 
-std::string RETypeDefinition::get_full_name() const {
-    auto tdb = RETypeDB::get();
-
-#if TDB_VER <= 49
-    return tdb->get_string(this->full_name_offset); // uhh thanks?
-#else
-    {
-        std::shared_lock _{ g_full_name_mtx };
-
-        if (auto it = g_full_names.find(this->get_index()); it != g_full_names.end()) {
-            return it->second;
-        }
-    }
-
+#if TDB_VER > 49
+// Namespace + declaring types + name, only reads the TDB so it's safe from any thread.
+static std::string build_declared_name(const RETypeDefinition* t) {
     std::deque<std::string> names{};
     std::string full_name{};
 
-    // because using normal find_type will loop back to this function and cause a deadlock
-    static auto system_runtime_type = sdk::RETypeDB::get()->find_type_by_fqn(0x99ff88e6);
-
-    if (this->declaring_typeid > 0 && this->declaring_typeid != this->get_index()) {
+    if (t->declaring_typeid > 0 && t->declaring_typeid != t->get_index()) {
         std::unordered_set<const sdk::RETypeDefinition*> seen_classes{};
 
-        for (auto owner = this; owner != nullptr; owner = owner->get_declaring_type()) {
+        for (auto owner = t; owner != nullptr; owner = owner->get_declaring_type()) {
             if (seen_classes.count(owner) > 0) {
                 break;
             }
@@ -173,7 +162,7 @@ std::string RETypeDefinition::get_full_name() const {
             }
 
             // uh.
-            if (owner->get_declaring_type() == this) {
+            if (owner->get_declaring_type() == t) {
                 break;
             }
 
@@ -181,12 +170,12 @@ std::string RETypeDefinition::get_full_name() const {
         }
     } else {
         // namespace
-        if (!std::string{this->get_namespace()}.empty()) {
-            names.push_front(this->get_namespace());
+        if (!std::string{t->get_namespace()}.empty()) {
+            names.push_front(t->get_namespace());
         }
 
         // actual class name
-        names.push_back(this->get_name());
+        names.push_back(t->get_name());
     }
 
     for (auto f = 0; f < names.size(); ++f) {
@@ -197,6 +186,33 @@ std::string RETypeDefinition::get_full_name() const {
         full_name += names[f];
     }
 
+    return full_name;
+}
+#endif
+
+std::string RETypeDefinition::get_full_name() const {
+    auto tdb = RETypeDB::get();
+
+#if TDB_VER <= 49
+    return tdb->get_string(this->full_name_offset); // uhh thanks?
+#else
+    if (const auto view = tdb->get_full_name_view(this->get_index()); view.has_value()) {
+        return std::string{*view};
+    }
+
+    {
+        std::shared_lock _{ g_full_name_mtx };
+
+        if (auto it = g_full_names.find(this->get_index()); it != g_full_names.end()) {
+            return it->second;
+        }
+    }
+
+    // because using normal find_type will loop back to this function and cause a deadlock
+    static auto system_runtime_type = sdk::RETypeDB::get()->find_type_by_fqn(0x99ff88e6);
+
+    auto full_name = build_declared_name(this);
+
     // Set this here at this point in-case get_full_name runs into it
     {
         std::unique_lock _{g_full_name_mtx};
@@ -273,6 +289,44 @@ std::string RETypeDefinition::get_full_name() const {
 #endif
 }
 
+std::string_view RETypeDefinition::get_full_name_view() const {
+    auto tdb = RETypeDB::get();
+
+#if TDB_VER <= 49
+    return tdb->get_string(this->full_name_offset);
+#else
+    if (const auto view = tdb->get_full_name_view(this->get_index()); view.has_value()) {
+        return *view;
+    }
+
+    // Only while the name arena is still being built, keep a copy that never moves
+    static std::mutex interned_mtx{};
+    static std::unordered_map<uint32_t, std::unique_ptr<std::string>> interned{};
+
+    std::scoped_lock _{interned_mtx};
+    auto& name = interned[this->get_index()];
+
+    if (name == nullptr) {
+        name = std::make_unique<std::string>(this->get_full_name());
+    }
+
+    return *name;
+#endif
+}
+
+std::string RETypeDefinition::get_native_full_name() const {
+#if TDB_VER <= 49
+    return get_full_name();
+#else
+    // Generic instances, generic definitions and arrays need the VM for (parts of) their name
+    if (this->get_generic_data() != nullptr) {
+        return {};
+    }
+
+    return build_declared_name(this);
+#endif
+}
+
 std::vector<std::string> RETypeDefinition::get_name_hierarchy() const {
     std::deque<std::string> names{};
     std::string full_name{};
@@ -413,93 +467,195 @@ sdk::RETypeDefinition* RETypeDefinition::get_generic_type_definition() const {
     return nullptr;
 }
 
-static std::shared_mutex g_field_mtx{};
-static std::unordered_map<std::string, sdk::REField*> g_field_map{};
-
-sdk::REField* RETypeDefinition::get_field(std::string_view name) const {
-    auto full_name = std::to_string(this->get_index()) + "." + name.data();
+namespace detail {
+// Members of a type flattened across its inheritance chain.
+// The first entry found walking up from the type wins, same as the old parent chain walk.
+struct MemberTable {
+    struct Prototype {
+        sdk::REMethodDefinition* method{nullptr};
+        uint32_t offset{0};
+        uint32_t length{0};
+    };
 
-    {
-        std::shared_lock _{ g_field_mtx };
+    // "Name(Param.Type, Param.Type)" -> method
+    // Built separately on the first lookup that misses the name table
+    // because it needs the full name of every parameter type in the hierarchy.
+    struct PrototypeTable {
+        std::string pool{};
+        helpers::NameTable<Prototype> methods{};
 
-        if (auto it = g_field_map.find(full_name); it != g_field_map.end()) {
-            return it->second;
+        std::string_view get_prototype(const Prototype& p) const {
+            return std::string_view{pool.data() + p.offset, p.length};
         }
-    }
+    };
 
-    for (auto super = this; super != nullptr; super = super->get_parent_type()) {
-        for (auto f : super->get_fields()) {
-            if (name == f->get_name()) {
-                std::unique_lock _{ g_field_mtx };
+    helpers::NameTable<sdk::REField*> fields{};
+    helpers::NameTable<sdk::REMethodDefinition*> methods{};
+    std::atomic<PrototypeTable*> prototypes{nullptr};
+};
 
-                g_field_map[full_name] = f;
-                return g_field_map[full_name];
-            }
-        }
+// Side array indexed by type index, entries are published once and never freed.
+static std::unique_ptr<std::atomic<MemberTable*>[]> g_member_tables{};
+static uint32_t g_num_member_tables{0};
+static std::once_flag g_member_tables_once{};
+
+template <typename T>
+static T* publish(std::atomic<T*>& slot, std::unique_ptr<T> value) {
+    T* expected = nullptr;
+
+    if (slot.compare_exchange_strong(expected, value.get(), std::memory_order_acq_rel)) {
+        return value.release();
     }
 
-    return g_field_map[full_name];
+    // Someone else beat us to it, use theirs.
+    return expected;
 }
 
-static std::shared_mutex g_method_mtx{};
-static std::unordered_map<std::string, REMethodDefinition*> g_method_map{};
+static MemberTable* get_member_table(const sdk::RETypeDefinition* t) {
+    std::call_once(g_member_tables_once, []() {
+        const auto tdb = sdk::RETypeDB::get();
 
-sdk::REMethodDefinition* RETypeDefinition::get_method(std::string_view name) const {
-    // originally this used this->get_full_name() + "." + name.data()
-    // but that doesn't work for generic types if we haven't yet mapped out
-    // how generic (instantiated) types work for the game we're working with
-    // and this is probably faster anyways
-    auto full_name = std::to_string(this->get_index()) + "." + name.data();
+        g_num_member_tables = tdb->numTypes;
+        g_member_tables = std::make_unique<std::atomic<MemberTable*>[]>(g_num_member_tables);
+    });
 
-    {
-        std::shared_lock _{g_method_mtx};
+    const auto index = t->get_index();
 
-        if (auto it = g_method_map.find(full_name); it != g_method_map.end()) {
-            return it->second;
-        }
+    if (index >= g_num_member_tables) {
+        return nullptr;
     }
-    
-    // first pass, do not use function prototypes
-    for (auto super = this; super != nullptr; super = super->get_parent_type()) {
+
+    auto& slot = g_member_tables[index];
+
+    if (auto existing = slot.load(std::memory_order_acquire); existing != nullptr) {
+        return existing;
+    }
+
+    auto table = std::make_unique<MemberTable>();
+
+    for (auto super = t; super != nullptr; super = super->get_parent_type()) {
+        for (auto f : super->get_fields()) {
+            const auto name = f != nullptr ? f->get_name() : nullptr;
+
+            if (name == nullptr) {
+                continue;
+            }
+
+            table->fields.insert(helpers::NameTable<sdk::REField*>::hash(name), f, [&](sdk::REField* other) {
+                return std::string_view{name} == other->get_name();
+            });
+        }
+
         for (auto& m : super->get_methods()) {
-            if (name == m.get_name()) {
-                std::unique_lock _{g_method_mtx};
+            const auto name = m.get_name();
 
-                g_method_map[full_name] = &m;
-                return g_method_map[full_name];
+            if (name == nullptr) {
+                continue;
             }
+
+            table->methods.insert(helpers::NameTable<sdk::REMethodDefinition*>::hash(name), &m, [&](sdk::REMethodDefinition* other) {
+                return std::string_view{name} == other->get_name();
+            });
         }
     }
-    
-    // second pass, build a function prototype
-    for (auto super = this; super != nullptr; super = super->get_parent_type()) {
+
+    return publish(slot, std::move(table));
+}
+
+static MemberTable::PrototypeTable* get_prototype_table(const sdk::RETypeDefinition* t, MemberTable* table) {
+    if (auto existing = table->prototypes.load(std::memory_order_acquire); existing != nullptr) {
+        return existing;
+    }
+
+    auto prototypes = std::make_unique<MemberTable::PrototypeTable>();
+    auto& pool = prototypes->pool;
+
+    for (auto super = t; super != nullptr; super = super->get_parent_type()) {
         for (auto& m : super->get_methods()) {
-            const auto method_param_types = m.get_param_types();
-            const auto method_param_names = m.get_param_names();
+            const auto name = m.get_name();
+
+            if (name == nullptr) {
+                continue;
+            }
+
+            const auto offset = (uint32_t)pool.size();
+
+            pool += name;
+            pool += "(";
 
-            std::stringstream ss{};
-            ss << m.get_name() << "(";
+            const auto method_param_types = m.get_param_types();
 
             for (auto i = 0; i < method_param_types.size(); i++) {
                 if (i > 0) {
-                    ss << ", ";
+                    pool += ", ";
+                }
+
+                if (method_param_types[i] != nullptr) {
+                    pool += method_param_types[i]->get_full_name();
                 }
-                ss << method_param_types[i]->get_full_name();
             }
 
-            ss << ")";
-            const auto method_prototype = ss.str();
+            pool += ")";
 
-            if (name == method_prototype) {
-                std::unique_lock _{g_method_mtx};
+            MemberTable::Prototype p{&m, offset, (uint32_t)pool.size() - offset};
+            const auto prototype = prototypes->get_prototype(p);
 
-                g_method_map[full_name] = &m;
-                return g_method_map[full_name];
-            }
+            prototypes->methods.insert(helpers::NameTable<MemberTable::Prototype>::hash(prototype), p, [&](const MemberTable::Prototype& other) {
+                return prototypes->get_prototype(other) == prototype;
+            });
         }
     }
 
-    return g_method_map[full_name];
+    return publish(table->prototypes, std::move(prototypes));
+}
+}
+
+sdk::REField* RETypeDefinition::get_field(std::string_view name) const {
+    const auto table = detail::get_member_table(this);
+
+    if (table == nullptr) {
+        return nullptr;
+    }
+
+    const auto result = table->fields.find(helpers::NameTable<sdk::REField*>::hash(name), [&](sdk::REField* f) {
+        return name == f->get_name();
+    });
+
+    return result != nullptr ? *result : nullptr;
+}
+
+sdk::REMethodDefinition* RETypeDefinition::get_method(std::string_view name) const {
+    // originally this was cached by this->get_full_name() + "." + name.data()
+    // but that doesn't work for generic types if we haven't yet mapped out
+    // how generic (instantiated) types work for the game we're working with
+    // so the tables are keyed by type index instead
+    const auto table = detail::get_member_table(this);
+
+    if (table == nullptr) {
+        return nullptr;
+    }
+
+    // first pass, do not use function prototypes
+    const auto result = table->methods.find(helpers::NameTable<sdk::REMethodDefinition*>::hash(name), [&](sdk::REMethodDefinition* m) {
+        return name == m->get_name();
+    });
+
+    if (result != nullptr) {
+        return *result;
+    }
+
+    // names with no parameter list can't match a prototype, don't bother building the table
+    if (name.find('(') == std::string_view::npos) {
+        return nullptr;
+    }
+
+    // second pass, match against the function prototype
+    const auto prototypes = detail::get_prototype_table(this, table);
+    const auto prototype_result = prototypes->methods.find(helpers::NameTable<detail::MemberTable::Prototype>::hash(name), [&](const detail::MemberTable::Prototype& p) {
+        return prototypes->get_prototype(p) == name;
+    });
+
+    return prototype_result != nullptr ? prototype_result->method : nullptr;
 }
 
 std::vector<sdk::REMethodDefinition*> RETypeDefinition::get_methods(std::string_view name) const {
@@ -584,11 +740,107 @@ bool RETypeDefinition::has_fieldptr_offset() const {
 #endif
 }
 
+// Pre-order numbering of the inheritance forest. Every type's descendants are numbered right after it,
+// so "a derives from b" becomes enter[b] <= enter[a] < exit[b].
+struct TypeHierarchy {
+    static constexpr uint32_t UNINDEXED = 0xFFFFFFFF;
+
+    std::vector<uint32_t> enter{};
+    std::vector<uint32_t> exit{}; // one past the last descendant
+};
+
+static TypeHierarchy g_type_hierarchy{};
+static std::once_flag g_type_hierarchy_once{};
+
+static const TypeHierarchy& get_type_hierarchy() {
+    std::call_once(g_type_hierarchy_once, []() {
+        const auto tdb = RETypeDB::get();
+        const auto num_types = (uint32_t)tdb->numTypes;
+
+        auto& h = g_type_hierarchy;
+        h.enter.assign(num_types, TypeHierarchy::UNINDEXED);
+        h.exit.assign(num_types, TypeHierarchy::UNINDEXED);
+
+        // Children of each type laid out contiguously, child_start[i]..child_start[i + 1]
+        std::vector<uint32_t> parents(num_types, TypeHierarchy::UNINDEXED);
+        std::vector<uint32_t> child_start(num_types + 1, 0);
+        std::vector<uint32_t> children{};
+        std::vector<uint32_t> roots{};
+
+        for (uint32_t i = 0; i < num_types; ++i) {
+            const auto parent = tdb->get_type(i)->get_parent_type();
+            const auto parent_index = parent != nullptr ? parent->get_index() : TypeHierarchy::UNINDEXED;
+
+            if (parent_index < num_types && parent_index != i) {
+                parents[i] = parent_index;
+                ++child_start[parent_index + 1];
+            } else {
+                roots.push_back(i);
+            }
+        }
+
+        for (uint32_t i = 0; i < num_types; ++i) {
+            child_start[i + 1] += child_start[i];
+        }
+
+        children.resize(child_start[num_types]);
+        auto fill = child_start;
+
+        for (uint32_t i = 0; i < num_types; ++i) {
+            if (parents[i] != TypeHierarchy::UNINDEXED) {
+                children[fill[parents[i]]++] = i;
+            }
+        }
+
+        // Types stuck in a parent cycle never get reached from a root and stay unindexed.
+        struct Pending {
+            uint32_t index;
+            uint32_t next_child;
+        };
+
+        std::vector<Pending> stack{};
+        uint32_t counter = 0;
+
+        for (const auto root : roots) {
+            h.enter[root] = counter++;
+            stack.push_back({root, child_start[root]});
+
+            while (!stack.empty()) {
+                auto& top = stack.back();
+
+                if (top.next_child < child_start[top.index + 1]) {
+                    const auto child = children[top.next_child++];
+
+                    h.enter[child] = counter++;
+                    stack.push_back({child, child_start[child]});
+                } else {
+                    h.exit[top.index] = counter;
+                    stack.pop_back();
+                }
+            }
+        }
+    });
+
+    return g_type_hierarchy;
+}
+
 bool RETypeDefinition::is_a(sdk::RETypeDefinition* other) const {
     if (other == nullptr) {
         return false;
     }
 
+    if (other == this) {
+        return true;
+    }
+
+    const auto& h = get_type_hierarchy();
+    const auto a = this->get_index();
+    const auto b = other->get_index();
+
+    if (a < h.enter.size() && b < h.enter.size() && h.enter[a] != TypeHierarchy::UNINDEXED && h.enter[b] != TypeHierarchy::UNINDEXED) {
+        return h.enter[b] <= h.enter[a] && h.enter[a] < h.exit[b];
+    }
+
     for (auto super = this; super != nullptr; super = super->get_parent_type()) {
         if (super == other) {
             return true;
@@ -738,7 +990,7 @@ bool RETypeDefinition::is_primitive() const {
     return g_primitive_map[this];
 #else
     // RE7 is missing get_IsPrimitive and System.RuntimeType
-    const auto full_name_hash = utility::hash(this->get_full_name());
+    const auto full_name_hash = utility::hash(this->get_full_name_view());
 
     switch (full_name_hash) {
     case "System.Boolean"_fnv:[[fallthrough]];
@@ -312,6 +312,13 @@ struct RETypeDefinition : public sdk::RETypeDefinition_ {
     const char* get_name() const;
 
     std::string get_full_name() const;
+
+    // Points into the name arena built along with the type index, valid for as long as the TDB is.
+    std::string_view get_full_name_view() const;
+
+    // Empty when the name can't be built from the TDB alone (generics and arrays need the VM).
+    std::string get_native_full_name() const;
+
     std::vector<std::string> get_name_hierarchy() const;
 
     sdk::RETypeDefinition* get_declaring_type() const;
@@ -2,10 +2,22 @@
 
 #include "utility/Scan.hpp"
 #include "utility/Module.hpp"
+#include "utility/ScanBatch.hpp"
 
 #include "RETypeDB.hpp"
 #include "RETypes.hpp"
 
+namespace {
+// RE2, RE3, RE8, DMC5. Scanned once for the first reference and once for all of them.
+constexpr auto type_list_signature = "48 8d 0d ? ? ? ? e8 ? ? ? ? 48 8d 05 ? ? ? ? 48 89 03";
+const utility::CachedScan type_list_pattern{type_list_signature};
+const utility::CachedScan type_list_all_pattern{type_list_signature, true};
+
+// RE7, mov edx, 8F7E7AEh (TypeInfoNone hash)
+const utility::CachedScan typeinfo_none_pattern{"BA AE E7 F7 08"};
+const utility::CachedScan type_list_alternative_pattern{"48 8B 0D ? ? ? ? 8B F0 48 85 C9 74 ? E8 ? ? ? ?"};
+}
+
 namespace reframework {
 std::unique_ptr<RETypes>& get_types() {
     static auto types = std::make_unique<RETypes>();
@@ -47,27 +59,21 @@ std::string& game_namespace(std::string_view base_name)
 RETypes::RETypes() {
     spdlog::info("RETypes initialization");
 
-    // RE2, RE3, RE8, DMC5
-    auto pat = "48 8d 0d ? ? ? ? e8 ? ? ? ? 48 8d 05 ? ? ? ? 48 89 03";
     const auto mod = utility::get_executable();
 
     auto types_offset = 3;
-    auto ref = utility::scan(mod, pat);
+    auto ref = utility::scan_cached(mod, type_list_pattern);
 
     bool re7_version = false;
 
     if (!ref) {
         // Scan for RE7 version
-        // mov edx, 8F7E7AEh (TypeInfoNone hash)
-        pat = "BA AE E7 F7 08";
-
-        const auto typeinfo_none_ref = utility::scan(mod, pat);
+        const auto typeinfo_none_ref = utility::scan_cached(mod, typeinfo_none_pattern);
 
         if (!typeinfo_none_ref) {
             spdlog::error("Failed to find TypeInfoNone");
 
-            const auto alternative_pat = "48 8B 0D ? ? ? ? 8B F0 48 85 C9 74 ? E8 ? ? ? ?";
-            const auto alternative_ref = utility::scan(mod, alternative_pat);
+            const auto alternative_ref = utility::scan_cached(mod, type_list_alternative_pattern);
 
             if (alternative_ref) {
                 spdlog::info("Found alternative reference for type list");
@@ -114,24 +120,20 @@ RETypes::RETypes() {
     m_raw_types = (TypeList*)(utility::calculate_absolute(*ref + types_offset));
     spdlog::info("Initial TypeList: {:x}", (uintptr_t)m_raw_types);
 
-    const auto start = (uintptr_t)utility::get_executable();
-    const auto module_size = utility::get_module_size(mod);
-    const auto module_end = (uintptr_t)utility::get_executable() + *module_size;
-
     if (!re7_version) {
         bool found_something = false;
 
         // keeps track of how many references there are to each potential type list
         std::unordered_map<uintptr_t, uint32_t> references{};
 
-        // Scan multiple times to find all references to TypeList
+        // Find all references to TypeList in one pass
         // If more than 20 references are found for a single address, it's the right one
-        for (auto i = utility::scan(start, module_end - start, pat); i.has_value(); i = utility::scan(*i + 1, module_end - (*i + 1), pat)) {
-            auto potential_types_ptr = utility::calculate_absolute(*i + 3);
+        for (const auto i : utility::scan_all_cached(mod, type_list_all_pattern)) {
+            auto potential_types_ptr = utility::calculate_absolute(i + 3);
 
             // Log the potential type if it's not already in the map
             if (references.find(potential_types_ptr) != references.end()) {
-                spdlog::info("Potential ref: {:x}", (uintptr_t)*i);
+                spdlog::info("Potential ref: {:x}", i);
                 spdlog::info("Potential TypeList: {:x}", (uintptr_t)potential_types_ptr);
             }
 
@@ -139,7 +141,7 @@ RETypes::RETypes() {
 
             // this is for sure the right one
             if (references[potential_types_ptr] > 20) {
-                ref = *i;
+                ref = i;
                 m_raw_types = (TypeList*)potential_types_ptr;
                 found_something = true;
                 break;
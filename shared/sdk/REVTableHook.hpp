@@ -31,6 +31,10 @@ public:
 
     bool hook_method(uint32_t index, void* destination);
 
+    // Puts the original object info back but keeps the copied vtable alive until destruction,
+    // for threads that already loaded the hooked object info.
+    void unhook();
+
     template<typename T>
     T get_original(uint32_t index) {
         if (index >= m_new_vtable.size()) {
@@ -42,7 +46,6 @@ public:
 
 private:
     bool hook();
-    void unhook();
     uint32_t calculate_vtable_size(void** vtable) const;
 
     bool m_hooked{false};
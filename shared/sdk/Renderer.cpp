@@ -1,9 +1,13 @@
 #include <algorithm>
+#include <shared_mutex>
+
+#include <xmmintrin.h>
 
 #include <spdlog/spdlog.h>
 
 #include <utility/Scan.hpp>
 #include <utility/Module.hpp>
+#include <utility/ScanBatch.hpp>
 
 #include "Application.hpp"
 #include "RETypeDB.hpp"
@@ -11,6 +15,16 @@
 
 #include "Renderer.hpp"
 
+namespace {
+// Found lazily, but registered so a cold start finds them along with the other startup scans, see utility::CachedScan
+const utility::CachedScan add_scene_view_pattern{"4C 8D 05 ? ? ? ? 48 8D ? ? 48 8D ? 08 E8 ? ? ? ? 48 ? ? FF 15"};
+const utility::CachedScan remove_scene_view_pattern{"4C 8D 05 ? ? ? ? 48 8D ? ? ? 48 8D ? 28 E8 ? ? ? ? 48 ? ? FF 15"};
+const utility::CachedScan add_layer_pattern{"41 B8 00 00 00 05 48 8B F8 E8 ? ? ? ?"}; // mov r8d, 5000000h; call add_layer
+const utility::CachedScan add_layer_fallback_pattern{"41 B8 00 00 00 05 48 89 C7 E8 ? ? ? ?"}; // mov r8d, 5000000h; call add_layer
+const utility::CachedScan create_render_target_view_pattern{"44 89 7C 24 2C C7 44 24 20 1C 00 00 00 E8 ? ? ? ?"};
+const utility::CachedScan create_render_target_view_fallback_pattern{"4C 8D 45 B8 49 8B CE E8 ? ? ? ?"};
+}
+
 namespace detail {
 using AddSceneViewFn = void (*)(void*);
 AddSceneViewFn get_add_scene_view() {
@@ -37,7 +51,7 @@ AddSceneViewFn get_add_scene_view() {
         // L"Renderer::DelayEndTask"
         // L"Renderer::DelayReleaseTask"
         const auto mod = utility::get_executable();
-        auto ref = utility::scan(mod, "4C 8D 05 ? ? ? ? 48 8D ? ? 48 8D ? 08 E8 ? ? ? ? 48 ? ? FF 15");
+        auto ref = utility::scan_cached(mod, add_scene_view_pattern);
 
         if (!ref) {
             spdlog::error("[Renderer] Failed to find add_scene_view_fn");
@@ -64,11 +78,11 @@ RenderLayer* RenderLayer::add_layer(::REType* layer_type, uint32_t priority, uin
 
         const auto mod = utility::get_executable();
         
-        auto ref = utility::scan(mod, "41 B8 00 00 00 05 48 8B F8 E8 ? ? ? ?"); // mov r8d, 5000000h; call add_layer
+        auto ref = utility::scan_cached(mod, add_layer_pattern);
 
         if (!ref) {
             // Fallback pattern
-            ref = utility::scan(mod, "41 B8 00 00 00 05 48 89 C7 E8 ? ? ? ?"); // mov r8d, 5000000h; call add_layer
+            ref = utility::scan_cached(mod, add_layer_fallback_pattern);
 
             if (!ref) {
                 auto add_scene_view_fn = detail::get_add_scene_view();
@@ -522,7 +536,7 @@ void remove_scene_view(void* scene_view) {
 
         // Almost the same as add_scene_view pattern, is set up right after add_scene_view
         const auto mod = utility::get_executable();
-        auto ref = utility::scan(mod, "4C 8D 05 ? ? ? ? 48 8D ? ? ? 48 8D ? 28 E8 ? ? ? ? 48 ? ? FF 15");
+        auto ref = utility::scan_cached(mod, remove_scene_view_pattern);
 
         if (!ref) {
             spdlog::error("[Renderer] Failed to find remove_scene_view_fn");
@@ -669,59 +683,157 @@ sdk::renderer::layer::Output* get_output_layer() {
     return sdk::call_native_func<sdk::renderer::layer::Output*>(nullptr, renderer_t, "getOutputLayer", sdk::get_thread_context(), nullptr);
 }
 
-std::optional<Vector2f> world_to_screen(const Vector3f& world_pos) {
-    auto camera = sdk::get_primary_camera();
+namespace detail {
+std::shared_mutex camera_snapshot_mutex{};
+CameraSnapshot camera_snapshot{};
 
-    if (camera == nullptr) {
-        return std::nullopt;
+// Projects up to 4 points at once, mask has a bit set for every point that made it on screen
+int project_points4(const CameraSnapshot& cam, const Vector3f* points, size_t count, Vector2f* out, bool cull_offscreen) {
+    float xs[4]{}, ys[4]{}, zs[4]{};
+
+    for (size_t i = 0; i < count; ++i) {
+        xs[i] = points[i].x;
+        ys[i] = points[i].y;
+        zs[i] = points[i].z;
     }
 
-    auto main_view = sdk::get_main_view();
+    const auto x = _mm_loadu_ps(xs);
+    const auto y = _mm_loadu_ps(ys);
+    const auto z = _mm_loadu_ps(zs);
+    const auto& m = cam.view_proj;
+
+    const auto row = [&](int r) {
+        auto result = _mm_set1_ps(m[3][r]);
+        result = _mm_add_ps(result, _mm_mul_ps(x, _mm_set1_ps(m[0][r])));
+        result = _mm_add_ps(result, _mm_mul_ps(y, _mm_set1_ps(m[1][r])));
+        return _mm_add_ps(result, _mm_mul_ps(z, _mm_set1_ps(m[2][r])));
+    };
+
+    const auto clip_x = row(0);
+    const auto clip_y = row(1);
+    const auto clip_w = row(3);
+
+    // The camera looks down -AxisZ, anything with a positive dot product against AxisZ is behind it
+    auto facing = _mm_mul_ps(_mm_sub_ps(x, _mm_set1_ps(cam.origin.x)), _mm_set1_ps(cam.forward.x));
+    facing = _mm_add_ps(facing, _mm_mul_ps(_mm_sub_ps(y, _mm_set1_ps(cam.origin.y)), _mm_set1_ps(cam.forward.y)));
+    facing = _mm_add_ps(facing, _mm_mul_ps(_mm_sub_ps(z, _mm_set1_ps(cam.origin.z)), _mm_set1_ps(cam.forward.z)));
 
-    if (main_view == nullptr) {
-        return std::nullopt;
+    auto visible = _mm_and_ps(_mm_cmplt_ps(facing, _mm_setzero_ps()), _mm_cmpgt_ps(clip_w, _mm_set1_ps(1e-6f)));
+
+    const auto inv_w = _mm_div_ps(_mm_set1_ps(1.0f), clip_w);
+    const auto ndc_x = _mm_mul_ps(clip_x, inv_w);
+    const auto ndc_y = _mm_mul_ps(clip_y, inv_w);
+
+    if (cull_offscreen) {
+        const auto one = _mm_set1_ps(1.0f);
+        const auto neg_one = _mm_set1_ps(-1.0f);
+
+        visible = _mm_and_ps(visible, _mm_and_ps(_mm_cmple_ps(ndc_x, one), _mm_cmpge_ps(ndc_x, neg_one)));
+        visible = _mm_and_ps(visible, _mm_and_ps(_mm_cmple_ps(ndc_y, one), _mm_cmpge_ps(ndc_y, neg_one)));
     }
 
-    auto context = sdk::get_thread_context();
+    const auto half = _mm_set1_ps(0.5f);
+    const auto screen_x = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(ndc_x, half), half), _mm_set1_ps(cam.screen_size.x));
+    const auto screen_y = _mm_mul_ps(_mm_sub_ps(half, _mm_mul_ps(ndc_y, half)), _mm_set1_ps(cam.screen_size.y));
 
-    static auto transform_def = sdk::find_type_definition("via.Transform");
-    static auto math_t = sdk::find_type_definition("via.math");
+    float sx[4]{}, sy[4]{};
+    _mm_storeu_ps(sx, screen_x);
+    _mm_storeu_ps(sy, screen_y);
 
-    static auto get_gameobject_method = transform_def->get_method("get_GameObject");
-    static auto get_axisz_method = transform_def->get_method("get_AxisZ");
-    static auto world_to_screen = math_t->get_method("worldPos2ScreenPos(via.vec3, via.mat4, via.mat4, via.Size)");
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = Vector2f{sx[i], sy[i]};
+    }
 
-    auto camera_gameobject = get_gameobject_method->call<REGameObject*>(context, camera);
-    auto camera_transform = camera_gameobject->transform;
+    return _mm_movemask_ps(visible) & ((1 << count) - 1);
+}
+}
 
-    Matrix4x4f proj{}, view{};
-    float screen_size[2]{};
+void update_camera_snapshot() {
+    CameraSnapshot snapshot{};
 
-    auto camera_origin = sdk::get_transform_position(camera_transform);
-    camera_origin.w = 1.0f;
+    auto camera = sdk::get_primary_camera();
+    auto main_view = sdk::get_main_view();
+
+    if (camera != nullptr && main_view != nullptr) {
+        auto context = sdk::get_thread_context();
 
-    Vector4f camera_forward{};
-    get_axisz_method->call<void*>(&camera_forward, context, camera_transform);
+        static auto transform_def = sdk::find_type_definition("via.Transform");
+        static auto get_gameobject_method = transform_def->get_method("get_GameObject");
+        static auto get_axisz_method = transform_def->get_method("get_AxisZ");
 
-    camera_forward.w = 1.0f;
+        auto camera_gameobject = get_gameobject_method->call<REGameObject*>(context, camera);
+        auto camera_transform = camera_gameobject != nullptr ? camera_gameobject->transform : nullptr;
 
-    sdk::call_object_func<void*>(camera, "get_ProjectionMatrix", &proj, context, camera);
-    sdk::call_object_func<void*>(camera, "get_ViewMatrix", &view, context, camera);
-    sdk::call_object_func<void*>(main_view, "get_WindowSize", &screen_size, context, main_view);
+        if (camera_transform != nullptr) {
+            float screen_size[2]{};
 
-    const Vector4f pos = Vector4f{world_pos, 1.0f};
-    Vector4f screen_pos{};
+            snapshot.origin = sdk::get_transform_position(camera_transform);
+            snapshot.origin.w = 1.0f;
 
-    const auto delta = pos - camera_origin;
+            get_axisz_method->call<void*>(&snapshot.forward, context, camera_transform);
+            snapshot.forward.w = 1.0f;
 
-    // behind camera
-    if (glm::dot(Vector3f{delta}, Vector3f{-camera_forward}) <= 0.0f) {
-        return std::nullopt;
+            sdk::call_object_func<void*>(camera, "get_ProjectionMatrix", &snapshot.proj, context, camera);
+            sdk::call_object_func<void*>(camera, "get_ViewMatrix", &snapshot.view, context, camera);
+            sdk::call_object_func<void*>(main_view, "get_WindowSize", &screen_size, context, main_view);
+
+            snapshot.view_proj = snapshot.proj * snapshot.view;
+            snapshot.screen_size = Vector2f{screen_size[0], screen_size[1]};
+            snapshot.valid = true;
+        }
     }
 
-    world_to_screen->call<void*>(&screen_pos, context, &pos, &view, &proj, &screen_size);
+    std::unique_lock _{detail::camera_snapshot_mutex};
+    snapshot.frame = detail::camera_snapshot.frame + 1;
+    detail::camera_snapshot = snapshot;
+}
+
+CameraSnapshot get_camera_snapshot() {
+    {
+        std::shared_lock _{detail::camera_snapshot_mutex};
+
+        if (detail::camera_snapshot.valid) {
+            return detail::camera_snapshot;
+        }
+    }
+
+    // Nothing captured yet (or there was no camera at BeginRendering), try now
+    update_camera_snapshot();
+
+    std::shared_lock _{detail::camera_snapshot_mutex};
+    return detail::camera_snapshot;
+}
+
+std::optional<Vector2f> world_to_screen(const Vector3f& world_pos) {
+    std::optional<Vector2f> out{};
+    world_to_screen(std::span{&world_pos, 1}, std::span{&out, 1});
+
+    return out;
+}
+
+void world_to_screen(std::span<const Vector3f> world_pos, std::span<std::optional<Vector2f>> out, bool cull_offscreen) {
+    const auto count = std::min(world_pos.size(), out.size());
+    const auto camera = get_camera_snapshot();
+
+    if (!camera.valid) {
+        std::fill(out.begin(), out.begin() + count, std::nullopt);
+        return;
+    }
+
+    Vector2f projected[4]{};
 
-    return Vector2f{screen_pos.x, screen_pos.y};
+    for (size_t i = 0; i < count; i += 4) {
+        const auto n = std::min<size_t>(4, count - i);
+        const auto visible = detail::project_points4(camera, &world_pos[i], n, projected, cull_offscreen);
+
+        for (size_t j = 0; j < n; ++j) {
+            if ((visible & (1 << j)) != 0) {
+                out[i + j] = projected[j];
+            } else {
+                out[i + j] = std::nullopt;
+            }
+        }
+    }
 }
 
 /*
@@ -969,11 +1081,11 @@ RenderTargetView* create_render_target_view(sdk::renderer::RenderResource* resou
         spdlog::info("Searching for create_render_target_view");
 
         const auto game = utility::get_executable();
-        const auto ref = utility::scan(game, "44 89 7C 24 2C C7 44 24 20 1C 00 00 00 E8 ? ? ? ?");
+        const auto ref = utility::scan_cached(game, create_render_target_view_pattern);
 
         if (!ref) {
             spdlog::info("Could not find first ref, performing fallback scan");
-            const auto ref2 = utility::scan(game, "4C 8D 45 B8 49 8B CE E8 ? ? ? ?");
+            const auto ref2 = utility::scan_cached(game, create_render_target_view_fallback_pattern);
 
             if (ref2) {
                 const auto result = (RenderTargetView* (*)(void*, sdk::renderer::RenderResource*, void*))utility::calculate_absolute(*ref2 + 8);
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <tuple>
 #include <optional>
+#include <span>
 
 #include "ReClass.hpp"
 #include "RENativeArray.hpp"
@@ -442,8 +443,28 @@ RenderLayer* find_layer(::REType* layer_type);
 
 sdk::renderer::layer::Output* get_output_layer();
 
+// Everything world_to_screen needs from the primary camera.
+// Captured once per frame at BeginRendering so projecting points doesn't go through the VM.
+struct CameraSnapshot {
+    Matrix4x4f view{};
+    Matrix4x4f proj{};
+    Matrix4x4f view_proj{};
+    Vector4f origin{};
+    Vector4f forward{}; // AxisZ of the camera transform, the camera looks down -forward
+    Vector2f screen_size{};
+    uint64_t frame{};
+    bool valid{false};
+};
+
+void update_camera_snapshot();
+CameraSnapshot get_camera_snapshot();
+
 std::optional<Vector2f> world_to_screen(const Vector3f& world_pos);
 
+// Projects world_pos into out (which must be at least as large).
+// Points behind the camera are std::nullopt, as are points outside of the screen if cull_offscreen is set.
+void world_to_screen(std::span<const Vector3f> world_pos, std::span<std::optional<Vector2f>> out, bool cull_offscreen = false);
+
 ConstantBuffer* create_constant_buffer(void* desc);
 TargetState* create_target_state(TargetState::Desc* desc);
 Texture* create_texture(void* desc);
@@ -4,10 +4,19 @@
 
 #include "utility/Scan.hpp"
 #include "utility/Module.hpp"
+#include "utility/ScanBatch.hpp"
 
 #include "RETypeDB.hpp"
 #include "ResourceManager.hpp"
 
+namespace {
+// create_userdata, shares the start of the function with create_resource
+const utility::CachedScan create_userdata_patterns[] {
+    {"66 83 F8 40 75 ? C6", true},
+    {"66 83 F8 40 75 ? 48", true}
+};
+}
+
 namespace sdk {
 // static definitions
 decltype(ResourceManager::s_create_resource_fn) ResourceManager::s_create_resource_fn = nullptr;
@@ -117,17 +126,19 @@ void ResourceManager::update_pointers() {
             
             // now find create_userdata, using the previous function as a reference to ignore
             // since they both have the same pattern at the start of the function
-            const auto valid_patterns = {
-                "66 83 F8 40 75 ? C6",
-                "66 83 F8 40 75 ? 48"
-            };
-
             bool found = false;
             bool exception_directory_maybe_removed = false;
 
-            for (const auto& pat : valid_patterns) {
-                for (auto ref = utility::scan(mod, pat); ref.has_value(); ref = utility::scan(*ref + 1, (mod_end - (*ref + 1)) - 100, pat)) {
-                    auto func = utility::find_function_start(*ref);
+            for (const auto& pat : create_userdata_patterns) {
+                const auto refs = utility::scan_all_cached(mod, pat);
+
+                for (const auto ref : refs) {
+                    // Matches after the first one have to end 100 bytes short of the end of the module
+                    if (ref != refs.front() && ref + utility::ScanBatch::length(pat) > mod_end - 100) {
+                        break;
+                    }
+
+                    auto func = utility::find_function_start(ref);
 
                     if (func && *func != (uintptr_t)s_create_resource_fn) {
                         if (std::abs((ptrdiff_t)(*func - (uintptr_t)s_create_resource_fn)) < 0x50) {
@@ -142,7 +153,7 @@ void ResourceManager::update_pointers() {
                             if (func) {
                                 *func += 3;
                             } else {
-                                func = utility::scan_reverse(*ref, 0x100, "4C 89 4C");
+                                func = utility::scan_reverse(ref, 0x100, "4C 89 4C");
                             }
                         }
 
@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include "REComponent.hpp"
+#include "REManagedObject.hpp"
+#include "REString.hpp"
+#include "RETypeDB.hpp"
+#include "RETypeDefinition.hpp"
+#include "SceneManager.hpp"
+#include "SystemArray.hpp"
+
+#include "SceneSnapshot.hpp"
+
+namespace sdk {
+namespace detail {
+std::atomic<uint64_t> scene_snapshot_frame{0};
+std::atomic<uint32_t> scene_snapshot_interval{1};
+
+std::mutex scene_snapshot_mutex{};
+std::shared_ptr<const SceneSnapshot> scene_snapshot{};
+
+std::shared_ptr<const SceneSnapshot> take_scene_snapshot(const SceneSnapshot* previous, uint64_t frame, uint32_t max_depth) {
+    auto snapshot = std::make_shared<SceneSnapshot>();
+    snapshot->frame = frame;
+    snapshot->max_depth = max_depth;
+
+    auto scene = sdk::get_current_scene();
+
+    if (scene == nullptr) {
+        return snapshot;
+    }
+
+    static auto scene_def = sdk::find_type_definition("via.Scene");
+    static auto transform_def = sdk::find_type_definition("via.Transform");
+    static auto get_first_transform_method = scene_def->get_method("get_FirstTransform");
+    static auto next_transform_method = transform_def->get_method("get_Next");
+    static auto child_transform_method = transform_def->get_method("get_Child");
+
+    const auto context = sdk::get_thread_context();
+
+    // Names and folders rarely change, so reuse whatever the last snapshot already looked up.
+    std::unordered_map<::REGameObject*, size_t> previous_indices{};
+
+    if (previous != nullptr) {
+        previous_indices.reserve(previous->size());
+
+        for (size_t i = 0; i < previous->size(); ++i) {
+            previous_indices[previous->game_objects[i]] = i;
+        }
+
+        snapshot->transforms.reserve(previous->size());
+        snapshot->game_objects.reserve(previous->size());
+        snapshot->names.reserve(previous->size());
+        snapshot->folder_paths.reserve(previous->size());
+        snapshot->positions.reserve(previous->size());
+        snapshot->depths.reserve(previous->size());
+    }
+
+    struct Pending {
+        ::RETransform* transform;
+        uint32_t depth;
+    };
+
+    std::vector<Pending> stack{};
+
+    for (auto t = get_first_transform_method->call<::RETransform*>(context, scene); t != nullptr; t = next_transform_method->call<::RETransform*>(context, t)) {
+        stack.push_back({t, 0});
+    }
+
+    // Keep the scene's order, roots first and each subtree right after its parent.
+    std::reverse(stack.begin(), stack.end());
+
+    while (!stack.empty()) {
+        const auto [transform, depth] = stack.back();
+        stack.pop_back();
+
+        if (depth < max_depth) {
+            const auto children_start = stack.size();
+
+            for (auto t = child_transform_method->call<::RETransform*>(context, transform); t != nullptr; t = next_transform_method->call<::RETransform*>(context, t)) {
+                stack.push_back({t, depth + 1});
+            }
+
+            std::reverse(stack.begin() + children_start, stack.end());
+        }
+
+        const auto game_object = utility::re_component::get_game_object(transform);
+
+        if (game_object == nullptr) {
+            continue;
+        }
+
+        snapshot->transforms.push_back(transform);
+        snapshot->game_objects.push_back(game_object);
+        snapshot->positions.push_back(transform->worldTransform[3]);
+        snapshot->depths.push_back(depth);
+
+        if (auto it = previous_indices.find(game_object); it != previous_indices.end() && previous->transforms[it->second] == transform) {
+            snapshot->names.push_back(previous->names[it->second]);
+            snapshot->folder_paths.push_back(previous->folder_paths[it->second]);
+        } else {
+            snapshot->names.push_back(utility::re_string::get_string(game_object->name));
+            snapshot->folder_paths.push_back(get_folder_path(game_object));
+        }
+    }
+
+    return snapshot;
+}
+
+std::shared_ptr<const SceneSnapshot> get_scene_snapshot(uint32_t interval, uint32_t max_depth) {
+    const auto frame = scene_snapshot_frame.load(std::memory_order_acquire);
+    interval = std::max<uint32_t>(interval, 1);
+
+    std::scoped_lock _{scene_snapshot_mutex};
+
+    if (scene_snapshot != nullptr && scene_snapshot->max_depth >= max_depth && frame < scene_snapshot->frame + interval) {
+        return scene_snapshot;
+    }
+
+    scene_snapshot = take_scene_snapshot(scene_snapshot.get(), frame, max_depth);
+
+    return scene_snapshot;
+}
+}
+
+std::vector<size_t> SceneSnapshot::find_with_component(sdk::RETypeDefinition* t) const {
+    std::vector<size_t> out{};
+
+    if (t == nullptr || t->get_type() == nullptr) {
+        return out;
+    }
+
+    const auto re_type = t->get_type();
+
+    for (size_t i = 0; i < transforms.size(); ++i) {
+        // The transform is the first component in the chain
+        if (utility::re_managed_object::is_a(transforms[i], re_type) || utility::re_component::find(transforms[i], re_type) != nullptr) {
+            out.push_back(i);
+        }
+    }
+
+    return out;
+}
+
+std::shared_ptr<const SceneSnapshot> get_scene_snapshot(uint32_t max_depth) {
+    return detail::get_scene_snapshot(detail::scene_snapshot_interval.load(std::memory_order_relaxed), max_depth);
+}
+
+std::shared_ptr<const SceneSnapshot> get_current_scene_snapshot(uint32_t max_depth) {
+    return detail::get_scene_snapshot(1, max_depth);
+}
+
+std::optional<std::vector<::REComponent*>> find_scene_components(sdk::RETypeDefinition* t) {
+    static auto scene_def = sdk::find_type_definition("via.Scene");
+    static auto find_components_method = scene_def->get_method("findComponents(System.Type)");
+
+    if (find_components_method == nullptr || t == nullptr || t->get_runtime_type() == nullptr) {
+        return std::nullopt;
+    }
+
+    std::vector<::REComponent*> out{};
+    auto scene = sdk::get_current_scene();
+
+    if (scene == nullptr) {
+        return out;
+    }
+
+    const auto components = find_components_method->call<sdk::SystemArray*>(sdk::get_thread_context(), scene, t->get_runtime_type());
+
+    if (components == nullptr) {
+        return out;
+    }
+
+    for (auto v : *components) {
+        if (v != nullptr) {
+            out.push_back((::REComponent*)v);
+        }
+    }
+
+    return out;
+}
+
+std::string get_folder_path(::REGameObject* game_object) {
+    static auto gameobject_def = sdk::find_type_definition("via.GameObject");
+    static auto folder_def = sdk::find_type_definition("via.Folder");
+    static auto get_folder_method = gameobject_def->get_method("get_Folder");
+    static auto get_folder_path_method = folder_def->get_method("get_Path");
+
+    const auto context = sdk::get_thread_context();
+    const auto folder = get_folder_method->call<::REManagedObject*>(context, game_object);
+
+    if (folder == nullptr) {
+        return {};
+    }
+
+    const auto path = get_folder_path_method->call<::SystemString*>(context, folder);
+
+    if (path == nullptr) {
+        return {};
+    }
+
+    return utility::re_string::get_string(path);
+}
+
+void set_scene_snapshot_interval(uint32_t frames) {
+    detail::scene_snapshot_interval = std::max<uint32_t>(frames, 1);
+}
+
+uint32_t get_scene_snapshot_interval() {
+    return detail::scene_snapshot_interval;
+}
+
+void advance_scene_snapshot_frame() {
+    detail::scene_snapshot_frame.fetch_add(1, std::memory_order_release);
+}
+}
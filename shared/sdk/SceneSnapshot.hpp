@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Math.hpp"
+
+class RETransform;
+class REGameObject;
+class REComponent;
+
+namespace sdk {
+struct RETypeDefinition;
+
+// One walk of the current scene's transform tree, shared by every tool and script that needs it.
+// Only goes max_depth levels below the roots, walking the whole tree is too slow to do every frame.
+// Structure of arrays, index i of every array describes the same object.
+// The pointers are only guaranteed to be alive for the frame the snapshot was taken on.
+struct SceneSnapshot {
+    std::vector<::RETransform*> transforms{};
+    std::vector<::REGameObject*> game_objects{};
+    std::vector<std::string> names{};
+    std::vector<std::string> folder_paths{};
+    std::vector<Vector4f> positions{};
+    std::vector<uint32_t> depths{}; // 0 for the scene's root transforms
+
+    uint64_t frame{};
+    uint32_t max_depth{};
+
+    size_t size() const {
+        return transforms.size();
+    }
+
+    // Indices of the objects that have a component of type t (or derived from it).
+    // Only sees the objects the snapshot walked, prefer find_scene_components.
+    std::vector<size_t> find_with_component(sdk::RETypeDefinition* t) const;
+};
+
+// Retaken at most once every get_scene_snapshot_interval() frames, and only when someone asks for it.
+// max_depth = 0 only takes the roots. A cached snapshot that went at least as deep is reused.
+// Names and folder paths are carried over for game objects that were already in the previous snapshot.
+// The snapshot can be from an earlier frame, so only its copied data (names, positions...) is safe to use.
+std::shared_ptr<const SceneSnapshot> get_scene_snapshot(uint32_t max_depth = 0);
+
+// Always taken on the current frame, for callers that dereference the snapshot's pointers
+// or hand them to scripts. Shares the cache with get_scene_snapshot().
+std::shared_ptr<const SceneSnapshot> get_current_scene_snapshot(uint32_t max_depth = 0);
+
+// Components of type t (or derived from it) anywhere in the current scene, through via.Scene's findComponents(System.Type).
+// nullopt if the game doesn't have it, search a snapshot with find_with_component instead.
+std::optional<std::vector<::REComponent*>> find_scene_components(sdk::RETypeDefinition* t);
+
+// Path of the folder the game object is in, empty if it isn't in one.
+std::string get_folder_path(::REGameObject* game_object);
+
+void set_scene_snapshot_interval(uint32_t frames);
+uint32_t get_scene_snapshot_interval();
+
+// Called once per frame by the hooks.
+void advance_scene_snapshot_frame();
+}
@@ -1,8 +1,39 @@
+#include <algorithm>
+#include <cstring>
+
 #include "RETypeDB.hpp"
+#include "RETypeDefinition.hpp"
+#include "REArray.hpp"
 
 #include "SystemArray.hpp"
 
+std::optional<sdk::SystemArray::Layout> sdk::SystemArray::get_layout() {
+    const auto container = (::REArrayBase*)this;
+    const auto element_type = utility::re_array::get_contained_type(container);
+
+    if (element_type == nullptr) {
+        return std::nullopt;
+    }
+
+    Layout layout{};
+    layout.element_type = element_type;
+    layout.inline_elements = element_type->get_vm_obj_type() == via::clr::VMObjType::ValType;
+    layout.element_size = layout.inline_elements ? utility::re_type::get_value_type_size(element_type->get_type()) : sizeof(void*);
+    layout.size = container->numElements > 0 ? (size_t)container->numElements : 0;
+    layout.data = (uint8_t*)((uintptr_t)((::REArrayBase*)utility::re_managed_object::get_field_ptr(container) + 1) - sizeof(::REManagedObject));
+
+    if (layout.element_size == 0) {
+        return std::nullopt;
+    }
+
+    return layout;
+}
+
 size_t sdk::SystemArray::get_size() {
+    if (const auto layout = get_layout(); layout) {
+        return layout->size;
+    }
+
     static auto system_array_type = sdk::find_type_definition("System.Array");
     static auto get_length_method = system_array_type->get_method("GetLength");
 
@@ -10,10 +41,18 @@ size_t sdk::SystemArray::get_size() {
 }
 
 ::REManagedObject* sdk::SystemArray::get_element(int32_t index) {
-    if (index < 0 || index >= get_size()) {
+    const auto layout = get_layout();
+    const auto size = layout ? layout->size : get_size();
+
+    if (index < 0 || index >= size) {
         return nullptr;
     }
 
+    // Value types need GetValue to box them.
+    if (layout && !layout->inline_elements) {
+        return *(::REManagedObject**)layout->get_element_ptr(index);
+    }
+
     static auto system_array_type = sdk::find_type_definition("System.Array");
     static auto get_element_method = system_array_type->get_method("GetValue(System.Int32)");
 
@@ -32,13 +71,67 @@ void sdk::SystemArray::set_element(int32_t index, ::REManagedObject* value) {
 }
 
 std::vector<::REManagedObject*> sdk::SystemArray::get_elements() {
+    const auto layout = get_layout();
+
+    if (layout && !layout->inline_elements) {
+        const auto data = (::REManagedObject**)layout->data;
+        return std::vector<::REManagedObject*>{data, data + layout->size};
+    }
+
     std::vector<::REManagedObject*> elements{};
-    const auto size = get_size();
+    const auto size = layout ? layout->size : get_size();
+
+    elements.reserve(size);
+
+    static auto system_array_type = sdk::find_type_definition("System.Array");
+    static auto get_element_method = system_array_type->get_method("GetValue(System.Int32)");
+
+    const auto context = sdk::get_thread_context();
 
     for (size_t i = 0; i < size; i++) {
-        elements.push_back(get_element(i));
+        elements.push_back(get_element_method->call_safe<::REManagedObject*>(context, this, (int32_t)i));
     }
 
     return elements;
 }
 
+size_t sdk::SystemArray::copy_elements(std::span<::REManagedObject*> out, size_t start) {
+    const auto layout = get_layout();
+
+    if (!layout || layout->inline_elements) {
+        const auto size = get_size();
+        size_t count = 0;
+
+        for (auto i = start; i < size && count < out.size(); ++i, ++count) {
+            out[count] = get_element((int32_t)i);
+        }
+
+        return count;
+    }
+
+    if (start >= layout->size) {
+        return 0;
+    }
+
+    const auto count = std::min(out.size(), layout->size - start);
+    memcpy(out.data(), layout->get_element_ptr(start), count * sizeof(void*));
+
+    return count;
+}
+
+void sdk::SystemArray::set_elements(std::span<::REManagedObject* const> values, size_t start) {
+    const auto size = get_size();
+
+    if (start > size || values.size() > size - start) {
+        throw std::out_of_range("index out of range");
+    }
+
+    static auto system_array_type = sdk::find_type_definition("System.Array");
+    static auto set_element_method = system_array_type->get_method("SetValue(System.Object, System.Int32)");
+
+    const auto context = sdk::get_thread_context();
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        set_element_method->call_safe<void>(context, this, values[i], (int32_t)(start + i));
+    }
+}
@@ -4,19 +4,96 @@ struct SystemArray;
 
 #pragma once
 
+#include <optional>
+#include <span>
+#include <type_traits>
 #include <vector>
 
 #include "REManagedObject.hpp"
 
 namespace sdk {
 struct SystemArray;
+struct RETypeDefinition;
 
 struct SystemArray : public ::REManagedObject {
+    // Where and how the elements are stored, decoded from the array header.
+    // Reference elements are stored as object pointers, value type elements are stored in place.
+    struct Layout {
+        sdk::RETypeDefinition* element_type{};
+        uint8_t* data{};
+        size_t size{};
+        uint32_t element_size{};
+        bool inline_elements{};
+
+        void* get_element_ptr(size_t index) const {
+            return data + (index * element_size);
+        }
+    };
+
+    // nullopt for arrays without a contained type, those only work through the managed System.Array methods.
+    std::optional<Layout> get_layout();
+
     size_t get_size();
     ::REManagedObject* get_element(int32_t index);
     void set_element(int32_t index, ::REManagedObject* value);
     std::vector<::REManagedObject*> get_elements();
 
+    // Copies the elements of a reference array starting at start into out, returns how many were copied.
+    size_t copy_elements(std::span<::REManagedObject*> out, size_t start = 0);
+
+    // Sets consecutive elements starting at start. Still goes through SetValue so reference counts stay correct,
+    // but the bounds are only checked once.
+    void set_elements(std::span<::REManagedObject* const> values, size_t start = 0);
+
+    // Zero-copy view over the element storage. T is the element itself for value type arrays
+    // and a pointer type for reference arrays. Empty if T's size doesn't match the elements.
+    template <typename T>
+    std::span<T> get_span() {
+        const auto layout = get_layout();
+
+        if (!layout || layout->element_size != sizeof(T)) {
+            return {};
+        }
+
+        return std::span<T>{(T*)layout->data, layout->size};
+    }
+
+    // Calls fn(index, element) for every element, stopping early if fn returns false.
+    // element is the object pointer for reference arrays, or a pointer to the element's storage for value type arrays.
+    template <typename Fn>
+    void for_each(Fn&& fn) {
+        auto call = [&](size_t i, void* element) {
+            if constexpr (std::is_same_v<std::invoke_result_t<Fn, size_t, void*>, bool>) {
+                return fn(i, element);
+            } else {
+                fn(i, element);
+                return true;
+            }
+        };
+
+        const auto layout = get_layout();
+
+        if (!layout) {
+            const auto size = get_size();
+
+            for (size_t i = 0; i < size; ++i) {
+                if (!call(i, get_element((int32_t)i))) {
+                    break;
+                }
+            }
+
+            return;
+        }
+
+        for (size_t i = 0; i < layout->size; ++i) {
+            const auto element = layout->inline_elements ? layout->get_element_ptr(i) : *(void**)layout->get_element_ptr(i);
+
+            if (!call(i, element)) {
+                break;
+            }
+        }
+    }
+
     using size_type = size_t;
     using value_type = ::REManagedObject*;
 
@@ -0,0 +1,376 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+#include <utility/Module.hpp>
+
+#include <tdb_snapshot/Format.hpp>
+
+#include "RETypeDB.hpp"
+#include "RETypeDefinition.hpp"
+
+#include "TDBSnapshot.hpp"
+
+namespace sdk {
+namespace format = ::tdb_snapshot::format;
+
+namespace detail {
+class SnapshotStrings {
+public:
+    uint32_t add(std::string_view str) {
+        if (str.empty()) {
+            return 0;
+        }
+
+        if (auto it = m_offsets.find(str); it != m_offsets.end()) {
+            return it->second;
+        }
+
+        const auto offset = (uint32_t)m_pool.size();
+
+        m_pool.append(str);
+        m_pool.push_back('\0');
+        m_offsets.emplace(std::string{str}, offset);
+
+        return offset;
+    }
+
+    uint32_t add(const char* str) {
+        return str != nullptr ? add(std::string_view{str}) : 0;
+    }
+
+    const std::string& pool() const {
+        return m_pool;
+    }
+
+private:
+    struct Hash {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view str) const {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+
+    std::string m_pool{std::string(1, '\0')};
+    std::unordered_map<std::string, uint32_t, Hash, std::equal_to<>> m_offsets{};
+};
+
+uint32_t snapshot_index(const sdk::RETypeDefinition* t) {
+    return t != nullptr ? t->get_index() : format::INVALID_INDEX;
+}
+
+// Sorts each type's slice of a name index so the loader can binary search it
+void sort_name_index(std::vector<format::NameIndexEntry>& entries, size_t start) {
+    std::sort(entries.begin() + start, entries.end(), [](const format::NameIndexEntry& a, const format::NameIndexEntry& b) {
+        return a.hash != b.hash ? a.hash < b.hash : a.index < b.index;
+    });
+}
+
+// How many bytes of init data a literal of type t has
+size_t get_init_data_size(sdk::RETypeDefinition* t, const uint8_t* init_data) {
+    if (t == nullptr) {
+        return 0;
+    }
+
+    if (t->get_full_name_view() == "System.String") {
+        return strlen((const char*)init_data) + 1;
+    }
+
+    if (t->is_enum()) {
+        if (auto underlying = t->get_underlying_type(); underlying != nullptr) {
+            t = underlying;
+        }
+    }
+
+    return t->is_value_type() ? t->get_valuetype_size() : 0;
+}
+}
+
+bool write_tdb_snapshot(const std::filesystem::path& path, std::string_view game_name) {
+    const auto tdb = RETypeDB::get();
+
+    if (tdb == nullptr) {
+        spdlog::error("[TDBSnapshot] TDB is not loaded");
+        return false;
+    }
+
+    const auto exe = utility::get_executable();
+    const auto exe_start = (uintptr_t)exe;
+    const auto exe_end = exe_start + utility::get_module_size(exe).value_or(0);
+
+    detail::SnapshotStrings strings{};
+
+    std::vector<format::Type> types(tdb->get_num_types());
+    std::vector<format::Method> methods(tdb->get_num_methods());
+    std::vector<format::Field> fields(tdb->get_num_fields());
+    std::vector<format::Property> properties(tdb->get_num_properties());
+    std::vector<format::Param> params{};
+    std::vector<uint32_t> type_indices{};
+    std::vector<format::NameIndexEntry> type_name_index{};
+    std::vector<format::NameIndexEntry> type_fqn_index{};
+    std::vector<format::NameIndexEntry> method_name_index{};
+    std::vector<format::NameIndexEntry> field_name_index{};
+    std::vector<uint8_t> bytes{};
+
+    const auto first_field = tdb->get_field(0);
+    const auto first_property = tdb->get_property(0);
+
+    for (uint32_t i = 0; i < types.size(); ++i) {
+        const auto t = tdb->get_type(i);
+
+        if (t == nullptr) {
+            continue;
+        }
+
+        auto& out = types[i];
+        const auto full_name = t->get_full_name();
+
+        out.name = strings.add(t->get_name());
+        out.name_space = strings.add(t->get_namespace());
+        out.full_name = strings.add(full_name);
+        out.fqn_hash = t->get_fqn_hash();
+        out.crc_hash = t->get_crc_hash();
+        out.flags = t->get_flags();
+        out.size = t->get_size();
+        out.valuetype_size = t->get_valuetype_size();
+        out.parent = detail::snapshot_index(t->get_parent_type());
+        out.declaring_type = detail::snapshot_index(t->get_declaring_type());
+        out.vm_obj_type = (uint32_t)t->get_vm_obj_type();
+
+        if (t->is_value_type()) out.attributes |= format::TypeAttribute::VALUE_TYPE;
+        if (t->is_enum()) out.attributes |= format::TypeAttribute::ENUM;
+        if (t->is_array()) out.attributes |= format::TypeAttribute::ARRAY;
+        if (t->is_by_ref()) out.attributes |= format::TypeAttribute::BY_REF;
+        if (t->is_pointer()) out.attributes |= format::TypeAttribute::POINTER;
+        if (t->is_primitive()) out.attributes |= format::TypeAttribute::PRIMITIVE;
+        if (t->is_generic_type()) out.attributes |= format::TypeAttribute::GENERIC_TYPE;
+        if (t->is_generic_type_definition()) out.attributes |= format::TypeAttribute::GENERIC_TYPE_DEFINITION;
+
+        if (t->has_fieldptr_offset()) {
+            out.attributes |= format::TypeAttribute::HAS_FIELDPTR_OFFSET;
+            out.fieldptr_offset = t->get_fieldptr_offset();
+        }
+
+        if (t->is_enum()) {
+            out.underlying_type = detail::snapshot_index(t->get_underlying_type());
+        }
+
+        out.generic_type_definition = detail::snapshot_index(t->get_generic_type_definition());
+
+        out.generic_args.start = (uint32_t)type_indices.size();
+
+        for (auto gt : t->get_generic_argument_types()) {
+            type_indices.push_back(detail::snapshot_index(gt));
+        }
+
+        out.generic_args.count = (uint32_t)type_indices.size() - out.generic_args.start;
+
+        type_name_index.push_back({format::hash(full_name), i});
+        type_fqn_index.push_back({out.fqn_hash, i});
+
+        // Members
+        const auto type_methods = t->get_methods();
+
+        out.method_names.start = (uint32_t)method_name_index.size();
+
+        if (type_methods.begin() != nullptr && type_methods.size() > 0) {
+            out.methods = {type_methods.begin()->get_index(), (uint32_t)type_methods.size()};
+
+            for (auto& m : type_methods) {
+                if (const auto name = m.get_name(); name != nullptr) {
+                    method_name_index.push_back({format::hash(name), m.get_index()});
+                }
+            }
+
+            detail::sort_name_index(method_name_index, out.method_names.start);
+        }
+
+        out.method_names.count = (uint32_t)method_name_index.size() - out.method_names.start;
+
+        const auto type_fields = t->get_fields();
+
+        out.field_names.start = (uint32_t)field_name_index.size();
+
+        if (type_fields.size() > 0 && *type_fields.begin() != nullptr) {
+            out.fields = {(uint32_t)(*type_fields.begin() - first_field), (uint32_t)type_fields.size()};
+
+            for (auto f : type_fields) {
+                const auto name = f != nullptr ? f->get_name() : nullptr;
+
+                if (name != nullptr) {
+                    field_name_index.push_back({format::hash(name), (uint32_t)(f - first_field)});
+                }
+            }
+
+            detail::sort_name_index(field_name_index, out.field_names.start);
+        }
+
+        out.field_names.count = (uint32_t)field_name_index.size() - out.field_names.start;
+
+        const auto type_properties = t->get_properties();
+
+        if (type_properties.begin() != nullptr && type_properties.size() > 0) {
+            const auto start = (uint32_t)(type_properties.begin() - first_property);
+
+            out.properties = {start, (uint32_t)type_properties.size()};
+
+            for (auto p = start; p < start + out.properties.count && p < properties.size(); ++p) {
+                properties[p].declaring_type = i;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < methods.size(); ++i) {
+        const auto m = tdb->get_method(i);
+
+        if (m == nullptr) {
+            continue;
+        }
+
+        auto& out = methods[i];
+        const auto function = (uintptr_t)m->get_function();
+
+        out.name = strings.add(m->get_name());
+        out.declaring_type = detail::snapshot_index(m->get_declaring_type());
+        out.return_type = detail::snapshot_index(m->get_return_type());
+        out.flags = m->get_flags();
+        out.impl_flags = m->get_impl_flags();
+        out.vtable_index = m->get_virtual_index();
+        out.invoke_id = m->get_invoke_id();
+        out.attributes = m->is_static() ? format::MemberAttribute::STATIC : 0;
+        out.function_rva = function >= exe_start && function < exe_end ? function - exe_start : 0;
+
+        const auto param_types = m->get_param_types();
+        const auto param_names = m->get_param_names();
+
+        out.params = {(uint32_t)params.size(), (uint32_t)param_types.size()};
+
+        for (size_t p = 0; p < param_types.size(); ++p) {
+            params.push_back({
+                strings.add(p < param_names.size() ? param_names[p] : nullptr),
+                detail::snapshot_index(param_types[p])
+            });
+        }
+    }
+
+    for (uint32_t i = 0; i < fields.size(); ++i) {
+        const auto f = tdb->get_field(i);
+
+        if (f == nullptr) {
+            continue;
+        }
+
+        auto& out = fields[i];
+        const auto field_type = f->get_type();
+
+        out.name = strings.add(f->get_name());
+        out.declaring_type = detail::snapshot_index(f->get_declaring_type());
+        out.type = detail::snapshot_index(field_type);
+        out.flags = f->get_flags();
+        out.offset_from_fieldptr = f->get_offset_from_fieldptr();
+        out.offset_from_base = f->get_offset_from_base();
+
+        if (f->is_static()) out.attributes |= format::MemberAttribute::STATIC;
+        if (f->is_literal()) out.attributes |= format::MemberAttribute::LITERAL;
+
+        if (f->is_literal() && f->get_init_data_index() != 0) {
+            const auto init_data = (const uint8_t*)f->get_init_data();
+            const auto size = init_data != nullptr ? detail::get_init_data_size(field_type, init_data) : 0;
+
+            if (size > 0) {
+                out.init_data = {(uint32_t)bytes.size(), (uint32_t)size};
+                bytes.insert(bytes.end(), init_data, init_data + size);
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < properties.size(); ++i) {
+        const auto& p = *tdb->get_property(i);
+        auto& out = properties[i];
+
+#if TDB_VER >= 69
+        const auto& impl = (*tdb->propertiesImpl)[p.impl_id];
+        out.name = strings.add(tdb->get_string(impl.name_offset));
+#else
+        out.name = strings.add(tdb->get_string(p.name_offset));
+#endif
+
+        out.getter = (uint32_t)p.getter < methods.size() ? (uint32_t)p.getter : format::INVALID_INDEX;
+        out.setter = (uint32_t)p.setter < methods.size() ? (uint32_t)p.setter : format::INVALID_INDEX;
+    }
+
+    const auto by_hash = [](const format::NameIndexEntry& a, const format::NameIndexEntry& b) {
+        return a.hash != b.hash ? a.hash < b.hash : a.index < b.index;
+    };
+
+    std::sort(type_name_index.begin(), type_name_index.end(), by_hash);
+    std::sort(type_fqn_index.begin(), type_fqn_index.end(), by_hash);
+
+    // Lay everything out
+    format::Header header{};
+    header.tdb_version = TDB_VER;
+    game_name.copy(header.game_name, sizeof(header.game_name) - 1);
+
+    std::vector<std::pair<const void*, size_t>> section_data((size_t)format::SectionId::COUNT);
+
+    const auto set_section = [&](format::SectionId id, const auto& data) {
+        section_data[(size_t)id] = {data.data(), data.size() * sizeof(data[0])};
+    };
+
+    set_section(format::SectionId::TYPES, types);
+    set_section(format::SectionId::METHODS, methods);
+    set_section(format::SectionId::FIELDS, fields);
+    set_section(format::SectionId::PROPERTIES, properties);
+    set_section(format::SectionId::PARAMS, params);
+    set_section(format::SectionId::TYPE_INDICES, type_indices);
+    set_section(format::SectionId::TYPE_NAME_INDEX, type_name_index);
+    set_section(format::SectionId::TYPE_FQN_INDEX, type_fqn_index);
+    set_section(format::SectionId::METHOD_NAME_INDEX, method_name_index);
+    set_section(format::SectionId::FIELD_NAME_INDEX, field_name_index);
+    set_section(format::SectionId::STRINGS, strings.pool());
+    set_section(format::SectionId::BYTES, bytes);
+
+    uint64_t offset = sizeof(format::Header);
+
+    for (size_t i = 0; i < section_data.size(); ++i) {
+        offset = (offset + 7) & ~7ull;
+
+        header.sections[i].offset = offset;
+        header.sections[i].size = section_data[i].second;
+
+        offset += section_data[i].second;
+    }
+
+    std::ofstream out{path, std::ios::binary};
+
+    if (!out) {
+        spdlog::error("[TDBSnapshot] Failed to open {} for writing", path.string());
+        return false;
+    }
+
+    out.write((const char*)&header, sizeof(header));
+
+    for (size_t i = 0; i < section_data.size(); ++i) {
+        static constexpr char padding[8]{};
+
+        const auto pos = (uint64_t)out.tellp();
+        out.write(padding, header.sections[i].offset - pos);
+        out.write((const char*)section_data[i].first, section_data[i].second);
+    }
+
+    if (!out) {
+        spdlog::error("[TDBSnapshot] Failed to write {}", path.string());
+        return false;
+    }
+
+    spdlog::info("[TDBSnapshot] Wrote {} types, {} methods, {} fields, {} properties to {}",
+        types.size(), methods.size(), fields.size(), properties.size(), path.string());
+
+    return true;
+}
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+// Writes the currently loaded TDB out in the tdb_snapshot format (see tdb_snapshot/Format.hpp)
+// so it can be inspected, diffed and queried offline with tdb_snapshot::Snapshot.
+namespace sdk {
+bool write_tdb_snapshot(const std::filesystem::path& path, std::string_view game_name);
+}
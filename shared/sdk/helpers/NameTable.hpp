@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace sdk {
+namespace helpers {
+// Open-addressed (linear probing) table of hash -> value.
+// The keys themselves aren't stored, the caller resolves them from the value
+// (e.g. a name that already lives in the TDB string pool), so lookups never allocate.
+template <typename T>
+class NameTable {
+public:
+    static constexpr uint32_t hash(std::string_view str) {
+        uint32_t result = 0x811c9dc5;
+
+        for (const auto c : str) {
+            result ^= (uint8_t)c;
+            result *= 0x01000193;
+        }
+
+        return result;
+    }
+
+    // Keeps the first value inserted for a given key.
+    // is_same(const T& existing) must return true if existing has the same key as value.
+    template <typename Eq>
+    bool insert(uint32_t h, const T& value, Eq&& is_same) {
+        if ((m_count + 1) * 2 > m_slots.size()) {
+            grow();
+        }
+
+        const auto mask = m_slots.size() - 1;
+
+        for (auto i = h & mask; ; i = (i + 1) & mask) {
+            auto& slot = m_slots[i];
+
+            if (!slot.used) {
+                slot.hash = h;
+                slot.value = value;
+                slot.used = true;
+                ++m_count;
+                return true;
+            }
+
+            if (slot.hash == h && is_same(slot.value)) {
+                return false;
+            }
+        }
+    }
+
+    // matches(const T& candidate) must return true if candidate is the value being looked for.
+    template <typename Eq>
+    const T* find(uint32_t h, Eq&& matches) const {
+        if (m_slots.empty()) {
+            return nullptr;
+        }
+
+        const auto mask = m_slots.size() - 1;
+
+        for (auto i = h & mask; ; i = (i + 1) & mask) {
+            const auto& slot = m_slots[i];
+
+            if (!slot.used) {
+                return nullptr;
+            }
+
+            if (slot.hash == h && matches(slot.value)) {
+                return &slot.value;
+            }
+        }
+    }
+
+    size_t size() const {
+        return m_count;
+    }
+
+    bool empty() const {
+        return m_count == 0;
+    }
+
+private:
+    struct Slot {
+        uint32_t hash{0};
+        bool used{false};
+        T value{};
+    };
+
+    void grow() {
+        auto old_slots = std::move(m_slots);
+
+        m_slots.clear();
+        m_slots.resize(old_slots.empty() ? 16 : old_slots.size() * 2);
+
+        const auto mask = m_slots.size() - 1;
+
+        for (const auto& old : old_slots) {
+            if (!old.used) {
+                continue;
+            }
+
+            auto i = old.hash & mask;
+
+            while (m_slots[i].used) {
+                i = (i + 1) & mask;
+            }
+
+            m_slots[i] = old;
+        }
+    }
+
+    std::vector<Slot> m_slots{};
+    size_t m_count{0};
+};
+}
+}
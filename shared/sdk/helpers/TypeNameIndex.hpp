@@ -0,0 +1,186 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "NameTable.hpp"
+
+namespace sdk {
+namespace helpers {
+// Flat open-addressed tables mapping type full names and FQN hashes to type indices.
+// Only deals in indices so it doesn't depend on the game, the type index in RETypeDB.cpp
+// builds it over the live TDB and benchmarks/type_index builds it over a TDB snapshot.
+class TypeNameIndex {
+public:
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+    // get_fqn(uint32_t index) must return the FQN hash of the type at index.
+    template <typename F>
+    void build_fqn(uint32_t num_types, F&& get_fqn) {
+        m_fqn_slots.clear();
+        m_fqn_slots.resize(get_capacity(num_types));
+
+        for (uint32_t i = 0; i < num_types; ++i) {
+            const auto fqn = (uint32_t)get_fqn(i);
+            insert(m_fqn_slots, fqn, mix(fqn), i, [](uint32_t) { return true; });
+        }
+    }
+
+    // names[i] is the full name of the type at index i.
+    template <typename T>
+    void build_names(const T& names) {
+        const auto num_types = (uint32_t)names.size();
+        size_t pool_size = 0;
+
+        for (uint32_t i = 0; i < num_types; ++i) {
+            pool_size += std::string_view{names[i]}.size();
+        }
+
+        // One allocation, so the views handed out by get_name never move
+        m_name_pool.clear();
+        m_name_pool.reserve(pool_size);
+        m_name_offsets.resize(num_types + 1);
+
+        for (uint32_t i = 0; i < num_types; ++i) {
+            m_name_offsets[i] = (uint32_t)m_name_pool.size();
+            m_name_pool += std::string_view{names[i]};
+        }
+
+        m_name_offsets[num_types] = (uint32_t)m_name_pool.size();
+
+        m_name_slots.clear();
+        m_name_slots.resize(get_capacity(num_types));
+
+        for (uint32_t i = 0; i < num_types; ++i) {
+            const auto name = get_name(i);
+            const auto hash = NameTable<uint32_t>::hash(name);
+
+            insert(m_name_slots, hash, hash, i, [&](uint32_t other) { return get_name(other) == name; });
+        }
+
+        m_sorted_by_name.resize(num_types);
+
+        for (uint32_t i = 0; i < num_types; ++i) {
+            m_sorted_by_name[i] = i;
+        }
+
+        std::stable_sort(m_sorted_by_name.begin(), m_sorted_by_name.end(), [&](uint32_t a, uint32_t b) {
+            return get_name(a) < get_name(b);
+        });
+    }
+
+    uint32_t find_by_name(std::string_view name) const {
+        if (m_name_slots.empty()) {
+            return INVALID_INDEX;
+        }
+
+        const auto hash = NameTable<uint32_t>::hash(name);
+        const auto mask = m_name_slots.size() - 1;
+
+        for (auto i = hash & mask; ; i = (i + 1) & mask) {
+            const auto& slot = m_name_slots[i];
+
+            if (slot.index == INVALID_INDEX) {
+                return INVALID_INDEX;
+            }
+
+            if (slot.hash == hash && get_name(slot.index) == name) {
+                return slot.index;
+            }
+        }
+    }
+
+    uint32_t find_by_fqn(uint32_t fqn) const {
+        if (m_fqn_slots.empty()) {
+            return INVALID_INDEX;
+        }
+
+        const auto mask = m_fqn_slots.size() - 1;
+
+        for (auto i = mix(fqn) & mask; ; i = (i + 1) & mask) {
+            const auto& slot = m_fqn_slots[i];
+
+            if (slot.index == INVALID_INDEX) {
+                return INVALID_INDEX;
+            }
+
+            if (slot.hash == fqn) {
+                return slot.index;
+            }
+        }
+    }
+
+    std::string_view get_name(uint32_t index) const {
+        const auto start = m_name_offsets[index];
+        return std::string_view{m_name_pool.data() + start, m_name_offsets[index + 1] - start};
+    }
+
+    uint32_t get_num_names() const {
+        return m_name_offsets.empty() ? 0 : (uint32_t)m_name_offsets.size() - 1;
+    }
+
+    size_t get_name_pool_size() const {
+        return m_name_pool.size();
+    }
+
+    const std::vector<uint32_t>& get_sorted_by_name() const {
+        return m_sorted_by_name;
+    }
+
+private:
+    struct Slot {
+        uint32_t hash{0};
+        uint32_t index{INVALID_INDEX};
+    };
+
+    // FQN hashes are already murmur hashes but scramble them anyways
+    // so a weak low bit distribution doesn't pile everything into one cluster.
+    static uint32_t mix(uint32_t h) {
+        h ^= h >> 16;
+        h *= 0x85ebca6b;
+        h ^= h >> 13;
+        return h;
+    }
+
+    static size_t get_capacity(uint32_t count) {
+        size_t capacity = 16;
+
+        // keep the load factor at or below 50%
+        while (capacity < (size_t)count * 2) {
+            capacity <<= 1;
+        }
+
+        return capacity;
+    }
+
+    // Duplicates keep the lowest type index, which is what the old linear scan returned.
+    template <typename T>
+    static void insert(std::vector<Slot>& slots, uint32_t hash, uint32_t start, uint32_t index, T&& is_same_key) {
+        const auto mask = slots.size() - 1;
+
+        for (auto i = start & mask; ; i = (i + 1) & mask) {
+            auto& slot = slots[i];
+
+            if (slot.index == INVALID_INDEX) {
+                slot.hash = hash;
+                slot.index = index;
+                return;
+            }
+
+            if (slot.hash == hash && is_same_key(slot.index)) {
+                return;
+            }
+        }
+    }
+
+    std::vector<Slot> m_name_slots{};
+    std::vector<Slot> m_fqn_slots{};
+    std::string m_name_pool{};
+    std::vector<uint32_t> m_name_offsets{};
+    std::vector<uint32_t> m_sorted_by_name{};
+};
+}
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// On-disk layout of a TDB snapshot.
+// Written in-game by sdk::write_tdb_snapshot and read by tdb_snapshot::Snapshot without the game.
+// Everything is little endian and naturally aligned so the file can be memory mapped and used in place.
+// Types, methods, fields and properties keep their TDB indices so snapshots of different patches can be diffed.
+namespace tdb_snapshot::format {
+constexpr uint32_t MAGIC = 0x53424454; // "TDBS"
+constexpr uint32_t VERSION = 1;
+constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+// FNV-1a, used for the name indices
+constexpr uint32_t hash(std::string_view str) {
+    uint32_t result = 0x811c9dc5;
+
+    for (const auto c : str) {
+        result ^= (uint8_t)c;
+        result *= 0x01000193;
+    }
+
+    return result;
+}
+
+enum class SectionId : uint32_t {
+    TYPES,              // Type[num types]
+    METHODS,            // Method[num methods]
+    FIELDS,             // Field[num fields]
+    PROPERTIES,         // Property[num properties]
+    PARAMS,             // Param[], referenced by Method::params
+    TYPE_INDICES,       // uint32_t[], referenced by Type::generic_args
+    TYPE_NAME_INDEX,    // NameIndexEntry[] of full name hash -> type, sorted
+    TYPE_FQN_INDEX,     // NameIndexEntry[] of fqn hash -> type, sorted
+    METHOD_NAME_INDEX,  // NameIndexEntry[] of name hash -> method, sorted within each Type::method_names
+    FIELD_NAME_INDEX,   // NameIndexEntry[] of name hash -> field, sorted within each Type::field_names
+    STRINGS,            // null terminated strings, offset 0 is always ""
+    BYTES,              // field init data, referenced by Field::init_data
+    COUNT
+};
+
+struct Section {
+    uint64_t offset{}; // from the start of the file
+    uint64_t size{};   // in bytes
+};
+
+struct Header {
+    uint32_t magic{MAGIC};
+    uint32_t version{VERSION};
+    uint32_t tdb_version{};
+    uint32_t header_size{sizeof(Header)};
+    char game_name[32]{};
+    Section sections[(size_t)SectionId::COUNT]{};
+};
+
+struct Range {
+    uint32_t start{};
+    uint32_t count{};
+};
+
+struct NameIndexEntry {
+    uint32_t hash{};
+    uint32_t index{};
+};
+
+namespace TypeAttribute {
+enum : uint32_t {
+    VALUE_TYPE = 1 << 0,
+    ENUM = 1 << 1,
+    ARRAY = 1 << 2,
+    BY_REF = 1 << 3,
+    POINTER = 1 << 4,
+    PRIMITIVE = 1 << 5,
+    GENERIC_TYPE = 1 << 6,
+    GENERIC_TYPE_DEFINITION = 1 << 7,
+    HAS_FIELDPTR_OFFSET = 1 << 8,
+};
+}
+
+namespace MemberAttribute {
+enum : uint32_t {
+    STATIC = 1 << 0,
+    LITERAL = 1 << 1,
+};
+}
+
+// Strings are offsets into STRINGS, types are TDB type indices (INVALID_INDEX if there's none).
+struct Type {
+    uint32_t name{};
+    uint32_t name_space{};
+    uint32_t full_name{};
+    uint32_t fqn_hash{};
+    uint32_t crc_hash{};
+    uint32_t flags{};
+    uint32_t size{};
+    uint32_t valuetype_size{};
+    uint32_t parent{INVALID_INDEX};
+    uint32_t declaring_type{INVALID_INDEX};
+    uint32_t underlying_type{INVALID_INDEX};
+    uint32_t generic_type_definition{INVALID_INDEX};
+    int32_t fieldptr_offset{};
+    uint32_t attributes{};
+    uint32_t vm_obj_type{};
+    uint32_t reserved{};
+
+    Range methods{};       // TDB method indices
+    Range fields{};        // TDB field indices
+    Range properties{};    // TDB property indices
+    Range method_names{};  // into METHOD_NAME_INDEX
+    Range field_names{};   // into FIELD_NAME_INDEX
+    Range generic_args{};  // into TYPE_INDICES
+};
+
+struct Method {
+    uint32_t name{};
+    uint32_t declaring_type{INVALID_INDEX};
+    uint32_t return_type{INVALID_INDEX};
+    uint16_t flags{};
+    uint16_t impl_flags{};
+    int32_t vtable_index{-1};
+    uint32_t invoke_id{};
+    uint32_t attributes{};
+    uint32_t reserved{};
+    Range params{};         // into PARAMS
+    uint64_t function_rva{}; // relative to the game executable, 0 if outside of it
+};
+
+struct Param {
+    uint32_t name{};
+    uint32_t type{INVALID_INDEX};
+};
+
+struct Field {
+    uint32_t name{};
+    uint32_t declaring_type{INVALID_INDEX};
+    uint32_t type{INVALID_INDEX};
+    uint32_t flags{};
+    uint32_t offset_from_fieldptr{};
+    uint32_t offset_from_base{};
+    uint32_t attributes{};
+    uint32_t reserved{};
+    Range init_data{}; // into BYTES, byte offset and size
+};
+
+struct Property {
+    uint32_t name{};
+    uint32_t declaring_type{INVALID_INDEX};
+    uint32_t getter{INVALID_INDEX}; // TDB method indices
+    uint32_t setter{INVALID_INDEX};
+};
+
+static_assert(sizeof(Header) == 0x30 + sizeof(Section) * (size_t)SectionId::COUNT);
+static_assert(sizeof(Type) == 0x70);
+static_assert(sizeof(Method) == 0x30);
+static_assert(sizeof(Param) == 0x8);
+static_assert(sizeof(Field) == 0x28);
+static_assert(sizeof(Property) == 0x10);
+static_assert(sizeof(NameIndexEntry) == 0x8);
+}
@@ -0,0 +1,594 @@
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Snapshot.hpp"
+
+namespace tdb_snapshot {
+namespace detail {
+std::span<const format::NameIndexEntry> equal_hash_range(std::span<const format::NameIndexEntry> entries, uint32_t h) {
+    const auto [first, last] = std::equal_range(entries.begin(), entries.end(), format::NameIndexEntry{h, 0},
+        [](const format::NameIndexEntry& a, const format::NameIndexEntry& b) {
+            return a.hash < b.hash;
+        });
+
+    return std::span<const format::NameIndexEntry>{first, last};
+}
+}
+
+std::unique_ptr<Snapshot> Snapshot::open(const std::filesystem::path& path) {
+    std::unique_ptr<Snapshot> out{new Snapshot{}};
+
+#ifdef _WIN32
+    const auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+
+    LARGE_INTEGER size{};
+
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)sizeof(format::Header)) {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+
+    if (mapping == nullptr) {
+        return nullptr;
+    }
+
+    // The view keeps the mapping alive
+    const auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+
+    if (view == nullptr) {
+        return nullptr;
+    }
+
+    out->m_data = (const uint8_t*)view;
+    out->m_size = (size_t)size.QuadPart;
+#else
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat st{};
+
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(format::Header)) {
+        close(fd);
+        return nullptr;
+    }
+
+    const auto view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (view == MAP_FAILED) {
+        return nullptr;
+    }
+
+    out->m_data = (const uint8_t*)view;
+    out->m_size = (size_t)st.st_size;
+#endif
+
+    if (!out->validate()) {
+        return nullptr;
+    }
+
+    return out;
+}
+
+Snapshot::~Snapshot() {
+    if (m_data == nullptr) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+#else
+    munmap((void*)m_data, m_size);
+#endif
+}
+
+template <typename T>
+bool Snapshot::map_section(format::SectionId id, std::span<const T>& out) {
+    const auto& section = m_header->sections[(size_t)id];
+
+    if (section.offset > m_size || section.size > m_size - section.offset) {
+        return false;
+    }
+
+    if (section.offset % alignof(T) != 0 || section.size % sizeof(T) != 0) {
+        return false;
+    }
+
+    out = std::span<const T>{(const T*)(m_data + section.offset), (size_t)(section.size / sizeof(T))};
+    return true;
+}
+
+bool Snapshot::validate() {
+    m_header = (const format::Header*)m_data;
+
+    if (m_header->magic != format::MAGIC || m_header->version != format::VERSION || m_header->header_size != sizeof(format::Header)) {
+        return false;
+    }
+
+    using format::SectionId;
+
+    const auto ok = map_section(SectionId::TYPES, m_types)
+        && map_section(SectionId::METHODS, m_methods)
+        && map_section(SectionId::FIELDS, m_fields)
+        && map_section(SectionId::PROPERTIES, m_properties)
+        && map_section(SectionId::PARAMS, m_params)
+        && map_section(SectionId::TYPE_INDICES, m_type_indices)
+        && map_section(SectionId::TYPE_NAME_INDEX, m_type_name_index)
+        && map_section(SectionId::TYPE_FQN_INDEX, m_type_fqn_index)
+        && map_section(SectionId::METHOD_NAME_INDEX, m_method_name_index)
+        && map_section(SectionId::FIELD_NAME_INDEX, m_field_name_index)
+        && map_section(SectionId::STRINGS, m_strings)
+        && map_section(SectionId::BYTES, m_bytes);
+
+    if (!ok) {
+        return false;
+    }
+
+    // get_string relies on every string being terminated within the section
+    return !m_strings.empty() && m_strings.back() == '\0';
+}
+
+std::string_view Snapshot::get_game_name() const {
+    const auto& name = m_header->game_name;
+
+    return std::string_view{name, strnlen(name, sizeof(name))};
+}
+
+format::Range Snapshot::clamp(format::Range range, size_t table_size) {
+    if (range.start >= table_size) {
+        return format::Range{};
+    }
+
+    range.count = (uint32_t)std::min<size_t>(range.count, table_size - range.start);
+    return range;
+}
+
+Type Snapshot::find_type(std::string_view name) const {
+    for (const auto& entry : detail::equal_hash_range(m_type_name_index, format::hash(name))) {
+        if (auto t = get_type(entry.index); t && t.get_full_name() == name) {
+            return t;
+        }
+    }
+
+    return Type{};
+}
+
+Type Snapshot::find_type_by_fqn(uint32_t fqn) const {
+    const auto range = detail::equal_hash_range(m_type_fqn_index, fqn);
+
+    return !range.empty() ? get_type(range.front().index) : Type{};
+}
+
+Type Snapshot::get_type(uint32_t index) const {
+    return index < m_types.size() ? Type{this, index} : Type{};
+}
+
+Method Snapshot::get_method(uint32_t index) const {
+    return index < m_methods.size() ? Method{this, index} : Method{};
+}
+
+Field Snapshot::get_field(uint32_t index) const {
+    return index < m_fields.size() ? Field{this, index} : Field{};
+}
+
+Property Snapshot::get_property(uint32_t index) const {
+    return index < m_properties.size() ? Property{this, index} : Property{};
+}
+
+std::string_view Snapshot::get_string(uint32_t offset) const {
+    if (offset >= m_strings.size()) {
+        return "";
+    }
+
+    return std::string_view{m_strings.data() + offset};
+}
+
+std::span<const uint8_t> Snapshot::get_bytes(format::Range range) const {
+    const auto clamped = clamp(range, m_bytes.size());
+
+    return m_bytes.subspan(clamped.start, clamped.count);
+}
+
+Type::Type(const Snapshot* snapshot, uint32_t index)
+    : m_snapshot{snapshot},
+    m_index{index}
+{
+}
+
+const format::Type& Type::get_raw() const {
+    return m_snapshot->get_raw_types()[m_index];
+}
+
+std::string_view Type::get_namespace() const {
+    return m_snapshot->get_string(get_raw().name_space);
+}
+
+std::string_view Type::get_name() const {
+    return m_snapshot->get_string(get_raw().name);
+}
+
+std::string_view Type::get_full_name() const {
+    return m_snapshot->get_string(get_raw().full_name);
+}
+
+Type Type::get_declaring_type() const {
+    return m_snapshot->get_type(get_raw().declaring_type);
+}
+
+Type Type::get_parent_type() const {
+    return m_snapshot->get_type(get_raw().parent);
+}
+
+Type Type::get_underlying_type() const {
+    return m_snapshot->get_type(get_raw().underlying_type);
+}
+
+Type Type::get_generic_type_definition() const {
+    return m_snapshot->get_type(get_raw().generic_type_definition);
+}
+
+std::vector<Type> Type::get_generic_argument_types() const {
+    const auto indices = m_snapshot->get_raw_type_indices();
+    const auto range = Snapshot::clamp(get_raw().generic_args, indices.size());
+
+    std::vector<Type> out{};
+    out.reserve(range.count);
+
+    // Unresolvable arguments are kept as invalid types so positions still line up
+    for (auto i = range.start; i < range.start + range.count; ++i) {
+        out.push_back(m_snapshot->get_type(indices[i]));
+    }
+
+    return out;
+}
+
+ViewRange<Method> Type::get_methods() const {
+    return ViewRange<Method>{m_snapshot, Snapshot::clamp(get_raw().methods, m_snapshot->get_num_methods())};
+}
+
+ViewRange<Field> Type::get_fields() const {
+    return ViewRange<Field>{m_snapshot, Snapshot::clamp(get_raw().fields, m_snapshot->get_num_fields())};
+}
+
+ViewRange<Property> Type::get_properties() const {
+    return ViewRange<Property>{m_snapshot, Snapshot::clamp(get_raw().properties, m_snapshot->get_num_properties())};
+}
+
+Method Type::get_method(std::string_view name) const {
+    const auto name_index = m_snapshot->get_raw_method_name_index();
+
+    // first pass, do not use function prototypes
+    for (auto super = *this; super; super = super.get_parent_type()) {
+        const auto range = Snapshot::clamp(super.get_raw().method_names, name_index.size());
+
+        for (const auto& entry : detail::equal_hash_range(name_index.subspan(range.start, range.count), format::hash(name))) {
+            if (auto m = m_snapshot->get_method(entry.index); m && m.get_name() == name) {
+                return m;
+            }
+        }
+    }
+
+    const auto paren = name.find('(');
+
+    if (paren == std::string_view::npos) {
+        return Method{};
+    }
+
+    // second pass, match against the function prototype
+    const auto base_name = name.substr(0, paren);
+
+    for (auto super = *this; super; super = super.get_parent_type()) {
+        const auto range = Snapshot::clamp(super.get_raw().method_names, name_index.size());
+
+        for (const auto& entry : detail::equal_hash_range(name_index.subspan(range.start, range.count), format::hash(base_name))) {
+            if (auto m = m_snapshot->get_method(entry.index); m && m.get_name() == base_name && m.get_prototype() == name) {
+                return m;
+            }
+        }
+    }
+
+    return Method{};
+}
+
+std::vector<Method> Type::get_methods(std::string_view name) const {
+    std::vector<Method> out{};
+
+    for (auto super = *this; super; super = super.get_parent_type()) {
+        for (auto m : super.get_methods()) {
+            if (m.get_name() == name) {
+                out.push_back(m);
+            }
+        }
+    }
+
+    return out;
+}
+
+Field Type::get_field(std::string_view name) const {
+    const auto name_index = m_snapshot->get_raw_field_name_index();
+
+    for (auto super = *this; super; super = super.get_parent_type()) {
+        const auto range = Snapshot::clamp(super.get_raw().field_names, name_index.size());
+
+        for (const auto& entry : detail::equal_hash_range(name_index.subspan(range.start, range.count), format::hash(name))) {
+            if (auto f = m_snapshot->get_field(entry.index); f && f.get_name() == name) {
+                return f;
+            }
+        }
+    }
+
+    return Field{};
+}
+
+bool Type::is_a(const Type& other) const {
+    if (!other) {
+        return false;
+    }
+
+    for (auto super = *this; super; super = super.get_parent_type()) {
+        if (super == other) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool Type::is_a(std::string_view other) const {
+    return is_a(m_snapshot->find_type(other));
+}
+
+uint32_t Type::get_vm_obj_type() const {
+    return get_raw().vm_obj_type;
+}
+
+bool Type::is_value_type() const {
+    return (get_raw().attributes & format::TypeAttribute::VALUE_TYPE) != 0;
+}
+
+bool Type::is_enum() const {
+    return (get_raw().attributes & format::TypeAttribute::ENUM) != 0;
+}
+
+bool Type::is_array() const {
+    return (get_raw().attributes & format::TypeAttribute::ARRAY) != 0;
+}
+
+bool Type::is_by_ref() const {
+    return (get_raw().attributes & format::TypeAttribute::BY_REF) != 0;
+}
+
+bool Type::is_pointer() const {
+    return (get_raw().attributes & format::TypeAttribute::POINTER) != 0;
+}
+
+bool Type::is_primitive() const {
+    return (get_raw().attributes & format::TypeAttribute::PRIMITIVE) != 0;
+}
+
+bool Type::is_generic_type_definition() const {
+    return (get_raw().attributes & format::TypeAttribute::GENERIC_TYPE_DEFINITION) != 0;
+}
+
+bool Type::is_generic_type() const {
+    return (get_raw().attributes & format::TypeAttribute::GENERIC_TYPE) != 0;
+}
+
+uint32_t Type::get_crc_hash() const {
+    return get_raw().crc_hash;
+}
+
+uint32_t Type::get_fqn_hash() const {
+    return get_raw().fqn_hash;
+}
+
+uint32_t Type::get_size() const {
+    return get_raw().size;
+}
+
+uint32_t Type::get_valuetype_size() const {
+    return get_raw().valuetype_size;
+}
+
+uint32_t Type::get_flags() const {
+    return get_raw().flags;
+}
+
+int32_t Type::get_fieldptr_offset() const {
+    return get_raw().fieldptr_offset;
+}
+
+bool Type::has_fieldptr_offset() const {
+    return (get_raw().attributes & format::TypeAttribute::HAS_FIELDPTR_OFFSET) != 0;
+}
+
+Method::Method(const Snapshot* snapshot, uint32_t index)
+    : m_snapshot{snapshot},
+    m_index{index}
+{
+}
+
+const format::Method& Method::get_raw() const {
+    return m_snapshot->get_raw_methods()[m_index];
+}
+
+std::string_view Method::get_name() const {
+    return m_snapshot->get_string(get_raw().name);
+}
+
+Type Method::get_declaring_type() const {
+    return m_snapshot->get_type(get_raw().declaring_type);
+}
+
+Type Method::get_return_type() const {
+    return m_snapshot->get_type(get_raw().return_type);
+}
+
+uint64_t Method::get_function_rva() const {
+    return get_raw().function_rva;
+}
+
+int32_t Method::get_virtual_index() const {
+    return get_raw().vtable_index;
+}
+
+uint16_t Method::get_flags() const {
+    return get_raw().flags;
+}
+
+uint16_t Method::get_impl_flags() const {
+    return get_raw().impl_flags;
+}
+
+uint32_t Method::get_invoke_id() const {
+    return get_raw().invoke_id;
+}
+
+bool Method::is_static() const {
+    return (get_raw().attributes & format::MemberAttribute::STATIC) != 0;
+}
+
+uint32_t Method::get_num_params() const {
+    return Snapshot::clamp(get_raw().params, m_snapshot->get_raw_params().size()).count;
+}
+
+std::vector<Type> Method::get_param_types() const {
+    const auto params = m_snapshot->get_raw_params();
+    const auto range = Snapshot::clamp(get_raw().params, params.size());
+
+    std::vector<Type> out{};
+    out.reserve(range.count);
+
+    for (const auto& p : params.subspan(range.start, range.count)) {
+        out.push_back(m_snapshot->get_type(p.type));
+    }
+
+    return out;
+}
+
+std::vector<std::string_view> Method::get_param_names() const {
+    const auto params = m_snapshot->get_raw_params();
+    const auto range = Snapshot::clamp(get_raw().params, params.size());
+
+    std::vector<std::string_view> out{};
+    out.reserve(range.count);
+
+    for (const auto& p : params.subspan(range.start, range.count)) {
+        out.push_back(m_snapshot->get_string(p.name));
+    }
+
+    return out;
+}
+
+std::string Method::get_prototype() const {
+    std::string out{get_name()};
+    out += "(";
+
+    const auto param_types = get_param_types();
+
+    for (size_t i = 0; i < param_types.size(); ++i) {
+        if (i > 0) {
+            out += ", ";
+        }
+
+        if (param_types[i]) {
+            out += param_types[i].get_full_name();
+        }
+    }
+
+    out += ")";
+    return out;
+}
+
+Field::Field(const Snapshot* snapshot, uint32_t index)
+    : m_snapshot{snapshot},
+    m_index{index}
+{
+}
+
+const format::Field& Field::get_raw() const {
+    return m_snapshot->get_raw_fields()[m_index];
+}
+
+std::string_view Field::get_name() const {
+    return m_snapshot->get_string(get_raw().name);
+}
+
+Type Field::get_declaring_type() const {
+    return m_snapshot->get_type(get_raw().declaring_type);
+}
+
+Type Field::get_type() const {
+    return m_snapshot->get_type(get_raw().type);
+}
+
+uint32_t Field::get_flags() const {
+    return get_raw().flags;
+}
+
+uint32_t Field::get_offset_from_fieldptr() const {
+    return get_raw().offset_from_fieldptr;
+}
+
+uint32_t Field::get_offset_from_base() const {
+    return get_raw().offset_from_base;
+}
+
+bool Field::is_static() const {
+    return (get_raw().attributes & format::MemberAttribute::STATIC) != 0;
+}
+
+bool Field::is_literal() const {
+    return (get_raw().attributes & format::MemberAttribute::LITERAL) != 0;
+}
+
+std::span<const uint8_t> Field::get_init_data() const {
+    return m_snapshot->get_bytes(get_raw().init_data);
+}
+
+Property::Property(const Snapshot* snapshot, uint32_t index)
+    : m_snapshot{snapshot},
+    m_index{index}
+{
+}
+
+const format::Property& Property::get_raw() const {
+    return m_snapshot->get_raw_properties()[m_index];
+}
+
+std::string_view Property::get_name() const {
+    return m_snapshot->get_string(get_raw().name);
+}
+
+Type Property::get_declaring_type() const {
+    return m_snapshot->get_type(get_raw().declaring_type);
+}
+
+Method Property::get_getter() const {
+    return m_snapshot->get_method(get_raw().getter);
+}
+
+Method Property::get_setter() const {
+    return m_snapshot->get_method(get_raw().setter);
+}
+}
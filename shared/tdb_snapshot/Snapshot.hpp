@@ -0,0 +1,271 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Format.hpp"
+
+// Standalone reader for TDB snapshots written by sdk::write_tdb_snapshot.
+// Has no dependencies on the game or the rest of REFramework so it can be used from offline tooling.
+// The query surface mirrors sdk::RETypeDefinition/REMethodDefinition/REField, but everything
+// is returned as small views into the mapped file instead of pointers.
+namespace tdb_snapshot {
+class Snapshot;
+class Type;
+class Method;
+class Field;
+class Property;
+
+template <typename T>
+class ViewRange {
+public:
+    class Iterator {
+    public:
+        Iterator(const Snapshot* snapshot, uint32_t index)
+            : m_snapshot{snapshot},
+            m_index{index}
+        {
+        }
+
+        T operator*() const { return T{m_snapshot, m_index}; }
+
+        Iterator& operator++() {
+            ++m_index;
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const Iterator& other) const { return m_index != other.m_index; }
+
+    private:
+        const Snapshot* m_snapshot;
+        uint32_t m_index;
+    };
+
+    ViewRange(const Snapshot* snapshot, format::Range range)
+        : m_snapshot{snapshot},
+        m_range{range}
+    {
+    }
+
+    Iterator begin() const { return Iterator{m_snapshot, m_range.start}; }
+    Iterator end() const { return Iterator{m_snapshot, m_range.start + m_range.count}; }
+    size_t size() const { return m_range.count; }
+    bool empty() const { return m_range.count == 0; }
+
+private:
+    const Snapshot* m_snapshot;
+    format::Range m_range;
+};
+
+class Type {
+public:
+    Type() = default;
+    Type(const Snapshot* snapshot, uint32_t index);
+
+    explicit operator bool() const { return m_snapshot != nullptr; }
+    bool operator==(const Type& other) const { return m_snapshot == other.m_snapshot && m_index == other.m_index; }
+
+    const format::Type& get_raw() const;
+    uint32_t get_index() const { return m_index; }
+
+    std::string_view get_namespace() const;
+    std::string_view get_name() const;
+    std::string_view get_full_name() const;
+
+    Type get_declaring_type() const;
+    Type get_parent_type() const;
+    Type get_underlying_type() const;
+    Type get_generic_type_definition() const;
+    std::vector<Type> get_generic_argument_types() const;
+
+    ViewRange<Method> get_methods() const;
+    ViewRange<Field> get_fields() const;
+    ViewRange<Property> get_properties() const;
+
+    // Same lookup rules as RETypeDefinition: parents are searched too and
+    // methods can be looked up by prototype, e.g. "Foo(System.Int32, System.String)"
+    Method get_method(std::string_view name) const;
+    std::vector<Method> get_methods(std::string_view name) const;
+    Field get_field(std::string_view name) const;
+
+    bool is_a(const Type& other) const;
+    bool is_a(std::string_view other) const;
+
+    uint32_t get_vm_obj_type() const;
+    bool is_value_type() const;
+    bool is_enum() const;
+    bool is_array() const;
+    bool is_by_ref() const;
+    bool is_pointer() const;
+    bool is_primitive() const;
+    bool is_generic_type_definition() const;
+    bool is_generic_type() const;
+
+    uint32_t get_crc_hash() const;
+    uint32_t get_fqn_hash() const;
+    uint32_t get_size() const;
+    uint32_t get_valuetype_size() const;
+    uint32_t get_flags() const;
+    int32_t get_fieldptr_offset() const;
+    bool has_fieldptr_offset() const;
+
+private:
+    const Snapshot* m_snapshot{nullptr};
+    uint32_t m_index{format::INVALID_INDEX};
+};
+
+class Method {
+public:
+    Method() = default;
+    Method(const Snapshot* snapshot, uint32_t index);
+
+    explicit operator bool() const { return m_snapshot != nullptr; }
+    bool operator==(const Method& other) const { return m_snapshot == other.m_snapshot && m_index == other.m_index; }
+
+    const format::Method& get_raw() const;
+    uint32_t get_index() const { return m_index; }
+
+    std::string_view get_name() const;
+    Type get_declaring_type() const;
+    Type get_return_type() const;
+
+    uint64_t get_function_rva() const;
+    int32_t get_virtual_index() const;
+    uint16_t get_flags() const;
+    uint16_t get_impl_flags() const;
+    uint32_t get_invoke_id() const;
+    bool is_static() const;
+
+    uint32_t get_num_params() const;
+    std::vector<Type> get_param_types() const;
+    std::vector<std::string_view> get_param_names() const;
+
+    // "Name(Param.Type, Param.Type)", what RETypeDefinition::get_method matches prototypes against
+    std::string get_prototype() const;
+
+private:
+    const Snapshot* m_snapshot{nullptr};
+    uint32_t m_index{format::INVALID_INDEX};
+};
+
+class Field {
+public:
+    Field() = default;
+    Field(const Snapshot* snapshot, uint32_t index);
+
+    explicit operator bool() const { return m_snapshot != nullptr; }
+    bool operator==(const Field& other) const { return m_snapshot == other.m_snapshot && m_index == other.m_index; }
+
+    const format::Field& get_raw() const;
+    uint32_t get_index() const { return m_index; }
+
+    std::string_view get_name() const;
+    Type get_declaring_type() const;
+    Type get_type() const;
+    uint32_t get_flags() const;
+    uint32_t get_offset_from_fieldptr() const;
+    uint32_t get_offset_from_base() const;
+    bool is_static() const;
+    bool is_literal() const;
+
+    // Raw bytes of a literal's value, empty if it has none
+    std::span<const uint8_t> get_init_data() const;
+
+private:
+    const Snapshot* m_snapshot{nullptr};
+    uint32_t m_index{format::INVALID_INDEX};
+};
+
+class Property {
+public:
+    Property() = default;
+    Property(const Snapshot* snapshot, uint32_t index);
+
+    explicit operator bool() const { return m_snapshot != nullptr; }
+    bool operator==(const Property& other) const { return m_snapshot == other.m_snapshot && m_index == other.m_index; }
+
+    const format::Property& get_raw() const;
+    uint32_t get_index() const { return m_index; }
+
+    std::string_view get_name() const;
+    Type get_declaring_type() const;
+    Method get_getter() const;
+    Method get_setter() const;
+
+private:
+    const Snapshot* m_snapshot{nullptr};
+    uint32_t m_index{format::INVALID_INDEX};
+};
+
+class Snapshot {
+public:
+    // Maps the snapshot at path. Returns nullptr if it can't be opened or fails validation.
+    static std::unique_ptr<Snapshot> open(const std::filesystem::path& path);
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+    ~Snapshot();
+
+    uint32_t get_tdb_version() const { return m_header->tdb_version; }
+    std::string_view get_game_name() const;
+
+    uint32_t get_num_types() const { return (uint32_t)m_types.size(); }
+    uint32_t get_num_methods() const { return (uint32_t)m_methods.size(); }
+    uint32_t get_num_fields() const { return (uint32_t)m_fields.size(); }
+    uint32_t get_num_properties() const { return (uint32_t)m_properties.size(); }
+
+    Type find_type(std::string_view name) const;
+    Type find_type_by_fqn(uint32_t fqn) const;
+    Type get_type(uint32_t index) const;
+    Method get_method(uint32_t index) const;
+    Field get_field(uint32_t index) const;
+    Property get_property(uint32_t index) const;
+
+    // Out of range offsets/ranges come back empty rather than pointing outside of the file
+    std::string_view get_string(uint32_t offset) const;
+    std::span<const uint8_t> get_bytes(format::Range range) const;
+
+    std::span<const format::Type> get_raw_types() const { return m_types; }
+    std::span<const format::Method> get_raw_methods() const { return m_methods; }
+    std::span<const format::Field> get_raw_fields() const { return m_fields; }
+    std::span<const format::Property> get_raw_properties() const { return m_properties; }
+    std::span<const format::Param> get_raw_params() const { return m_params; }
+    std::span<const uint32_t> get_raw_type_indices() const { return m_type_indices; }
+    std::span<const format::NameIndexEntry> get_raw_method_name_index() const { return m_method_name_index; }
+    std::span<const format::NameIndexEntry> get_raw_field_name_index() const { return m_field_name_index; }
+
+    // Clamps range to the size of a table so it can be iterated safely
+    static format::Range clamp(format::Range range, size_t table_size);
+
+private:
+    Snapshot() = default;
+
+    bool validate();
+
+    template <typename T>
+    bool map_section(format::SectionId id, std::span<const T>& out);
+
+    const uint8_t* m_data{nullptr};
+    size_t m_size{0};
+
+    const format::Header* m_header{nullptr};
+    std::span<const format::Type> m_types{};
+    std::span<const format::Method> m_methods{};
+    std::span<const format::Field> m_fields{};
+    std::span<const format::Property> m_properties{};
+    std::span<const format::Param> m_params{};
+    std::span<const uint32_t> m_type_indices{};
+    std::span<const format::NameIndexEntry> m_type_name_index{};
+    std::span<const format::NameIndexEntry> m_type_fqn_index{};
+    std::span<const format::NameIndexEntry> m_method_name_index{};
+    std::span<const format::NameIndexEntry> m_field_name_index{};
+    std::span<const char> m_strings{};
+    std::span<const uint8_t> m_bytes{};
+};
+}
@@ -1,3 +1,6 @@
+#include <mutex>
+#include <vector>
+
 #include <spdlog/spdlog.h>
 #include <MinHook.h>
 
@@ -8,6 +11,69 @@ using namespace std;
 
 bool g_isMinHookInitialized{ false };
 
+namespace {
+// MinHook's queue flags are global, so only one thread can be batching at a time.
+std::mutex g_batch_mutex{};
+
+struct PendingBatch {
+    std::unique_lock<std::mutex> lock{};
+    uint32_t depth{0};
+    std::vector<uintptr_t> enabled{};
+    std::vector<uintptr_t> removed{};
+};
+
+thread_local PendingBatch t_batch{};
+}
+
+FunctionHook::Batch::Batch() {
+    if (t_batch.depth++ == 0) {
+        t_batch.lock = std::unique_lock{g_batch_mutex};
+        m_outermost = true;
+    }
+}
+
+FunctionHook::Batch::~Batch() {
+    commit();
+}
+
+bool FunctionHook::Batch::commit() {
+    if (m_committed) {
+        return true;
+    }
+
+    m_committed = true;
+
+    if (--t_batch.depth > 0 || !m_outermost) {
+        return true;
+    }
+
+    auto result = true;
+
+    if (!t_batch.enabled.empty() || !t_batch.removed.empty()) {
+        if (auto status = MH_ApplyQueued(); status != MH_OK) {
+            spdlog::error("[FunctionHook] Failed to apply {} queued hooks: {}", t_batch.enabled.size() + t_batch.removed.size(), MH_StatusToString(status));
+            result = false;
+        } else {
+            spdlog::info("[FunctionHook] Applied {} hooks and {} removals in one batch", t_batch.enabled.size(), t_batch.removed.size());
+        }
+
+        // Already disabled by the apply above, so this doesn't freeze threads again.
+        for (auto target : t_batch.removed) {
+            MH_RemoveHook((LPVOID)target);
+        }
+    }
+
+    t_batch.enabled.clear();
+    t_batch.removed.clear();
+    t_batch.lock.unlock();
+
+    return result;
+}
+
+bool FunctionHook::Batch::is_active() {
+    return t_batch.depth > 0;
+}
+
 FunctionHook::FunctionHook(Address target, Address destination)
     : m_target{ 0 },
     m_destination{ 0 },
@@ -42,16 +108,26 @@ bool FunctionHook::create() {
         return false;
     }
 
-    if (auto status = MH_EnableHook((LPVOID)m_target); status != MH_OK) {
+    const auto batched = Batch::is_active();
+    const auto status = batched ? MH_QueueEnableHook((LPVOID)m_target) : MH_EnableHook((LPVOID)m_target);
+
+    if (status != MH_OK) {
+        spdlog::error("Failed to hook {:x}: {}", m_target, MH_StatusToString(status));
+
         m_original = 0;
         m_destination = 0;
         m_target = 0;
 
-        spdlog::error("Failed to hook {:x}: {}", m_target, MH_StatusToString(status));
         return false;
     }
 
-    spdlog::info("Hooked {:x}->{:x}", m_target, m_destination);
+    if (batched) {
+        t_batch.enabled.push_back(m_target);
+        spdlog::info("Queued hook {:x}->{:x}", m_target, m_destination);
+    } else {
+        spdlog::info("Hooked {:x}->{:x}", m_target, m_destination);
+    }
+
     return true;
 }
 
@@ -61,6 +137,21 @@ bool FunctionHook::remove() {
         return true;
     }
 
+    // Removed once the batch has disabled it.
+    if (Batch::is_active()) {
+        if (MH_QueueDisableHook((LPVOID)m_target) != MH_OK) {
+            return false;
+        }
+
+        t_batch.removed.push_back(m_target);
+
+        m_target = 0;
+        m_destination = 0;
+        m_original = 0;
+
+        return true;
+    }
+
     // Disable then remove the hook.
     if (MH_DisableHook((LPVOID)m_target) != MH_OK ||
         MH_RemoveHook((LPVOID)m_target) != MH_OK) {
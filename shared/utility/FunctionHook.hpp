@@ -7,6 +7,30 @@
 
 class FunctionHook {
 public:
+    // While a Batch is alive, create() and remove() on the same thread only queue their change.
+    // Everything is applied by commit() (or the destructor) with a single MH_ApplyQueued,
+    // so the game's threads get frozen once instead of once per hook.
+    // Queued hooks aren't live until then. Batches nest, only the outermost one applies.
+    class Batch {
+    public:
+        Batch();
+        virtual ~Batch();
+
+        Batch(const Batch& other) = delete;
+        Batch(Batch&& other) = delete;
+        Batch& operator=(const Batch& other) = delete;
+        Batch& operator=(Batch&& other) = delete;
+
+        // Returns false if the queued hooks couldn't be applied.
+        bool commit();
+
+        static bool is_active();
+
+    private:
+        bool m_outermost{false};
+        bool m_committed{false};
+    };
+
     FunctionHook() = delete;
     FunctionHook(const FunctionHook& other) = delete;
     FunctionHook(FunctionHook&& other) = delete;
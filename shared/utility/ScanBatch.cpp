@@ -0,0 +1,646 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+#include <emmintrin.h>
+
+#include <spdlog/spdlog.h>
+#include <utility/Module.hpp>
+
+#include "ScanBatch.hpp"
+
+namespace utility {
+namespace detail {
+constexpr size_t SCAN_CHUNK_SIZE = 1 << 20;
+
+// Bytes that show up everywhere in x64 code, anchoring on them would make the filter useless
+constexpr std::array<uint8_t, 12> common_bytes{0x00, 0xFF, 0xCC, 0x48, 0x8B, 0x89, 0xE8, 0x0F, 0x4C, 0x8D, 0x24, 0x44};
+
+uint32_t anchor_penalty(uint8_t b) {
+    return std::find(common_bytes.begin(), common_bytes.end(), b) != common_bytes.end() ? 1 : 0;
+}
+
+uint64_t fnv1a64(const void* data, size_t size, uint64_t result = 0xcbf29ce484222325) {
+    for (size_t i = 0; i < size; ++i) {
+        result ^= ((const uint8_t*)data)[i];
+        result *= 0x100000001b3;
+    }
+
+    return result;
+}
+
+std::vector<std::pair<uintptr_t, uintptr_t>> get_readable_sections(HMODULE module) {
+    std::vector<std::pair<uintptr_t, uintptr_t>> out{};
+
+    const auto base = (uintptr_t)module;
+    const auto dos = (PIMAGE_DOS_HEADER)module;
+
+    if (module == nullptr || dos->e_magic != IMAGE_DOS_SIGNATURE) {
+        return out;
+    }
+
+    const auto nt = (PIMAGE_NT_HEADERS)(base + dos->e_lfanew);
+
+    if (nt->Signature != IMAGE_NT_SIGNATURE) {
+        return out;
+    }
+
+    auto section = IMAGE_FIRST_SECTION(nt);
+
+    for (auto i = 0; i < nt->FileHeader.NumberOfSections; ++i, ++section) {
+        if ((section->Characteristics & IMAGE_SCN_MEM_READ) == 0 || section->Misc.VirtualSize == 0) {
+            continue;
+        }
+
+        const auto start = base + section->VirtualAddress;
+        out.emplace_back(start, start + section->Misc.VirtualSize);
+    }
+
+    return out;
+}
+
+// Identifies a build of the executable without reading all of it.
+// The headers carry the link timestamp, checksum and section layout, the file attributes catch everything else.
+uint64_t get_image_key(HMODULE module) {
+    const auto dos = (PIMAGE_DOS_HEADER)module;
+    const auto nt = (PIMAGE_NT_HEADERS)((uintptr_t)module + dos->e_lfanew);
+
+    auto result = fnv1a64(module, nt->OptionalHeader.SizeOfHeaders);
+
+    wchar_t module_path[MAX_PATH]{};
+
+    if (GetModuleFileNameW(module, module_path, MAX_PATH) != 0) {
+        std::error_code ec{};
+        const auto file_size = std::filesystem::file_size(module_path, ec);
+        const auto write_time = std::filesystem::last_write_time(module_path, ec).time_since_epoch().count();
+
+        result = fnv1a64(&file_size, sizeof(file_size), result);
+        result = fnv1a64(&write_time, sizeof(write_time), result);
+    }
+
+    return result;
+}
+}
+
+ScanBatch::Id ScanBatch::add(std::string_view pattern, bool find_all) {
+    auto compiled = compile(pattern);
+
+    if (!compiled) {
+        spdlog::error("[ScanBatch] Invalid pattern: {}", pattern);
+        compiled = Pattern{};
+    }
+
+    compiled->source = pattern;
+    compiled->find_all = find_all;
+
+    m_patterns.push_back(std::move(*compiled));
+    return m_patterns.size() - 1;
+}
+
+std::optional<ScanBatch::Pattern> ScanBatch::compile(std::string_view pattern) {
+    Pattern out{};
+
+    std::istringstream stream{std::string{pattern}};
+    std::string token{};
+
+    while (stream >> token) {
+        if (token == "?" || token == "??") {
+            out.bytes.push_back(0);
+            out.mask.push_back(0);
+            continue;
+        }
+
+        if (token.size() > 2 || !std::all_of(token.begin(), token.end(), [](char c) { return std::isxdigit((unsigned char)c) != 0; })) {
+            return std::nullopt;
+        }
+
+        out.bytes.push_back((uint8_t)std::stoul(token, nullptr, 16));
+        out.mask.push_back(0xFF);
+    }
+
+    out.length = out.bytes.size();
+
+    if (out.length == 0 || std::find(out.mask.begin(), out.mask.end(), 0xFF) == out.mask.end()) {
+        return std::nullopt;
+    }
+
+    // Prefer two consecutive known bytes that aren't everywhere in code
+    std::optional<size_t> best_pair{};
+    uint32_t best_penalty = ~0u;
+
+    for (size_t i = 0; i + 1 < out.length; ++i) {
+        if (out.mask[i] == 0 || out.mask[i + 1] == 0) {
+            continue;
+        }
+
+        const auto penalty = detail::anchor_penalty(out.bytes[i]) + detail::anchor_penalty(out.bytes[i + 1]);
+
+        if (penalty < best_penalty) {
+            best_pair = i;
+            best_penalty = penalty;
+        }
+    }
+
+    if (best_pair) {
+        out.anchor = *best_pair;
+        out.anchor_is_pair = true;
+    } else {
+        out.anchor = std::find(out.mask.begin(), out.mask.end(), 0xFF) - out.mask.begin();
+        out.anchor_is_pair = false;
+    }
+
+    const auto padded = (out.length + 15) & ~(size_t)15;
+    out.bytes.resize(padded, 0);
+    out.mask.resize(padded, 0);
+
+    return out;
+}
+
+bool ScanBatch::matches(const uint8_t* data, const Pattern& p, const uint8_t* end) {
+    if (data + p.bytes.size() <= end) {
+        for (size_t i = 0; i < p.bytes.size(); i += 16) {
+            const auto v = _mm_loadu_si128((const __m128i*)(data + i));
+            const auto m = _mm_loadu_si128((const __m128i*)(p.mask.data() + i));
+            const auto b = _mm_loadu_si128((const __m128i*)(p.bytes.data() + i));
+
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(v, m), b)) != 0xFFFF) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Near the end of a section, don't read past it
+    for (size_t i = 0; i < p.length; ++i) {
+        if ((data[i] & p.mask[i]) != p.bytes[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ScanBatch::matches(uintptr_t address, std::string_view pattern) {
+    const auto compiled = compile(pattern);
+
+    if (!compiled) {
+        return false;
+    }
+
+    return matches((const uint8_t*)address, *compiled, (const uint8_t*)address + compiled->length);
+}
+
+size_t ScanBatch::length(std::string_view pattern) {
+    const auto compiled = compile(pattern);
+
+    return compiled ? compiled->length : 0;
+}
+
+void ScanBatch::run(HMODULE module) {
+    scan_ranges(detail::get_readable_sections(module));
+}
+
+void ScanBatch::run(uintptr_t start, size_t size) {
+    scan_ranges({{start, start + size}});
+}
+
+void ScanBatch::scan_ranges(const std::vector<std::pair<uintptr_t, uintptr_t>>& unsorted_ranges) {
+    for (auto& p : m_patterns) {
+        p.results.clear();
+    }
+
+    auto ranges = unsorted_ranges;
+    std::sort(ranges.begin(), ranges.end());
+
+    // Candidate filter, keyed by the little endian u16 at each position.
+    // Patterns without a known byte pair are put in every bucket that starts with their anchor byte.
+    std::vector<uint32_t> bucket_start(0x10000 + 1, 0);
+    std::vector<uint32_t> bucket_items{};
+    std::vector<uint64_t> filter(0x10000 / 64, 0);
+    std::vector<uint32_t> single_byte_patterns{};
+
+    const auto for_each_key = [&](const Pattern& p, auto&& fn) {
+        if (p.length == 0) {
+            return;
+        }
+
+        if (p.anchor_is_pair) {
+            fn((uint16_t)(p.bytes[p.anchor] | (p.bytes[p.anchor + 1] << 8)));
+        } else {
+            for (uint32_t x = 0; x < 0x100; ++x) {
+                fn((uint16_t)(p.bytes[p.anchor] | (x << 8)));
+            }
+        }
+    };
+
+    for (uint32_t i = 0; i < m_patterns.size(); ++i) {
+        for_each_key(m_patterns[i], [&](uint16_t key) { ++bucket_start[key + 1]; });
+
+        if (m_patterns[i].length > 0 && !m_patterns[i].anchor_is_pair) {
+            single_byte_patterns.push_back(i);
+        }
+    }
+
+    for (size_t i = 1; i < bucket_start.size(); ++i) {
+        bucket_start[i] += bucket_start[i - 1];
+    }
+
+    bucket_items.resize(bucket_start.back());
+    auto fill = bucket_start;
+
+    for (uint32_t i = 0; i < m_patterns.size(); ++i) {
+        for_each_key(m_patterns[i], [&](uint16_t key) {
+            bucket_items[fill[key]++] = i;
+            filter[key / 64] |= 1ull << (key % 64);
+        });
+    }
+
+    struct Chunk {
+        uintptr_t start;
+        uintptr_t end;
+        uintptr_t section_start;
+        uintptr_t section_end;
+        std::vector<std::pair<uint32_t, uintptr_t>> results{};
+    };
+
+    std::vector<Chunk> chunks{};
+
+    for (const auto& [start, end] : ranges) {
+        for (auto chunk = start; chunk < end; chunk += detail::SCAN_CHUNK_SIZE) {
+            chunks.push_back({chunk, std::min(chunk + detail::SCAN_CHUNK_SIZE, end), start, end});
+        }
+    }
+
+    const auto scan_chunk = [&](Chunk& chunk) {
+        std::vector<uint8_t> found(m_patterns.size(), 0);
+        const auto section_start = (const uint8_t*)chunk.section_start;
+        const auto section_end = (const uint8_t*)chunk.section_end;
+
+        const auto check = [&](const uint8_t* pos, uint32_t index) {
+            const auto& p = m_patterns[index];
+
+            if (found[index] && !p.find_all) {
+                return;
+            }
+
+            if ((size_t)(pos - section_start) < p.anchor) {
+                return;
+            }
+
+            const auto candidate = pos - p.anchor;
+
+            if ((size_t)(section_end - candidate) < p.length || !matches(candidate, p, section_end)) {
+                return;
+            }
+
+            found[index] = 1;
+            chunk.results.emplace_back(index, (uintptr_t)candidate);
+        };
+
+        const auto end = std::min((const uint8_t*)chunk.end, section_end - 1);
+
+        for (auto pos = (const uint8_t*)chunk.start; pos < end; ++pos) {
+            const auto key = *(const uint16_t*)pos;
+
+            if ((filter[key / 64] & (1ull << (key % 64))) == 0) {
+                continue;
+            }
+
+            for (auto i = bucket_start[key]; i < bucket_start[key + 1]; ++i) {
+                check(pos, bucket_items[i]);
+            }
+        }
+
+        // The last byte of a section has no u16 to look up
+        if ((const uint8_t*)chunk.end == section_end) {
+            for (const auto index : single_byte_patterns) {
+                if (section_end[-1] == m_patterns[index].bytes[m_patterns[index].anchor]) {
+                    check(section_end - 1, index);
+                }
+            }
+        }
+    };
+
+    std::atomic<size_t> next_chunk{0};
+    const auto worker = [&]() {
+        for (auto i = next_chunk++; i < chunks.size(); i = next_chunk++) {
+            scan_chunk(chunks[i]);
+        }
+    };
+
+    const auto num_threads = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), chunks.size());
+    std::vector<std::thread> threads{};
+
+    for (size_t i = 1; i < num_threads; ++i) {
+        threads.emplace_back(worker);
+    }
+
+    worker();
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // Chunks are in address order and results within a chunk are in address order per pattern
+    for (const auto& chunk : chunks) {
+        for (const auto& [index, address] : chunk.results) {
+            auto& p = m_patterns[index];
+
+            if (p.find_all || p.results.empty()) {
+                p.results.push_back(address);
+            }
+        }
+    }
+}
+
+std::optional<uintptr_t> ScanBatch::get(Id id) const {
+    if (id >= m_patterns.size() || m_patterns[id].results.empty()) {
+        return std::nullopt;
+    }
+
+    return m_patterns[id].results.front();
+}
+
+const std::vector<uintptr_t>& ScanBatch::get_all(Id id) const {
+    static const std::vector<uintptr_t> empty{};
+
+    if (id >= m_patterns.size()) {
+        return empty;
+    }
+
+    return m_patterns[id].results;
+}
+
+namespace detail {
+struct ScanCache {
+    struct Entry {
+        bool find_all{};
+        std::vector<uintptr_t> rvas{};
+    };
+
+    std::mutex mtx{};
+    HMODULE module{};
+    size_t image_size{};
+    std::filesystem::path path{};
+    uint64_t key{};
+    bool dirty{};
+
+    // Keyed by pattern, with a prefix for the lookup mode
+    std::unordered_map<std::string, Entry> entries{};
+};
+
+ScanCache& get_scan_cache() {
+    static ScanCache cache{};
+    return cache;
+}
+
+std::string make_cache_key(std::string_view pattern, bool find_all) {
+    return std::string{find_all ? "all " : "one "}.append(pattern);
+}
+
+// Keyed like the cache. Filled during static initialization, read once by load_scan_cache.
+std::set<std::string>& get_registered_scans() {
+    static std::set<std::string> scans{};
+    return scans;
+}
+
+std::vector<uintptr_t> scan_cached(HMODULE module, std::string_view pattern, bool find_all) {
+    auto& cache = get_scan_cache();
+    const auto base = (uintptr_t)module;
+    const auto cache_key = make_cache_key(pattern, find_all);
+
+    {
+        std::scoped_lock _{cache.mtx};
+
+        if (module == cache.module) {
+            if (auto it = cache.entries.find(cache_key); it != cache.entries.end()) {
+                const auto& rvas = it->second.rvas;
+                const auto pattern_length = ScanBatch::length(pattern);
+
+                // Entries only exist for scans made after load_scan_cache, which waits for the image to be unpacked,
+                // and the key covers the executable, so an empty entry is a confirmed miss.
+                // RVAs from the file are checked against the image before reading.
+                const auto still_valid = pattern_length > 0 && std::all_of(rvas.begin(), rvas.end(), [&](uintptr_t rva) {
+                    return rva <= cache.image_size && pattern_length <= cache.image_size - rva && ScanBatch::matches(base + rva, pattern);
+                });
+
+                if (still_valid) {
+                    std::vector<uintptr_t> out{};
+
+                    for (const auto rva : rvas) {
+                        out.push_back(base + rva);
+                    }
+
+                    return out;
+                }
+
+                spdlog::warn("[ScanBatch] Stale cache entry for {}", pattern);
+            }
+        }
+    }
+
+    ScanBatch batch{};
+    const auto id = batch.add(pattern, find_all);
+    batch.run(module);
+
+    const auto& results = batch.get_all(id);
+
+    std::scoped_lock _{cache.mtx};
+
+    if (module == cache.module) {
+        auto& entry = cache.entries[cache_key];
+        entry.find_all = find_all;
+        entry.rvas.clear();
+
+        for (const auto address : results) {
+            entry.rvas.push_back(address - base);
+        }
+
+        cache.dirty = true;
+    }
+
+    return results;
+}
+}
+
+void load_scan_cache(HMODULE module, const std::filesystem::path& path) {
+    auto& cache = detail::get_scan_cache();
+    std::scoped_lock _{cache.mtx};
+
+    cache.module = module;
+    cache.image_size = utility::get_module_size(module).value_or(0);
+    cache.path = path;
+    cache.key = detail::get_image_key(module);
+    cache.entries.clear();
+    cache.dirty = false;
+
+    std::ifstream in{path};
+
+    if (!in) {
+        spdlog::info("[ScanBatch] No scan cache at {}", path.string());
+        return;
+    }
+
+    std::string line{};
+    std::getline(in, line);
+
+    const auto key_matches = line == fmt::format("{:x}", cache.key);
+
+    // Lines are "<one|all>\t<rva,rva,...|->\t<pattern>"
+    while (std::getline(in, line)) {
+        const auto first_tab = line.find('\t');
+        const auto second_tab = first_tab != std::string::npos ? line.find('\t', first_tab + 1) : std::string::npos;
+
+        if (second_tab == std::string::npos) {
+            continue;
+        }
+
+        const auto mode = line.substr(0, first_tab);
+        const auto rvas = line.substr(first_tab + 1, second_tab - first_tab - 1);
+        const auto pattern = line.substr(second_tab + 1);
+
+        detail::ScanCache::Entry entry{};
+        entry.find_all = mode == "all";
+
+        if (rvas != "-") {
+            std::istringstream rva_stream{rvas};
+            std::string rva{};
+            bool valid = true;
+
+            while (valid && std::getline(rva_stream, rva, ',')) {
+                uint64_t value{};
+                const auto [end, ec] = std::from_chars(rva.data(), rva.data() + rva.size(), value, 16);
+
+                valid = ec == std::errc{} && end == rva.data() + rva.size();
+                entry.rvas.push_back((uintptr_t)value);
+            }
+
+            // Corrupt or hand edited line, it'll just be scanned again when asked for
+            if (!valid) {
+                spdlog::warn("[ScanBatch] Ignoring malformed cache line for {}", pattern);
+                continue;
+            }
+        }
+
+        cache.entries[detail::make_cache_key(pattern, entry.find_all)] = std::move(entry);
+    }
+
+    // The game was updated, everything we looked for last time has to be found again
+    if (!key_matches) {
+        spdlog::info("[ScanBatch] Executable changed, rescanning {} patterns", cache.entries.size());
+    } else {
+        spdlog::info("[ScanBatch] Loaded {} cached scans", cache.entries.size());
+    }
+
+    std::vector<std::string> to_scan{};
+
+    if (!key_matches) {
+        for (const auto& [cache_key, entry] : cache.entries) {
+            to_scan.push_back(cache_key);
+        }
+    }
+
+    // Signatures initialization is going to ask for that weren't scanned last time (e.g. on the first launch)
+    for (const auto& cache_key : detail::get_registered_scans()) {
+        if (!cache.entries.contains(cache_key)) {
+            cache.entries[cache_key].find_all = cache_key.starts_with("all ");
+            to_scan.push_back(cache_key);
+        }
+    }
+
+    if (to_scan.empty()) {
+        return;
+    }
+
+    const auto start_time = std::chrono::high_resolution_clock::now();
+
+    ScanBatch batch{};
+    std::vector<std::pair<std::string, ScanBatch::Id>> ids{};
+
+    for (const auto& cache_key : to_scan) {
+        ids.emplace_back(cache_key, batch.add(std::string_view{cache_key}.substr(4), cache.entries[cache_key].find_all));
+    }
+
+    batch.run(module);
+
+    for (const auto& [cache_key, id] : ids) {
+        auto& entry = cache.entries[cache_key];
+        entry.rvas.clear();
+
+        for (const auto address : batch.get_all(id)) {
+            entry.rvas.push_back(address - (uintptr_t)module);
+        }
+    }
+
+    cache.dirty = true;
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start_time);
+    spdlog::info("[ScanBatch] Rescanned {} patterns in {}ms", ids.size(), elapsed.count());
+}
+
+void save_scan_cache() {
+    auto& cache = detail::get_scan_cache();
+    std::scoped_lock _{cache.mtx};
+
+    if (!cache.dirty || cache.path.empty()) {
+        return;
+    }
+
+    std::ofstream out{cache.path};
+
+    if (!out) {
+        spdlog::error("[ScanBatch] Failed to write scan cache to {}", cache.path.string());
+        return;
+    }
+
+    out << fmt::format("{:x}", cache.key) << '\n';
+
+    for (const auto& [cache_key, entry] : cache.entries) {
+        std::string rvas{};
+
+        for (const auto rva : entry.rvas) {
+            if (!rvas.empty()) {
+                rvas += ',';
+            }
+
+            rvas += fmt::format("{:x}", rva);
+        }
+
+        out << (entry.find_all ? "all" : "one") << '\t' << (rvas.empty() ? "-" : rvas) << '\t' << std::string_view{cache_key}.substr(4) << '\n';
+    }
+
+    cache.dirty = false;
+    spdlog::info("[ScanBatch] Saved {} scans to {}", cache.entries.size(), cache.path.string());
+}
+
+CachedScan::CachedScan(const char* pattern, bool find_all)
+    : m_pattern{pattern},
+    m_find_all{find_all}
+{
+    detail::get_registered_scans().insert(detail::make_cache_key(pattern, find_all));
+}
+
+std::optional<uintptr_t> scan_cached(HMODULE module, std::string_view pattern) {
+    const auto results = detail::scan_cached(module, pattern, false);
+
+    if (results.empty()) {
+        return std::nullopt;
+    }
+
+    return results.front();
+}
+
+std::vector<uintptr_t> scan_all_cached(HMODULE module, std::string_view pattern) {
+    return detail::scan_cached(module, pattern, true);
+}
+}
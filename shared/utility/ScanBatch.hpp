@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Windows.h>
+
+namespace utility {
+// Finds any number of signatures in a module with a single pass over its readable sections.
+// Candidates are filtered through a table keyed by two known bytes of each pattern,
+// then verified 16 bytes at a time. Sections are split into chunks and scanned in parallel.
+// Patterns use the same syntax as utility::scan, e.g. "48 8B 05 ? ? ? ?".
+class ScanBatch {
+public:
+    using Id = size_t;
+
+    // find_all = false only keeps the lowest address, like utility::scan
+    // find_all = true keeps every match in ascending order, like calling utility::scan(*ref + 1, ...) in a loop
+    Id add(std::string_view pattern, bool find_all = false);
+
+    void run(HMODULE module);
+    void run(uintptr_t start, size_t size);
+
+    std::optional<uintptr_t> get(Id id) const;
+    const std::vector<uintptr_t>& get_all(Id id) const;
+
+    size_t size() const { return m_patterns.size(); }
+    bool empty() const { return m_patterns.empty(); }
+
+    // Matches the pattern against memory at address, doesn't check that address is readable
+    static bool matches(uintptr_t address, std::string_view pattern);
+
+    // Number of bytes the pattern covers, 0 if it's invalid
+    static size_t length(std::string_view pattern);
+
+private:
+    struct Pattern {
+        std::string source{};
+        std::vector<uint8_t> bytes{}; // padded to a multiple of 16
+        std::vector<uint8_t> mask{};  // 0xFF = known, 0x00 = wildcard
+        size_t length{};
+        size_t anchor{};              // offset of the two bytes used for candidate filtering
+        bool anchor_is_pair{};
+        bool find_all{};
+        std::vector<uintptr_t> results{};
+    };
+
+    static std::optional<Pattern> compile(std::string_view pattern);
+    static bool matches(const uint8_t* data, const Pattern& p, const uint8_t* end);
+
+    void scan_ranges(const std::vector<std::pair<uintptr_t, uintptr_t>>& ranges);
+
+    std::vector<Pattern> m_patterns{};
+};
+
+// A signature scan_cached is going to be asked for during initialization.
+// Defining one at namespace scope registers it, so load_scan_cache can find every registered signature
+// in the same pass instead of scan_cached going over the module once per signature on a cold start.
+// The pattern isn't copied, so it should be a string literal.
+class CachedScan {
+public:
+    CachedScan(const char* pattern, bool find_all = false);
+
+    std::string_view pattern() const { return m_pattern; }
+    bool find_all() const { return m_find_all; }
+
+    operator std::string_view() const { return m_pattern; }
+
+private:
+    std::string_view m_pattern{};
+    bool m_find_all{};
+};
+
+// Module wide scans of the game executable that are remembered across launches, including the ones that found nothing.
+// Results are keyed by a hash of the executable's image, size and write time, so a game update invalidates them.
+// When the key doesn't match, every pattern from the previous cache is rescanned along with the registered
+// CachedScans in one ScanBatch pass before anything asks for them. Other modules fall back to an uncached ScanBatch.
+void load_scan_cache(HMODULE module, const std::filesystem::path& path);
+void save_scan_cache();
+
+std::optional<uintptr_t> scan_cached(HMODULE module, std::string_view pattern);
+std::vector<uintptr_t> scan_all_cached(HMODULE module, std::string_view pattern);
+}
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <climits>
 #include <filesystem>
@@ -17,6 +18,7 @@
 #include <stack>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
@@ -70,7 +72,16 @@ public:
 
     const auto& name() const { return m_name; }
     auto name(std::string name) {
+        if (m_owner != nullptr) {
+            m_owner->unindex_child(this);
+        }
+
         m_name = std::move(name);
+
+        if (m_owner != nullptr) {
+            m_owner->index_child(this);
+        }
+
         return this;
     }
 
@@ -177,13 +188,23 @@ public:
 
     template <typename T> T* add(std::unique_ptr<T> object) {
         object->m_owner = this;
-        return (T*)m_children.emplace_back(std::move(object)).get();
+        object->m_child_order = m_next_child_order++;
+        auto obj = (T*)m_children.emplace_back(std::move(object)).get();
+        m_children_by_name[obj->m_name].push_back(obj);
+        return obj;
     }
 
     template <typename T> T* find(std::string_view name) const {
-        for (auto&& child : m_children) {
-            if (child->is_a<T>() && child->m_name == name) {
-                return (T*)child.get();
+        auto it = m_children_by_name.find(name);
+
+        if (it == m_children_by_name.end()) {
+            return nullptr;
+        }
+
+        // Same order as m_children, so the first match is the same one a linear scan would find.
+        for (auto&& child : it->second) {
+            if (child->is_a<T>()) {
+                return (T*)child;
             }
         }
 
@@ -225,6 +246,8 @@ public:
         if (auto search =
                 std::find_if(m_children.begin(), m_children.end(), [obj](auto&& c) { return c.get() == obj; });
             search != m_children.end()) {
+            unindex_child(obj);
+
             auto p = std::move(*search);
             m_children.erase(search);
             return p;
@@ -285,6 +308,37 @@ protected:
     std::string m_name{};
     std::vector<std::unique_ptr<Object>> m_children{};
     std::vector<std::string> m_metadata{};
+
+private:
+    struct NameHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+    };
+
+    void unindex_child(Object* child) {
+        if (auto it = m_children_by_name.find(child->m_name); it != m_children_by_name.end()) {
+            std::erase(it->second, child);
+
+            if (it->second.empty()) {
+                m_children_by_name.erase(it);
+            }
+        }
+    }
+
+    // Keeps the entries in the same order as m_children without rescanning them,
+    // arrays are renamed right after being added so this usually ends up appending.
+    void index_child(Object* child) {
+        auto& children = m_children_by_name[child->m_name];
+        const auto it = std::upper_bound(children.begin(), children.end(), child,
+            [](const Object* a, const Object* b) { return a->m_child_order < b->m_child_order; });
+
+        children.insert(it, child);
+    }
+
+    // m_children indexed by name, so find() doesn't have to scan every child.
+    std::unordered_map<std::string, std::vector<Object*>, NameHash, std::equal_to<>> m_children_by_name{};
+    size_t m_next_child_order{};
+    size_t m_child_order{}; // position among the owner's children
 };
 
 template <typename T> T* cast(const Object* object) {
@@ -413,7 +467,7 @@ public:
                 tail = base.substr(first_brace);
             }
 
-            m_name = head + '[' + std::to_string(count) + ']' + tail;
+            name(head + '[' + std::to_string(count) + ']' + tail);
         }
 
         m_count = count;
@@ -1270,10 +1324,46 @@ public:
     }
 
     void generate(const std::filesystem::path& sdk_path) const {
-        // erase the file_list.txt
-        std::filesystem::remove(sdk_path / "file_list.txt");
+        std::vector<Type*> objects{};
+        collect_objects(m_global_ns.get(), objects);
+
+        // The tree is only read from here on, so every object's files can be generated independently.
+        std::vector<std::vector<std::filesystem::path>> paths(objects.size());
+        std::atomic<size_t> next_object{0};
+
+        const auto worker = [&]() {
+            for (auto i = next_object++; i < objects.size(); i = next_object++) {
+                if (auto e = dynamic_cast<Enum*>(objects[i])) {
+                    generate_object(sdk_path, e, paths[i]);
+                } else if (auto s = dynamic_cast<Struct*>(objects[i])) {
+                    generate_object(sdk_path, s, paths[i]);
+                }
+            }
+        };
+
+        const auto num_threads = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), std::max<size_t>(objects.size(), 1));
+        std::vector<std::thread> threads{};
 
-        generate_namespace(sdk_path, m_global_ns.get());
+        for (size_t i = 1; i < num_threads; ++i) {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+
+        for (auto& t : threads) {
+            t.join();
+        }
+
+        // Same order as when everything was generated serially.
+        std::ostringstream file_list{};
+
+        for (auto&& object_paths : paths) {
+            for (auto&& path : object_paths) {
+                file_list << "\"" << path.string() << "\" \\\n";
+            }
+        }
+
+        write_if_changed(sdk_path / "file_list.txt", file_list.str());
     }
 
     const auto& header_extension() const { return m_header_extension; }
@@ -1336,18 +1426,52 @@ protected:
     }
 
     std::filesystem::path include_path(Object* from, Object* to) const {
-        auto to_path = std::filesystem::absolute(include_path_for_object(to));
-        auto from_path = std::filesystem::absolute(include_path_for_object(from));
-        auto rel_path = std::filesystem::relative(to_path.parent_path(), from_path.parent_path()) / to_path.filename();
+        // Both paths are relative to the SDK root, so this can be worked out without touching the filesystem.
+        auto to_path = include_path_for_object(to);
+        auto from_path = include_path_for_object(from);
+        auto rel_path = to_path.parent_path().lexically_relative(from_path.parent_path()) / to_path.filename();
         return rel_path;
     }
 
-    template <typename T> void generate_header(const std::filesystem::path& sdk_path, T* obj) const {
+    // Leaves files whose contents didn't change untouched, so incremental builds of the generated SDK stay fast.
+    static bool write_if_changed(const std::filesystem::path& path, const std::string& contents) {
+        // Compared in text mode, the same way they're written.
+        if (std::ifstream existing{path}; existing) {
+            std::ostringstream old_contents{};
+            old_contents << existing.rdbuf();
+
+            if (old_contents.view() == contents) {
+                return false;
+            }
+        }
+
+        std::error_code ec{};
+        std::filesystem::create_directories(path.parent_path(), ec);
+
+        std::ofstream os{path};
+        os << contents;
+
+        return true;
+    }
+
+    template <typename T> void generate_object(const std::filesystem::path& sdk_path, T* obj, std::vector<std::filesystem::path>& paths) const {
+        std::ostringstream os{};
+
         auto obj_inc_path = sdk_path / include_path_for_object(obj);
-        std::ofstream file_list{sdk_path / "file_list.txt", std::ios::app};
-        file_list << "\"" << obj_inc_path.string() << "\" \\\n";
-        std::filesystem::create_directories(obj_inc_path.parent_path());
-        std::ofstream os{obj_inc_path};
+        generate_header(os, obj);
+        write_if_changed(obj_inc_path, os.str());
+        paths.push_back(std::move(obj_inc_path));
+
+        os.str({});
+
+        if (generate_source(os, obj)) {
+            auto obj_src_path = sdk_path / source_path_for_object(obj);
+            write_if_changed(obj_src_path, os.str());
+            paths.push_back(std::move(obj_src_path));
+        }
+    }
+
+    template <typename T> void generate_header(std::ostream& os, T* obj) const {
 
         if (!m_preamble.empty()) {
             std::istringstream sstream{m_preamble};
@@ -1523,10 +1647,11 @@ protected:
         }
     }
 
-    template <typename T> void generate_source(const std::filesystem::path& sdk_path, T* obj) const {
+    // Returns false if the object doesn't need a source file.
+    template <typename T> bool generate_source(std::ostream& os, T* obj) const {
         // Skip generating a source file for an object with no functions.
         if (!obj->has_any<Function>()) {
-            return;
+            return false;
         }
 
         // Skip generating a source file for an object if the functions it does have are all undefined.
@@ -1540,16 +1665,9 @@ protected:
         }
 
         if (!any_defined) {
-            return;
+            return false;
         }
 
-        auto obj_src_path = sdk_path / source_path_for_object(obj);
-        std::ofstream file_list{sdk_path / "file_list.txt", std::ios::app};
-        file_list << "\"" << obj_src_path.string() << "\" \\\n";
-
-        std::filesystem::create_directories(obj_src_path.parent_path());
-        std::ofstream os{obj_src_path};
-
         if (!m_preamble.empty()) {
             std::istringstream sstream{m_preamble};
             std::string line{};
@@ -1623,21 +1741,22 @@ protected:
                 os << "// " << line << "\n";
             }
         }
+
+        return true;
     }
 
-    template <typename T> void generate(const std::filesystem::path& sdk_path, Namespace* ns) const {
-        for (auto&& obj : ns->get_all<T>()) {
-            generate_header(sdk_path, obj);
-            generate_source(sdk_path, obj);
+    // Everything that gets its own files, in the order they used to be generated in.
+    void collect_objects(Namespace* ns, std::vector<Type*>& objects) const {
+        for (auto&& obj : ns->get_all<Enum>()) {
+            objects.push_back(obj);
         }
-    }
 
-    void generate_namespace(const std::filesystem::path& sdk_path, Namespace* ns) const {
-        generate<Enum>(sdk_path, ns);
-        generate<Struct>(sdk_path, ns);
+        for (auto&& obj : ns->get_all<Struct>()) {
+            objects.push_back(obj);
+        }
 
         for (auto&& child : ns->get_all<Namespace>()) {
-            generate_namespace(sdk_path, child);
+            collect_objects(child, objects);
         }
     }
 };
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <hde64.h>
 #include <spdlog/spdlog.h>
 
@@ -44,6 +46,49 @@ void* get_actual_function(void* possible_fn) {
 }
 }
 
+namespace detail {
+// Frames are never freed, only reused, so the steady state doesn't allocate.
+struct HookFrameStack {
+    std::vector<std::unique_ptr<HookManager::HookedFn::Frame>> frames{};
+    size_t depth{0};
+
+    HookManager::HookedFn::Frame& push(HookManager::HookedFn* owner) {
+        if (depth == frames.size()) {
+            frames.emplace_back(std::make_unique<HookManager::HookedFn::Frame>());
+        }
+
+        auto& frame = *frames[depth++];
+        frame.owner = owner;
+
+        return frame;
+    }
+
+    HookManager::HookedFn::Frame& top() {
+        return *frames[depth - 1];
+    }
+
+    void pop() {
+        auto& frame = top();
+
+        // Don't keep the callback list alive longer than needed.
+        frame.cbs.reset();
+        frame.owner = nullptr;
+        --depth;
+    }
+};
+
+thread_local HookFrameStack g_hook_frames{};
+
+bool is_float_type(sdk::RETypeDefinition* t) {
+    if (t == nullptr) {
+        return false;
+    }
+
+    const auto name = t->get_full_name();
+    return name == "System.Single" || name == "System.Double";
+}
+}
+
 HookManager::HookedFn::HookedFn(HookManager& hm) : hookman{hm} {
 }
 
@@ -56,32 +101,107 @@ HookManager::HookedFn::~HookedFn() {
     }
 }
 
-HookManager::PreHookResult HookManager::HookedFn::on_pre_hook() {
+void HookManager::HookedFn::add_callback(HookCallback&& cb) {
+    std::scoped_lock _{mux};
+
+    auto new_cbs = std::make_shared<CallbackList>(*cbs.load(std::memory_order_acquire));
+    new_cbs->emplace_back(std::move(cb));
+
+    cbs.store(std::move(new_cbs), std::memory_order_release);
+}
+
+bool HookManager::HookedFn::remove_callback(HookId id) {
+    std::scoped_lock _{mux};
+
+    auto new_cbs = std::make_shared<CallbackList>(*cbs.load(std::memory_order_acquire));
+    const auto it = std::remove_if(new_cbs->begin(), new_cbs->end(), [id](const HookCallback& cb) { return cb.id == id; });
+
+    if (it == new_cbs->end()) {
+        return false;
+    }
+
+    new_cbs->erase(it, new_cbs->end());
+    cbs.store(std::move(new_cbs), std::memory_order_release);
+
+    return true;
+}
+
+HookManager::PreHookResult HookManager::HookedFn::on_pre_hook(Frame& frame) {
     auto any_skipped = false;
 
-    for (const auto& cb : cbs) {
-        if (cb.pre_fn) {
-            if (cb.pre_fn(args, arg_tys, ret_addr_pre) == PreHookResult::SKIP_ORIGINAL) {
-                any_skipped = true;
-            }
+    const auto args = std::span{frame.args};
+    const auto tys = std::span{arg_tys};
+
+    for (const auto& cb : *frame.cbs) {
+        auto result = PreHookResult::CALL_ORIGINAL;
+
+        if (cb.pre_raw_fn != nullptr) {
+            result = cb.pre_raw_fn(cb.userdata, args, tys, frame.ret_addr);
+        } else if (cb.pre_fn) {
+            result = cb.pre_fn(args, tys, frame.ret_addr);
+        }
+
+        if (result == PreHookResult::SKIP_ORIGINAL) {
+            any_skipped = true;
         }
     } 
 
     return any_skipped ? PreHookResult::SKIP_ORIGINAL : PreHookResult::CALL_ORIGINAL;
 }
 
-void HookManager::HookedFn::on_post_hook() {
-    for (const auto& cb : cbs) {
-        if (cb.post_fn) {
-            cb.post_fn(ret_val, ret_ty, ret_addr);
+void HookManager::HookedFn::on_post_hook(Frame& frame) {
+    for (const auto& cb : *frame.cbs) {
+        if (cb.post_raw_fn != nullptr) {
+            cb.post_raw_fn(cb.userdata, frame.ret_val, ret_ty, frame.ret_addr);
+        } else if (cb.post_fn) {
+            cb.post_fn(frame.ret_val, ret_ty, frame.ret_addr);
         }
     }
 }
 
+HookManager::PreHookResult HookManager::HookedFn::on_pre_hook_static(HookedFn* fn, uintptr_t* entry_rsp) {
+    if (fn->is_virtual) {
+        fn->num_active_calls.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    auto& frame = detail::g_hook_frames.push(fn);
+    const auto stack_args = entry_rsp + 1;
+
+    frame.ret_addr = entry_rsp[0];
+    frame.ret_val = 0;
+    frame.cbs = fn->cbs.load(std::memory_order_acquire);
+    frame.args.resize(fn->num_args);
+    std::copy_n(stack_args, fn->num_stack_args, frame.args.begin());
+    std::fill(frame.args.begin() + fn->num_stack_args, frame.args.end(), 0);
+
+    const auto result = fn->on_pre_hook(frame);
+
+    // Apply any changes the callbacks made, the facilitator reloads the register args from here.
+    std::copy_n(frame.args.begin(), fn->num_arg_slots, stack_args);
+
+    return result;
+}
+
+uintptr_t HookManager::HookedFn::on_post_hook_static(HookedFn* fn, uintptr_t ret_val, uintptr_t* ret_addr_out) {
+    auto& frame = detail::g_hook_frames.top();
+
+    frame.ret_val = ret_val;
+    fn->on_post_hook(frame);
+
+    *ret_addr_out = frame.ret_addr;
+    ret_val = frame.ret_val;
+
+    detail::g_hook_frames.pop();
+
+    if (fn->is_virtual) {
+        fn->num_active_calls.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    return ret_val;
+}
+
 void HookManager::create_jitted_facilitator(std::unique_ptr<HookManager::HookedFn>& hook, sdk::REMethodDefinition* fn, std::function<uintptr_t ()> hook_initialization, std::function<void ()> hook_create) {
-    auto& args = hook->args;
     auto& arg_tys = hook->arg_tys;
-    auto& fn_hook = hook->fn_hook;
 
     using namespace asmjit;
     using namespace asmjit::x86;
@@ -96,116 +216,44 @@ void HookManager::create_jitted_facilitator(std::unique_ptr<HookManager::HookedF
     // + 2 for the thread context + this pointer.
     // Another + 2 for hidden arguments that we may not know about.
     constexpr auto HIDDEN_ARGUMENT_COUNT = 2;
-    args.resize(size_t(2) + HIDDEN_ARGUMENT_COUNT + fn->get_num_params());
-
-    // Generate the facilitator function that will store the arguments, call on_hook, 
-    // restore the arguments, and call the original function.
-    auto hook_label = a.newLabel();
-    auto args_label = a.newLabel();
-    auto this_label = a.newLabel();
-    auto on_pre_hook_label = a.newLabel();
-    auto on_post_hook_label = a.newLabel();
-    auto ret_addr_pre_label = a.newLabel();
-    auto ret_addr_label = a.newLabel();
-    auto ret_val_label = a.newLabel();
-    auto orig_label = a.newLabel();
-    auto lock_label = a.newLabel();
-    auto unlock_label = a.newLabel();
-
-    // Save state.
-    a.push(rcx);
-    a.push(rdx);
-    a.push(r8);
-    a.push(r9);
-
-    // Lock context.
-    a.mov(rcx, ptr(hook_label));
-    a.sub(rsp, 40);
-    a.call(ptr(lock_label));
-    a.add(rsp, 40);
-
-    // Restore state.
-    a.pop(r9);
-    a.pop(r8);
-    a.pop(rdx);
-    a.pop(rcx);
-
-    // Save return address (pre-hook).
-    // Cannot modify the post version as it will corrupt the stack if the hook is recursive.
-    a.mov(r10, ptr(rsp));
-    a.mov(rax, ptr(ret_addr_pre_label));
-    a.mov(ptr(rax), r10);
-
-    // Store args.
-    // TODO: Handle all the arguments the function takes.
-    a.mov(rax, ptr(args_label));
-    a.mov(ptr(rax), rcx); // current thread context.
-
-    auto args_start_offset = 8;
-
-    if (!fn->is_static()) {
-        args_start_offset = 16;
-        a.mov(ptr(rax, 8), rdx); // this ptr... probably.
-    }
-
-    auto save_arg = [&a](uint32_t args_offset, bool is_float) {
-        switch (args_offset) {
-        case 8: // rdx/xmm1
-            if (is_float) {
-                a.movq(ptr(rax, args_offset), xmm1);
-            } else {
-                a.mov(ptr(rax, args_offset), rdx);
-            }
-            break;
-
-        case 16: // r8/xmm2
-            if (is_float) {
-                a.movq(ptr(rax, args_offset), xmm2);
-            } else {
-                a.mov(ptr(rax, args_offset), r8);
-            }
-            break;
-
-        case 24: // r9/xmm3
-            if (is_float) {
-                a.movq(ptr(rax, args_offset), xmm3);
-            } else {
-                a.mov(ptr(rax, args_offset), r9);
-            }
-            break;
+    const auto num_params = fn->get_num_params();
+    const auto first_param_slot = fn->is_static() ? 1u : 2u;
 
-        default:
-            // stack args
-            if (args_offset >= 32) {
-                a.mov(r10, ptr(rsp, sizeof(void*) + (args_offset)));
-                a.mov(ptr(rax, args_offset), r10);
-            }
+    hook->num_args = 2 + HIDDEN_ARGUMENT_COUNT + num_params;
+    hook->num_stack_args = first_param_slot + num_params + HIDDEN_ARGUMENT_COUNT;
+    hook->num_arg_slots = first_param_slot + num_params;
 
-            break;
+    auto is_float_slot = [&](uint32_t slot) {
+        if (slot < first_param_slot || slot - first_param_slot >= num_params) {
+            return false;
         }
+
+        return detail::is_float_type(arg_tys[slot - first_param_slot]);
     };
-    
-    const auto num_params = fn->get_num_params();
 
-    // +2 for buffer params to fix possible corruption.
-    for (auto i = 0u; i < num_params + HIDDEN_ARGUMENT_COUNT; ++i) {
-        auto is_float = false;
+    // Generate the facilitator function. Nothing about an individual call is stored in the facilitator
+    // or the HookedFn, the args live in the caller's stack and in a thread-local frame,
+    // so many threads can be inside the same hooked function at once without any locking.
+    auto hook_label = a.newLabel();
+    auto on_pre_hook_label = a.newLabel();
+    auto on_post_hook_label = a.newLabel();
+    auto orig_label = a.newLabel();
 
-        if (i < num_params) {
-            auto arg_ty = arg_tys[i];
+    const Gp int_regs[] = {rcx, rdx, r8, r9};
+    const Xmm float_regs[] = {xmm0, xmm1, xmm2, xmm3};
 
-            if (arg_ty->get_full_name() == "System.Single") {
-                is_float = true;
-            }
+    // Spill the register args into the home space, which makes all of the args contiguous on the stack.
+    for (auto i = 0u; i < 4 && i < hook->num_stack_args; ++i) {
+        if (is_float_slot(i)) {
+            a.movq(ptr(rsp, 8 + i * 8), float_regs[i]);
+        } else {
+            a.mov(ptr(rsp, 8 + i * 8), int_regs[i]);
         }
-
-        const auto args_offset = args_start_offset + (i * 8);
-
-        save_arg(args_offset, is_float);
     }
 
     // Call on_pre_hook.
     a.mov(rcx, ptr(hook_label));
+    a.mov(rdx, rsp);
     a.sub(rsp, 40);
     a.call(ptr(on_pre_hook_label));
     a.add(rsp, 40);
@@ -213,78 +261,20 @@ void HookManager::create_jitted_facilitator(std::unique_ptr<HookManager::HookedF
     // Save the return value so we can see if we need to call the original later.
     a.mov(r11, rax);
 
-    // Restore args.
-    a.mov(rax, ptr(args_label));
-    a.mov(rcx, ptr(rax)); // current thread context.
-
-    if (!fn->is_static()) {
-        a.mov(rdx, ptr(rax, 8)); // this ptr... probably.
-    }
-
-    auto restore_arg = [&a](uint32_t args_offset, bool is_float) {
-        switch (args_offset) {
-        case 8: // rdx/xmm1
-            if (is_float) {
-                a.movq(xmm1, ptr(rax, args_offset));
-            } else {
-                a.mov(rdx, ptr(rax, args_offset));
-            }
-            break;
-
-        case 16: // r8/xmm2
-            if (is_float) {
-                a.movq(xmm2, ptr(rax, args_offset));
-            } else {
-                a.mov(r8, ptr(rax, args_offset));
-            }
-            break;
-
-        case 24: // r9/xmm3
-            if (is_float) {
-                a.movq(xmm3, ptr(rax, args_offset));
-            } else {
-                a.mov(r9, ptr(rax, args_offset));
-            }
-            break;
-
-        default:
-            if (args_offset >= 32) {
-                a.mov(r10, ptr(rax, args_offset));
-                a.mov(ptr(rsp, sizeof(void*) + (args_offset)), r10);
-            }
-
-            // TODO: handle stack args.
-            break;
+    // Restore args, the stack args were already written back by on_pre_hook.
+    for (auto i = 0u; i < 4 && i < hook->num_stack_args; ++i) {
+        if (is_float_slot(i)) {
+            a.movq(float_regs[i], ptr(rsp, 8 + i * 8));
+        } else {
+            a.mov(int_regs[i], ptr(rsp, 8 + i * 8));
         }
-    };
-
-    // +2 for buffer params to fix possible corruption.
-    for (auto i = 0u; i < num_params + HIDDEN_ARGUMENT_COUNT; ++i) {
-        auto is_float = false;
-
-        if (i < num_params) {
-            auto arg_ty = arg_tys[i];
-
-            if (arg_ty->get_full_name() == "System.Single") {
-                is_float = true;
-            }
-        }
-
-        auto args_offset = args_start_offset + (i * 8);
-        
-        restore_arg(args_offset, is_float);
     }
 
     // Call original function.
     auto ret_label = a.newLabel();
     auto skip_label = a.newLabel();
 
-    // Save return address.
-    a.mov(r10, ptr(rsp));
-    a.mov(rax, ptr(ret_addr_label));
-    a.mov(ptr(rax), r10);
-
-    // Overwrite return address.
+    // Overwrite return address, the real one is kept in the frame.
     a.lea(rax, ptr(ret_label));
     a.mov(ptr(rsp), rax);
 
@@ -300,69 +290,39 @@ void HookManager::create_jitted_facilitator(std::unique_ptr<HookManager::HookedF
 
     a.bind(ret_label);
 
-    // Save return value.
-    a.mov(rcx, ptr(ret_val_label));
+    // Make room for the real return address, on_post_hook fills it in.
+    a.sub(rsp, 8);
 
-    auto is_ret_ty_float = hook->ret_ty->get_full_name() == "System.Single";
+    // Pass the return value to on_post_hook.
+    const auto is_ret_ty_float = detail::is_float_type(hook->ret_ty);
 
     if (is_ret_ty_float) {
-        a.movq(ptr(rcx), xmm0);
+        a.movq(rdx, xmm0);
     } else {
-        a.mov(ptr(rcx), rax);
+        a.mov(rdx, rax);
     }
 
     // Call on_post_hook.
     a.mov(rcx, ptr(hook_label));
+    a.mov(r8, rsp);
+    a.sub(rsp, 40);
     a.call(ptr(on_post_hook_label));
+    a.add(rsp, 40);
 
     // Restore return value.
-    a.mov(rcx, ptr(ret_val_label));
-
     if (is_ret_ty_float) {
-        a.movq(xmm0, ptr(rcx));
-    } else {
-        a.mov(rax, ptr(rcx));
+        a.movq(xmm0, rax);
     }
 
-    // Store state.
-    a.push(rax);
-    a.mov(r10, ptr(ret_addr_label));
-    a.mov(r10, ptr(r10));
-    a.push(r10);
-
-    // Unlock context.
-    a.mov(rcx, ptr(hook_label));
-    a.sub(rsp, 32);
-    a.call(ptr(unlock_label));
-    a.add(rsp, 32);
-
-    // Restore state.
-    a.pop(r10);
-    a.pop(rax);
-
-    // Return.
-    a.jmp(r10);
+    // Return to the original caller.
+    a.ret();
 
     a.bind(hook_label);
     a.dq((uint64_t)hook.get());
-    a.bind(args_label);
-    a.dq((uint64_t)args.data());
-    a.bind(this_label);
-    a.dq((uint64_t)this);
     a.bind(on_pre_hook_label);
     a.dq((uint64_t)&HookedFn::on_pre_hook_static);
     a.bind(on_post_hook_label);
     a.dq((uint64_t)&HookedFn::on_post_hook_static);
-    a.bind(lock_label);
-    a.dq((uint64_t)&HookedFn::lock_static);
-    a.bind(unlock_label);
-    a.dq((uint64_t)&HookedFn::unlock_static);
-    a.bind(ret_addr_pre_label);
-    a.dq((uint64_t)&hook->ret_addr_pre);
-    a.bind(ret_addr_label);
-    a.dq((uint64_t)&hook->ret_addr);
-    a.bind(ret_val_label);
-    a.dq((uint64_t)&hook->ret_val);
     a.bind(orig_label);
     // Can't do the following because the hook hasn't been created yet.
     //a.dq(fn_hook->get_original());
@@ -379,6 +339,20 @@ void HookManager::create_jitted_facilitator(std::unique_ptr<HookManager::HookedF
 }
 
 HookManager::HookId HookManager::add(sdk::REMethodDefinition* fn, HookManager::PreHookFn pre_fn, HookManager::PostHookFn post_fn, bool ignore_jmp) {
+    return add_callback(fn, HookCallback{.pre_fn = std::move(pre_fn), .post_fn = std::move(post_fn)}, ignore_jmp);
+}
+
+HookManager::HookId HookManager::add_raw(sdk::REMethodDefinition* fn, PreHookRawFn pre_fn, PostHookRawFn post_fn, void* userdata, bool ignore_jmp) {
+    return add_callback(fn, HookCallback{.pre_raw_fn = pre_fn, .post_raw_fn = post_fn, .userdata = userdata}, ignore_jmp);
+}
+
+HookManager::HookId HookManager::add_raw(sdk::REMethodDefinition* fn, PreHookRawFn pre_fn, PostHookRawFn post_fn, std::shared_ptr<void> userdata, bool ignore_jmp) {
+    const auto raw_userdata = userdata.get();
+
+    return add_callback(fn, HookCallback{.pre_raw_fn = pre_fn, .post_raw_fn = post_fn, .userdata = raw_userdata, .userdata_owner = std::move(userdata)}, ignore_jmp);
+}
+
+HookManager::HookId HookManager::add_callback(sdk::REMethodDefinition* fn, HookCallback&& cb, bool ignore_jmp) {
     if (fn == nullptr) {
         //throw std::exception{"[HookManager] Cannot add nullptr function"};
         spdlog::error("[HookManager] Cannot add nullptr function");
@@ -394,16 +368,18 @@ HookManager::HookId HookManager::add(sdk::REMethodDefinition* fn, HookManager::P
 
     spdlog::info("[HookManager] Adding hook for '{}' @ {:p}...", fn->get_name(), target_fn);
 
+    std::scoped_lock _{m_hooks_mux};
+
     if (auto search = m_hooked_fns.find(fn); search != m_hooked_fns.end()) {
         spdlog::info("[HookManager] Reusing existing hook...");
 
         auto& hook = search->second;
-        std::scoped_lock _{hook->mux};
         auto hook_id = m_next_hook_id++;
 
         spdlog::info("[HookManager] Hook assigned ID {}", hook_id);
 
-        hook->cbs.emplace_back(hook_id, std::move(pre_fn), std::move(post_fn));
+        cb.id = hook_id;
+        hook->add_callback(std::move(cb));
 
         spdlog::info("[HookManager] Hook {} added for '{}' @ {:p}", hook_id, fn->get_name(), target_fn);
 
@@ -420,13 +396,11 @@ HookManager::HookId HookManager::add(sdk::REMethodDefinition* fn, HookManager::P
     spdlog::info("[HookManager] Hook assigned ID {}", hook_id);
 
     hook->target_fn = target_fn;
-    hook->cbs.emplace_back(hook_id, std::move(pre_fn), std::move(post_fn));
+    cb.id = hook_id;
+    hook->add_callback(std::move(cb));
     hook->arg_tys = fn->get_param_types();
     hook->ret_ty = fn->get_return_type();
-    
 
-    auto& args = hook->args;
-    auto& arg_tys = hook->arg_tys;
     auto& fn_hook = hook->fn_hook;
 
     // Create the facilitator! this really important!
@@ -448,6 +422,20 @@ HookManager::HookId HookManager::add(sdk::REMethodDefinition* fn, HookManager::P
 }
 
 HookManager::HookId HookManager::add_vtable(::REManagedObject* obj, sdk::REMethodDefinition* fn, PreHookFn pre_fn, PostHookFn post_fn) {
+    return add_vtable_callback(obj, fn, HookCallback{.pre_fn = std::move(pre_fn), .post_fn = std::move(post_fn)});
+}
+
+HookManager::HookId HookManager::add_vtable_raw(::REManagedObject* obj, sdk::REMethodDefinition* fn, PreHookRawFn pre_fn, PostHookRawFn post_fn, void* userdata) {
+    return add_vtable_callback(obj, fn, HookCallback{.pre_raw_fn = pre_fn, .post_raw_fn = post_fn, .userdata = userdata});
+}
+
+HookManager::HookId HookManager::add_vtable_raw(::REManagedObject* obj, sdk::REMethodDefinition* fn, PreHookRawFn pre_fn, PostHookRawFn post_fn, std::shared_ptr<void> userdata) {
+    const auto raw_userdata = userdata.get();
+
+    return add_vtable_callback(obj, fn, HookCallback{.pre_raw_fn = pre_fn, .post_raw_fn = post_fn, .userdata = raw_userdata, .userdata_owner = std::move(userdata)});
+}
+
+HookManager::HookId HookManager::add_vtable_callback(::REManagedObject* obj, sdk::REMethodDefinition* fn, HookCallback&& cb) {
 #if TDB_VER == 49
     throw std::runtime_error("VTable hooks are not supported in TDB 49");
 #endif
@@ -469,6 +457,8 @@ HookManager::HookId HookManager::add_vtable(::REManagedObject* obj, sdk::REMetho
         return HookId{};
     }
 
+    std::scoped_lock _{m_hooks_mux};
+
     auto search = m_hooked_vtables.find(obj);
 
     if (search != m_hooked_vtables.end()) {
@@ -477,7 +467,6 @@ HookManager::HookId HookManager::add_vtable(::REManagedObject* obj, sdk::REMetho
         spdlog::info("[HookManager] Creating a new VT hook...");
 
         auto hook = std::make_unique<HookManager::HookedVTable>(*this);
-        std::scoped_lock _{hook->mux};
 
         hook->vtable_hook = std::make_unique<sdk::REVTableHook>(obj);
 
@@ -495,8 +484,6 @@ HookManager::HookId HookManager::add_vtable(::REManagedObject* obj, sdk::REMetho
 
     auto& hook = search->second;
 
-    std::scoped_lock _{hook->mux};
-
     // Now we need to find or create an existing function hook for the individual vtable method inside the vtable
     if (auto it = hook->hooked_fns.find(fn); it != hook->hooked_fns.end()) {
         spdlog::info("[HookManager] Reusing existing VT hook...");
@@ -504,7 +491,8 @@ HookManager::HookId HookManager::add_vtable(::REManagedObject* obj, sdk::REMetho
         auto& hook_fn = it->second;
 
         auto hook_id = m_next_hook_id++;
-        hook_fn->cbs.emplace_back(hook_id, std::move(pre_fn), std::move(post_fn));
+        cb.id = hook_id;
+        hook_fn->add_callback(std::move(cb));
 
         spdlog::info("[HookManager] VT Hook {} added for '{}' @ {:p}", hook_id, fn->get_name(), fn->get_function());
 
@@ -522,20 +510,21 @@ HookManager::HookId HookManager::add_vtable(::REManagedObject* obj, sdk::REMetho
     spdlog::info("[HookManager] VT Hook assigned ID {}", hook_id);
 
     hook_fn->target_fn = fn->get_function();
-    hook_fn->cbs.emplace_back(hook_id, std::move(pre_fn), std::move(post_fn));
+    cb.id = hook_id;
+    hook_fn->add_callback(std::move(cb));
     hook_fn->arg_tys = fn->get_param_types();
     hook_fn->ret_ty = fn->get_return_type();
-    
+    hook_fn->is_virtual = true;
+    hook_fn->vtable = hook.get();
 
-    auto& args = hook_fn->args;
-    auto& arg_tys = hook_fn->arg_tys;
+    bool hooked_method = true;
 
     // Create the facilitator! this really important!
     create_jitted_facilitator(hook_fn, fn,
         [&]() -> uintptr_t {
             if (!hook->vtable_hook->hook_method(fn->get_virtual_index(), (void*)hook_fn->facilitator_fn)) {
                 spdlog::error("[HookManager] Failed to hook vtable method for {:x}", (uintptr_t)obj);
-                hook_fn = nullptr;
+                hooked_method = false;
                 return 0;
             }
 
@@ -546,44 +535,81 @@ HookManager::HookId HookManager::add_vtable(::REManagedObject* obj, sdk::REMetho
         }
     );
 
+    if (!hooked_method) {
+        hook->hooked_fns.erase(fn);
+        return HookId{};
+    }
+
     spdlog::info("[HookManager] VT Hook {} added for '{}' @ {:p}", hook_id, fn->get_name(), fn->get_function());
 
     return hook_id;
 }
 
 void HookManager::remove(sdk::REMethodDefinition* fn, HookId id) {
+    std::unique_lock _{m_hooks_mux};
+
     if (auto search = m_hooked_fns.find(fn); search != m_hooked_fns.end()) {
         spdlog::info("[HookManager] Removing hook ID {} from '{}'", id, fn->get_name());
 
-        auto& hook = search->second;
-        auto& cbs = hook->cbs;
-        std::scoped_lock _{hook->mux};
-        cbs.erase(std::remove_if(cbs.begin(), cbs.end(), [id](const HookCallback& cb) { return cb.id == id; }));
+        // The function stays hooked, it just has one less callback to run.
+        search->second->remove_callback(id);
     } else {
-        std::vector<::REManagedObject*> queued_vtable_deletions{};
+        std::vector<std::unique_ptr<HookedVTable>> queued_vtable_deletions{};
 
         // Search through the vtable hooks.
-        for (auto& it : m_hooked_vtables) {
-            auto& hook = it.second;
+        for (auto it = m_hooked_vtables.begin(); it != m_hooked_vtables.end();) {
+            auto& hook = it->second;
 
             if (auto search = hook->hooked_fns.find(fn); search != hook->hooked_fns.end()) {
                 spdlog::info("[HookManager] Removing VT method hook ID {} from '{}'", id, fn->get_name());
 
                 auto& hook_fn = search->second;
-                auto& cbs = hook_fn->cbs;
-                std::scoped_lock _{hook->mux};
-                cbs.erase(std::remove_if(cbs.begin(), cbs.end(), [id](const HookCallback& cb) { return cb.id == id; }), cbs.end());
+                hook_fn->remove_callback(id);
 
-                if (cbs.empty()) {
-                    queued_vtable_deletions.push_back(it.first);
+                if (!hook_fn->has_callbacks()) {
+                    spdlog::info("[HookManager] Removing VT hook for {:x}", (uintptr_t)it->first);
+
+                    queued_vtable_deletions.emplace_back(std::move(hook));
+                    it = m_hooked_vtables.erase(it);
+                    continue;
                 }
             }
+
+            ++it;
         }
 
-        // Delete the vtable hooks.
-        for (auto& obj : queued_vtable_deletions) {
-            spdlog::info("[HookManager] Removing VT hook for {:x}", (uintptr_t)obj);
-            m_hooked_vtables.erase(obj);
+        // Still holding the lock so a concurrent add_vtable on the same object can't install its hook
+        // while the vtable is being restored, or read the hooked vtable as the original.
+        // Restoring the object info stops new calls from coming in, but other threads (or this one, if a hook
+        // removes itself from inside a callback) may still be reading the copied vtable or running through
+        // the facilitators, so both are retired and only freed a few frames later by on_frame. Never wait here,
+        // callers like ~ScriptState hold locks that the callbacks still in flight may be blocked on.
+        for (auto& hook : queued_vtable_deletions) {
+            hook->vtable_hook->unhook();
+            m_retired_vtables.emplace_back(RetiredVTable{std::move(hook), m_frame_count.load()});
         }
     }
 }
+
+void HookManager::on_frame() {
+    // Called from the render thread, which must not stall on a long add/remove.
+    const auto frame_count = ++m_frame_count;
+    std::unique_lock lock{m_hooks_mux, std::try_to_lock};
+
+    if (!lock.owns_lock() || m_retired_vtables.empty()) {
+        return;
+    }
+
+    // The frame delay covers threads that were between the vtable load and the facilitator's
+    // bookkeeping (or in its epilogue after it) when the hook was removed.
+    // Calls still counted as active (e.g. blocked inside a callback) hold the facilitator back for longer.
+    std::erase_if(m_retired_vtables, [frame_count](const RetiredVTable& retired) {
+        if (frame_count - retired.retired_frame < RETIRED_VTABLE_FRAME_DELAY) {
+            return false;
+        }
+
+        return std::all_of(retired.hook->hooked_fns.begin(), retired.hook->hooked_fns.end(), [](auto& it) {
+            return it.second->num_active_calls.load(std::memory_order_acquire) == 0;
+        });
+    });
+}
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <span>
 
 #include <asmjit/asmjit.h>
 
@@ -22,14 +24,27 @@ public:
     };
 
     struct HookedFn;
-    using PreHookFn = std::function<PreHookResult(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr)>;
+    using PreHookFn = std::function<PreHookResult(std::span<uintptr_t> args, std::span<sdk::RETypeDefinition*> arg_tys, uintptr_t ret_addr)>;
     using PostHookFn = std::function<void(uintptr_t& ret_val, sdk::RETypeDefinition* ret_ty, uintptr_t ret_addr)>;
+
+    // Plain function pointer + userdata versions of the above, for hot hooks that don't want to go through std::function.
+    using PreHookRawFn = PreHookResult (*)(void* userdata, std::span<uintptr_t> args, std::span<sdk::RETypeDefinition*> arg_tys, uintptr_t ret_addr);
+    using PostHookRawFn = void (*)(void* userdata, uintptr_t& ret_val, sdk::RETypeDefinition* ret_ty, uintptr_t ret_addr);
     using HookId = size_t;
 
     struct HookCallback {
         HookId id{};
         PreHookFn pre_fn{};
         PostHookFn post_fn{};
+
+        // Takes priority over pre_fn/post_fn when set.
+        PreHookRawFn pre_raw_fn{};
+        PostHookRawFn post_raw_fn{};
+        void* userdata{};
+
+        // Optional owner of userdata. Lives as long as the callback list it's in,
+        // so in-flight calls can still use userdata after the hook is removed.
+        std::shared_ptr<void> userdata_owner{};
     };
 
     struct HookedFn;
@@ -38,24 +53,48 @@ public:
         HookManager& hookman;
         std::unique_ptr<sdk::REVTableHook> vtable_hook{};
         std::unordered_map<sdk::REMethodDefinition*, std::unique_ptr<HookedFn>> hooked_fns{};
-
-        std::recursive_mutex mux{};
     };
 
     struct HookedFn {
+        using CallbackList = std::vector<HookCallback>;
+
+        // Per-invocation state, so concurrent (or recursive) calls to the same hooked function
+        // don't have to be serialized. Frames live on a thread-local stack and are reused between calls.
+        struct Frame {
+            HookedFn* owner{nullptr};
+            std::vector<uintptr_t> args{};
+            uintptr_t ret_addr{};
+            uintptr_t ret_val{};
+
+            // The callbacks that ran in the pre hook, so the post hook runs the same ones
+            // even if the list was swapped out while the original function was running.
+            std::shared_ptr<const CallbackList> cbs{};
+        };
+
         HookManager& hookman;
         void* target_fn{};
-        std::vector<HookCallback> cbs{}; 
         HookId next_hook_id{};
         std::unique_ptr<FunctionHook> fn_hook{};
         uintptr_t facilitator_fn{};
-        std::vector<uintptr_t> args{};
         std::vector<sdk::RETypeDefinition*> arg_tys{};
-        uintptr_t ret_addr_pre{};
-        uintptr_t ret_addr{};
-        uintptr_t ret_val{};
         sdk::RETypeDefinition* ret_ty{};
-        std::recursive_mutex mux{};
+
+        // Number of argument slots as they sit on the stack after the facilitator spills the register args.
+        // The thread context, the this pointer (if not static), the params and a few hidden args.
+        uint32_t num_stack_args{};
+        uint32_t num_args{};
+
+        // The thread context, the this pointer (if not static) and the params. Only these are written back
+        // after the pre hooks, the hidden slots may belong to the caller's frame.
+        uint32_t num_arg_slots{};
+
+        // Copy-on-write, readers take a snapshot without locking. Writers serialize on mux.
+        std::atomic<std::shared_ptr<const CallbackList>> cbs{std::make_shared<const CallbackList>()};
+        std::mutex mux{};
+
+        // Calls currently between on_pre_hook_static and on_post_hook_static of a vtable hook.
+        // Keeps a removed vtable hook retired for as long as any of them is still running.
+        std::atomic<uint32_t> num_active_calls{0};
 
         bool is_virtual{false};
         HookedVTable* vtable{nullptr};
@@ -63,30 +102,29 @@ public:
         HookedFn(HookManager& hm);
         ~HookedFn();
 
-        PreHookResult on_pre_hook();
-        void on_post_hook();
+        void add_callback(HookCallback&& cb);
+        bool remove_callback(HookId id);
+        bool has_callbacks() const { return !cbs.load(std::memory_order_acquire)->empty(); }
 
-        __declspec(noinline) static void lock_static(HookedFn* fn) {
-            fn->mux.lock();
+        PreHookResult on_pre_hook(Frame& frame);
+        void on_post_hook(Frame& frame);
 
-            if (fn->is_virtual) {
-                fn->vtable->mux.lock();
-            }
-        }
-        __declspec(noinline) static void unlock_static(HookedFn* fn) {
-            if (fn->is_virtual) {
-                fn->vtable->mux.unlock();
-            }
-
-            fn->mux.unlock(); 
-        }
-        __declspec(noinline) static PreHookResult on_pre_hook_static(HookedFn* fn) { return fn->on_pre_hook(); }
-        __declspec(noinline) static void on_post_hook_static(HookedFn* fn) { fn->on_post_hook(); }
+        // Called by the facilitator. entry_rsp points at the return address of the hooked call
+        // with the register args already spilled into the home space directly above it.
+        __declspec(noinline) static PreHookResult on_pre_hook_static(HookedFn* fn, uintptr_t* entry_rsp);
+        __declspec(noinline) static uintptr_t on_post_hook_static(HookedFn* fn, uintptr_t ret_val, uintptr_t* ret_addr_out);
     };
 
+    // Hooks added on a thread with a FunctionHook::Batch alive are enabled together
+    // with a single thread freeze when the batch commits or goes out of scope.
     HookId add(sdk::REMethodDefinition* fn, PreHookFn pre_fn, PostHookFn post_fn, bool ignore_jmp = false);
     HookId add_vtable(::REManagedObject* obj, sdk::REMethodDefinition* fn, PreHookFn pre_fn, PostHookFn post_fn);
 
+    HookId add_raw(sdk::REMethodDefinition* fn, PreHookRawFn pre_fn, PostHookRawFn post_fn, void* userdata, bool ignore_jmp = false);
+    HookId add_raw(sdk::REMethodDefinition* fn, PreHookRawFn pre_fn, PostHookRawFn post_fn, std::shared_ptr<void> userdata, bool ignore_jmp = false);
+    HookId add_vtable_raw(::REManagedObject* obj, sdk::REMethodDefinition* fn, PreHookRawFn pre_fn, PostHookRawFn post_fn, void* userdata);
+    HookId add_vtable_raw(::REManagedObject* obj, sdk::REMethodDefinition* fn, PreHookRawFn pre_fn, PostHookRawFn post_fn, std::shared_ptr<void> userdata);
+
     struct EitherOr {
         ::REManagedObject* obj{nullptr};
         sdk::REMethodDefinition* fn{nullptr};
@@ -101,7 +139,13 @@ public:
     }
     void remove(sdk::REMethodDefinition* fn, HookId id);
 
+    // Frees removed vtable hooks once no thread can still be running through them. Called once per frame.
+    void on_frame();
+
 private:
+    HookId add_callback(sdk::REMethodDefinition* fn, HookCallback&& cb, bool ignore_jmp);
+    HookId add_vtable_callback(::REManagedObject* obj, sdk::REMethodDefinition* fn, HookCallback&& cb);
+
     void create_jitted_facilitator(
         std::unique_ptr<HookedFn>& hooked_fn, 
         sdk::REMethodDefinition* fn,
@@ -113,7 +157,21 @@ private:
     std::unordered_map<sdk::REMethodDefinition*, std::unique_ptr<HookedFn>> m_hooked_fns{};
     std::unordered_map<::REManagedObject*, std::unique_ptr<HookedVTable>> m_hooked_vtables{};
 
+    // Only taken by add/remove and on_frame, the hooked functions themselves never touch it.
+    std::recursive_mutex m_hooks_mux{};
+
     HookId m_next_hook_id{1};
+
+    // Removed vtable hooks whose facilitators may still be in use, see on_frame.
+    struct RetiredVTable {
+        std::unique_ptr<HookedVTable> hook{};
+        uint64_t retired_frame{};
+    };
+
+    static constexpr uint64_t RETIRED_VTABLE_FRAME_DELAY = 3;
+
+    std::vector<RetiredVTable> m_retired_vtables{};
+    std::atomic<uint64_t> m_frame_count{0};
 };
 
 inline HookManager g_hookman{};
\ No newline at end of file
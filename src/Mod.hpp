@@ -4,9 +4,11 @@
 #define DIRECTINPUT_VERSION 0x0800
 #include <dinput.h>
 
+#include <bitset>
 #include <vector>
 #include <unordered_map>
 #include <memory>
+#include <type_traits>
 
 #include <imgui.h>
 #include <sol/sol.hpp>
@@ -409,4 +411,63 @@ public:
     MAKE_LAYER_CALLBACK(Scene, scene);
     MAKE_LAYER_CALLBACK(PostEffect, post_effect);
     MAKE_LAYER_CALLBACK(Overlay, overlay);
-};
\ No newline at end of file
+};
+
+// Game callbacks that are dispatched from hot hooks.
+// Mods only get called for the ones they subscribe to, see Mods::add.
+#define MAKE_LAYER_CALLBACK_IDS(X, x, X2) \
+    X(PRE_##X2##_LAYER_DRAW, on_pre_##x##_layer_draw) \
+    X(X2##_LAYER_DRAW, on_##x##_layer_draw) \
+    X(PRE_##X2##_LAYER_UPDATE, on_pre_##x##_layer_update) \
+    X(X2##_LAYER_UPDATE, on_##x##_layer_update)
+
+#define FOR_EACH_MOD_CALLBACK(X) \
+    X(PRE_UPDATE_TRANSFORM, on_pre_update_transform) \
+    X(UPDATE_TRANSFORM, on_update_transform) \
+    X(PRE_UPDATE_CAMERA_CONTROLLER, on_pre_update_camera_controller) \
+    X(UPDATE_CAMERA_CONTROLLER, on_update_camera_controller) \
+    X(PRE_UPDATE_CAMERA_CONTROLLER2, on_pre_update_camera_controller2) \
+    X(UPDATE_CAMERA_CONTROLLER2, on_update_camera_controller2) \
+    X(PRE_GUI_DRAW_ELEMENT, on_pre_gui_draw_element) \
+    X(GUI_DRAW_ELEMENT, on_gui_draw_element) \
+    X(PRE_UPDATE_BEFORE_LOCK_SCENE, on_pre_update_before_lock_scene) \
+    X(UPDATE_BEFORE_LOCK_SCENE, on_update_before_lock_scene) \
+    X(PRE_LIGHTSHAFT_DRAW, on_pre_lightshaft_draw) \
+    X(LIGHTSHAFT_DRAW, on_lightshaft_draw) \
+    X(PRE_VIEW_GET_SIZE, on_pre_view_get_size) \
+    X(VIEW_GET_SIZE, on_view_get_size) \
+    X(PRE_CAMERA_GET_PROJECTION_MATRIX, on_pre_camera_get_projection_matrix) \
+    X(CAMERA_GET_PROJECTION_MATRIX, on_camera_get_projection_matrix) \
+    X(PRE_CAMERA_GET_VIEW_MATRIX, on_pre_camera_get_view_matrix) \
+    X(CAMERA_GET_VIEW_MATRIX, on_camera_get_view_matrix) \
+    X(PRE_APPLICATION_ENTRY, on_pre_application_entry) \
+    X(APPLICATION_ENTRY, on_application_entry) \
+    MAKE_LAYER_CALLBACK_IDS(X, scene, SCENE) \
+    MAKE_LAYER_CALLBACK_IDS(X, post_effect, POST_EFFECT) \
+    MAKE_LAYER_CALLBACK_IDS(X, overlay, OVERLAY)
+
+enum class ModCallback : uint8_t {
+#define X(id, fn) id,
+    FOR_EACH_MOD_CALLBACK(X)
+#undef X
+    COUNT
+};
+
+using ModCallbacks = std::bitset<(size_t)ModCallback::COUNT>;
+
+const char* get_mod_callback_name(ModCallback callback);
+
+// A callback counts as implemented if T (or anything between it and Mod) overrides it,
+// in which case &T::fn is no longer a pointer to Mod's member.
+template <typename T>
+ModCallbacks detect_mod_callbacks() {
+    static_assert(std::is_base_of_v<Mod, T>);
+
+    ModCallbacks out{};
+
+#define X(id, fn) if constexpr (!std::is_same_v<decltype(&T::fn), decltype(&Mod::fn)>) { out.set((size_t)ModCallback::id); }
+    FOR_EACH_MOD_CALLBACK(X)
+#undef X
+
+    return out;
+}
@@ -19,55 +19,70 @@
 #include "Mods.hpp"
 
 Mods::Mods() {
-    m_mods.emplace_back(REFrameworkConfig::get());
+    add(REFrameworkConfig::get());
 
 #if defined(RE3) || defined(RE8) || defined(MHRISE)
-    m_mods.emplace_back(std::make_unique<IntegrityCheckBypass>());
+    add(std::make_unique<IntegrityCheckBypass>());
 #endif
 
 #ifndef BAREBONES
-    m_mods.emplace_back(Hooks::get());
+    add(Hooks::get());
 
-    m_mods.emplace_back(VR::get());
+    add(VR::get());
 
 #if defined(RE8) || defined(RE7)
-    m_mods.emplace_back(RE8VR::get());
+    add(RE8VR::get());
 #endif
 
 #ifndef RE8
 #if defined(RE2) || defined(RE3)
-    m_mods.emplace_back(FirstPerson::get());
+    add(FirstPerson::get());
 #endif
 #endif
 
     // All games!!!!
-    m_mods.emplace_back(std::make_unique<Camera>());
-    m_mods.emplace_back(std::make_unique<Graphics>());
+    add(std::make_unique<Camera>());
+    add(std::make_unique<Graphics>());
 
 #if defined(RE2) || defined(RE3) || defined(RE8)
-    m_mods.emplace_back(std::make_unique<ManualFlashlight>());
+    add(std::make_unique<ManualFlashlight>());
 #endif
 
-    m_mods.emplace_back(std::make_unique<FreeCam>());
+    add(std::make_unique<FreeCam>());
 
 #if TDB_VER > 49
-    m_mods.emplace_back(std::make_unique<SceneMods>());
+    add(std::make_unique<SceneMods>());
 #endif
 
 #endif
 
 #ifdef DEVELOPER
     auto dev_tools = std::make_shared<DeveloperTools>();
-    m_mods.emplace_back(dev_tools);
+    add(dev_tools);
 
-    for (auto& tool : dev_tools->get_tools()) {
-        m_mods.emplace_back(tool);
+    const auto& tools = dev_tools->get_tools();
+    const auto& tool_callbacks = dev_tools->get_tool_callbacks();
+
+    for (size_t i = 0; i < tools.size(); ++i) {
+        add(tools[i], tool_callbacks[i]);
     }
 #endif
 
-    m_mods.emplace_back(APIProxy::get());
-    m_mods.emplace_back(PluginLoader::get());
-    m_mods.emplace_back(ScriptRunner::get());
+    add(APIProxy::get());
+    add(PluginLoader::get());
+    add(ScriptRunner::get());
+}
+
+void Mods::add(std::shared_ptr<Mod> mod, const ModCallbacks& callbacks) {
+    for (size_t i = 0; i < (size_t)ModCallback::COUNT; ++i) {
+        if (callbacks.test(i)) {
+            m_subscribers[i].push_back(mod.get());
+        }
+    }
+
+    spdlog::info("{:s} subscribes to {} hooked callbacks", mod->get_name().data(), callbacks.count());
+
+    m_mods.emplace_back(std::move(mod));
 }
 
 std::optional<std::string> Mods::on_initialize() const {
@@ -125,3 +140,13 @@ void Mods::on_device_reset() const {
         mod->on_device_reset();
     }
 }
+
+const char* get_mod_callback_name(ModCallback callback) {
+    switch (callback) {
+#define X(id, fn) case ModCallback::id: return #fn;
+    FOR_EACH_MOD_CALLBACK(X)
+#undef X
+    default:
+        return "Unknown";
+    }
+}
@@ -1,9 +1,17 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+
 #include "Mod.hpp"
 
 class Mods {
 public:
+    struct DispatchStats {
+        std::atomic<uint64_t> dispatches{0}; // times the hook fired
+        std::atomic<uint64_t> calls{0};      // subscriber callbacks that were actually called
+    };
+
     Mods();
     virtual ~Mods() {}
 
@@ -20,6 +28,53 @@ public:
         return m_mods;
     }
 
+    // Mods that implement callback, in registration order
+    const std::vector<Mod*>& get_subscribers(ModCallback callback) const {
+        return m_subscribers[(size_t)callback];
+    }
+
+    // Same as get_subscribers, but counted in the dispatch stats while they're enabled. Used by the hooks.
+    const std::vector<Mod*>& dispatch(ModCallback callback) const {
+        const auto& subscribers = m_subscribers[(size_t)callback];
+
+        if (m_dispatch_stats_enabled.load(std::memory_order_relaxed)) {
+            auto& stats = m_dispatch_stats[(size_t)callback];
+
+            stats.dispatches.fetch_add(1, std::memory_order_relaxed);
+            stats.calls.fetch_add(subscribers.size(), std::memory_order_relaxed);
+        }
+
+        return subscribers;
+    }
+
+    const DispatchStats& get_dispatch_stats(ModCallback callback) const {
+        return m_dispatch_stats[(size_t)callback];
+    }
+
+    // Off by default, counting is two atomic adds per dispatch and some callbacks (update_transform)
+    // are dispatched from many threads at once. Turned on with the profiler.
+    void set_dispatch_stats_enabled(bool enabled) {
+        m_dispatch_stats_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
 private:
+    template <typename T>
+    void add(std::shared_ptr<T> mod) {
+        add(std::move(mod), detect_mod_callbacks<T>());
+    }
+
+    template <typename T>
+    void add(std::unique_ptr<T> mod) {
+        add(std::shared_ptr<T>{std::move(mod)});
+    }
+
+    void add(std::shared_ptr<Mod> mod, const ModCallbacks& callbacks);
+
     std::vector<std::shared_ptr<Mod>> m_mods;
-};
\ No newline at end of file
+    std::array<std::vector<Mod*>, (size_t)ModCallback::COUNT> m_subscribers{};
+
+    // Each on its own cache line, some of these are bumped from many threads at once
+    struct alignas(64) PaddedDispatchStats : DispatchStats {};
+    mutable std::array<PaddedDispatchStats, (size_t)ModCallback::COUNT> m_dispatch_stats{};
+    std::atomic<bool> m_dispatch_stats_enabled{false};
+};
@@ -25,12 +25,15 @@ extern "C" {
 #include "utility/Module.hpp"
 #include "utility/Patch.hpp"
 #include "utility/Scan.hpp"
+#include "utility/ScanBatch.hpp"
 #include "utility/Thread.hpp"
 
+#include "HookManager.hpp"
 #include "Mods.hpp"
 #include "mods/PluginLoader.hpp"
 #include "sdk/REGlobals.hpp"
 #include "sdk/Application.hpp"
+#include "sdk/MurmurHash.hpp"
 #include "sdk/SDK.hpp"
 
 #include "ExceptionHandler.hpp"
@@ -243,6 +246,10 @@ REFramework::REFramework(HMODULE reframework_module)
     spdlog::info("D3D12 loaded");
 #endif
 
+    // Signature scans from the last launch, rescanned in one pass if the game was updated.
+    // Has to wait until packed executables have been unpacked, otherwise the rescan finds nothing.
+    utility::load_scan_cache(m_game_module, get_persistent_dir("scan_cache.txt"));
+
 #if defined(MHRISE)
     utility::load_module_from_current_directory(L"openvr_api.dll");
     utility::load_module_from_current_directory(L"openxr_loader.dll");
@@ -565,6 +572,8 @@ void REFramework::on_post_present_d3d11() {
         mod->on_post_present();
     }
 
+    g_hookman.on_frame();
+
     if (m_last_present_time <= std::chrono::steady_clock::now()){
         m_last_present_time = std::chrono::steady_clock::now();
     }
@@ -716,6 +725,8 @@ void REFramework::on_post_present_d3d12() {
         mod->on_post_present();
     }
 
+    g_hookman.on_frame();
+
     if (m_last_present_time <= std::chrono::steady_clock::now()){
         m_last_present_time = std::chrono::steady_clock::now();
     }
@@ -1566,6 +1577,14 @@ bool REFramework::initialize_game_data() {
             }
 #endif
 
+            // Type lookups by name scan the whole TDB until this is done, so get it out of the way before the mods start looking.
+            if (const auto tdb = sdk::RETypeDB::get(); tdb != nullptr) {
+                tdb->build_type_index();
+            }
+
+            // The joint name hashes are computed natively, make sure they're still what the engine produces.
+            sdk::murmur_hash::verify_against_engine();
+
             m_mods = std::make_unique<Mods>();
 
             auto e = m_mods->on_initialize();
@@ -1595,6 +1614,7 @@ bool REFramework::initialize_game_data() {
 #if defined(MHRISE)
         utility::spoof_module_paths_in_exe_dir();
 #endif
+        utility::save_scan_cache();
         spdlog::info("Game data initialization thread finished");
     });
 
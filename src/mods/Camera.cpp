@@ -197,7 +197,8 @@ void Camera::set_vignette_brightness(float value) noexcept {
     }
 
     // Not a TDB method.
-    utility::re_managed_object::call_method((::REManagedObject*)m_tone_map, "setVignettingBrightness", (double)value);
+    MethodParams params{};
+    utility::re_managed_object::call_method((::REManagedObject*)m_tone_map, "setVignettingBrightness", (double)value, params);
 }
 
 void Camera::set_fov(float fov, float aiming_fov) noexcept {
@@ -5,11 +5,11 @@
 #include "DeveloperTools.hpp"
 
 DeveloperTools::DeveloperTools() {
-    m_tools.emplace_back(std::make_shared<ChainViewer>());
-    m_tools.emplace_back(std::make_shared<GameObjectsDisplay>());
+    add_tool(std::make_shared<ChainViewer>());
+    add_tool(std::make_shared<GameObjectsDisplay>());
     #ifndef _DEBUG
     // std::structs are not same as Release, this made crash
-    m_tools.emplace_back(ObjectExplorer::get());
+    add_tool(ObjectExplorer::get());
     #endif
 }
 
@@ -16,6 +16,18 @@ public:
         return m_tools;
     }
 
+    // Callbacks each tool implements, detected while we still know its type
+    const std::vector<ModCallbacks>& get_tool_callbacks() const {
+        return m_tool_callbacks;
+    }
+
 private:
+    template <typename T>
+    void add_tool(std::shared_ptr<T> tool) {
+        m_tools.emplace_back(tool);
+        m_tool_callbacks.emplace_back(detect_mod_callbacks<T>());
+    }
+
     std::vector<std::shared_ptr<Tool>> m_tools;
+    std::vector<ModCallbacks> m_tool_callbacks;
 };
\ No newline at end of file
@@ -604,7 +604,7 @@ bool FirstPerson::on_pre_flashlight_apply_transform(::REManagedObject* flashligh
         return true;
     }
 
-    static auto root_hash = sdk::murmur_hash::calc32("root");
+    static constexpr auto root_hash = sdk::murmur_hash::calc32_constexpr(L"root");
     static auto via_transform = sdk::find_type_definition("via.Transform");
     static auto via_transform_get_joint_by_hash = via_transform->get_method("getJointByHash");
 
@@ -797,8 +797,8 @@ void FirstPerson::update_player_arm_ik(RETransform* transform) {
 
     auto context = sdk::get_thread_context();
 
-    static auto l_arm_wrist_hash = sdk::murmur_hash::calc32(L"l_arm_wrist");
-    static auto r_arm_wrist_hash = sdk::murmur_hash::calc32(L"r_arm_wrist");
+    static constexpr auto l_arm_wrist_hash = sdk::murmur_hash::calc32_constexpr(L"l_arm_wrist");
+    static constexpr auto r_arm_wrist_hash = sdk::murmur_hash::calc32_constexpr(L"r_arm_wrist");
 
     static auto via_motion_def = sdk::find_type_definition("via.motion.Motion");
     const auto via_motion = utility::re_component::find<REComponent>(transform, via_motion_def->type);
@@ -1182,7 +1182,7 @@ void FirstPerson::update_player_muzzle_behavior(RETransform* transform, bool res
 
                     // Set the muzzle joint to the VFX muzzle position used for stuff like muzzle flashes
                     if (muzzle_joint_param != nullptr && muzzle_joint_extra != nullptr) {
-                        static auto vfx_muzzle1_hash = sdk::murmur_hash::calc32(L"vfx_muzzle1");
+                        static constexpr auto vfx_muzzle1_hash = sdk::murmur_hash::calc32_constexpr(L"vfx_muzzle1");
 
                         auto vfx_muzzle1 = sdk::get_transform_joint_by_hash(main_weapon_transform, vfx_muzzle1_hash);
                         auto current_muzzle_joint = *sdk::get_object_field<REJoint*>(muzzle_joint_extra, "_Parent");
@@ -1255,7 +1255,8 @@ void FirstPerson::update_player_body_ik(RETransform* transform, bool restore, bo
 
             sdk::call_object_func<void*>(ik_leg, "set_CenterPositionCtrl", sdk::get_thread_context(), ik_leg, via::motion::IkLeg::EffectorCtrl::None);
             sdk::call_object_func<void*>(ik_leg, "set_CenterOffset", sdk::get_thread_context(), ik_leg, &zero_offset);
-            utility::re_managed_object::call_method(ik_leg, "set_CenterAdjust", via::motion::IkLeg::CenterAdjust::Center);
+            MethodParams params{};
+            utility::re_managed_object::call_method(ik_leg, "set_CenterAdjust", via::motion::IkLeg::CenterAdjust::Center, params);
 
             return;
         }
@@ -1279,9 +1280,9 @@ void FirstPerson::update_player_body_ik(RETransform* transform, bool restore, bo
         const auto smooth_xz_movement = m_smooth_xz_movement->value();
         const auto smooth_y_movement = m_smooth_y_movement->value();
 
-        static auto cog_hash = sdk::murmur_hash::calc32(L"COG");
-        static auto head_hash = sdk::murmur_hash::calc32(L"head");
-        static auto root_hash = sdk::murmur_hash::calc32(L"root");
+        static constexpr auto cog_hash = sdk::murmur_hash::calc32_constexpr(L"COG");
+        static constexpr auto head_hash = sdk::murmur_hash::calc32_constexpr(L"head");
+        static constexpr auto root_hash = sdk::murmur_hash::calc32_constexpr(L"root");
 
         auto center_joint = sdk::get_transform_joint_by_hash(transform, cog_hash);
 
@@ -1324,7 +1325,8 @@ void FirstPerson::update_player_body_ik(RETransform* transform, bool restore, bo
         // so the head adjustment will be more accurate and smooth if the player is standing straight.
         // a small side effect is that the player can slightly float, but it's worth it.
         // not a TDB method unfortunately.
-        utility::re_managed_object::call_method(ik_leg, "set_CenterAdjust", via::motion::IkLeg::CenterAdjust::None);
+        MethodParams params{};
+        utility::re_managed_object::call_method(ik_leg, "set_CenterAdjust", via::motion::IkLeg::CenterAdjust::None, params);
         update_player_arm_ik(transform);
     }
 }
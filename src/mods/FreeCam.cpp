@@ -311,7 +311,7 @@ void FreeCam::on_pre_application_entry(void* entry, const char* name, size_t has
                 return;
             }
 
-            auto standard_skip_pre_fn = [this](std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr) -> HookManager::PreHookResult {
+            auto standard_skip_pre_fn = [this](std::span<uintptr_t> args, std::span<sdk::RETypeDefinition*> arg_tys, uintptr_t ret_addr) -> HookManager::PreHookResult {
                 if (!m_enabled->value() || !m_disable_movement->value()) {
                     return HookManager::PreHookResult::CALL_ORIGINAL;
                 }
@@ -356,7 +356,7 @@ void FreeCam::on_pre_application_entry(void* entry, const char* name, size_t has
 
                 if (get_past_frame_move_dir_fn != nullptr) {
                     m_player_body_updater_hook.get_past_move_frame_move_dir_vec_id = g_hookman.add(get_past_frame_move_dir_fn,
-                        [this](std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr) -> HookManager::PreHookResult {
+                        [this](std::span<uintptr_t> args, std::span<sdk::RETypeDefinition*> arg_tys, uintptr_t ret_addr) -> HookManager::PreHookResult {
                             if (!m_enabled->value() || !m_disable_movement->value()) {
                                 return HookManager::PreHookResult::CALL_ORIGINAL;
                             }
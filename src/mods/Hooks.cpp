@@ -4,8 +4,11 @@
 #include <utility/Module.hpp>
 #include <utility/String.hpp>
 #include <utility/Memory.hpp>
+#include <utility/ScanBatch.hpp>
 
 #include "sdk/Application.hpp"
+#include "sdk/Renderer.hpp"
+#include "sdk/SceneSnapshot.hpp"
 
 #include "Hooks.hpp"
 
@@ -29,14 +32,23 @@ std::optional<std::string> Hooks::on_initialize() {
         return "Unable to get module size";
     }
 
-    for (auto hook : m_hook_list) {
-        spdlog::info("[Hooks] Entering hook...");
+    {
+        // The hooks only go live once every one of them has been created, with one thread freeze.
+        FunctionHook::Batch batch{};
 
-        auto result = hook();
+        for (auto hook : m_hook_list) {
+            spdlog::info("[Hooks] Entering hook...");
 
-        // Error occurred when hooking
-        if (result) {
-            return result;
+            auto result = hook();
+
+            // Error occurred when hooking
+            if (result) {
+                return result;
+            }
+        }
+
+        if (!batch.commit()) {
+            return "Failed to apply hooks";
         }
     }
 
@@ -50,12 +62,53 @@ void Hooks::on_draw_ui() {
         return;
     }
 
-    ImGui::Checkbox("Enable Profiling", &m_profiling_enabled);
+    if (ImGui::Checkbox("Enable Profiling", &m_profiling_enabled)) {
+        g_framework->get_mods()->set_dispatch_stats_enabled(m_profiling_enabled);
+    }
 
     if (!m_profiling_enabled) {
         return;
     }
 
+    if (ImGui::TreeNode("Callback Dispatch")) {
+        const auto& mods = g_framework->get_mods();
+        const auto num_mods = mods->get_mods().size();
+
+        // Only counted while profiling is enabled.
+        // Calls Skipped is what it would have cost to call every mod, like we used to
+        if (ImGui::BeginTable("Callback Dispatch", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders)) {
+            ImGui::TableSetupColumn("Callback");
+            ImGui::TableSetupColumn("Subscribers");
+            ImGui::TableSetupColumn("Dispatches");
+            ImGui::TableSetupColumn("Calls");
+            ImGui::TableSetupColumn("Calls Skipped");
+            ImGui::TableHeadersRow();
+
+            for (size_t i = 0; i < (size_t)ModCallback::COUNT; ++i) {
+                const auto callback = (ModCallback)i;
+                const auto& stats = mods->get_dispatch_stats(callback);
+                const auto dispatches = stats.dispatches.load(std::memory_order_relaxed);
+                const auto calls = stats.calls.load(std::memory_order_relaxed);
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(get_mod_callback_name(callback));
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu", mods->get_subscribers(callback).size());
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", dispatches);
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", calls);
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", dispatches * num_mods - calls);
+            }
+
+            ImGui::EndTable();
+        }
+
+        ImGui::TreePop();
+    }
+
     ImGui::Text("Application Entry Times");
 
     std::vector<const char*> sorted_times{};
@@ -97,15 +150,15 @@ void Hooks::on_draw_ui() {
     }
 }
 
-#define LAYER_HOOK_BODY(x, x2, x3) \
+#define LAYER_HOOK_BODY(x, x2, x3, x_upper, x3_upper) \
 if (!g_framework->is_ready()) {\
     auto original_func = g_hook->m_layer_hooks.##x##.##x3##_hook->get_original<decltype(RenderLayerHook<sdk::renderer::layer::##x2##>::##x3##)>();\
     original_func(layer, render_ctx); \
     return; \
 } \
 bool any_false = false; \
-const auto& mods = g_framework->get_mods()->get_mods(); \
-for (auto& mod : mods) { \
+const auto& mods = g_framework->get_mods(); \
+for (auto mod : mods->dispatch(ModCallback::PRE_##x_upper##_LAYER_##x3_upper)) { \
     const auto result = mod->on_pre_##x##_layer_##x3##(layer, render_ctx); \
     if (!result) { \
         any_false = true; \
@@ -115,32 +168,50 @@ if (!any_false) { \
     auto original_func = g_hook->m_layer_hooks.##x##.##x3##_hook->get_original<decltype(RenderLayerHook<sdk::renderer::layer::##x2##>::##x3##)>();\
     original_func(layer, render_ctx); \
 } \
-for (auto& mod : mods) { \
+for (auto mod : mods->dispatch(ModCallback::x_upper##_LAYER_##x3_upper)) { \
     mod->on_##x##_layer_##x3##(layer, render_ctx); \
 }
 
 void Hooks::RenderLayerHook<sdk::renderer::layer::Scene>::update(sdk::renderer::layer::Scene* layer, void* render_ctx) {
-    LAYER_HOOK_BODY(scene, Scene, update);
+    LAYER_HOOK_BODY(scene, Scene, update, SCENE, UPDATE);
 }
 
 void Hooks::RenderLayerHook<sdk::renderer::layer::Scene>::draw(sdk::renderer::layer::Scene* layer, void* render_ctx) {
-    LAYER_HOOK_BODY(scene, Scene, draw);
+    LAYER_HOOK_BODY(scene, Scene, draw, SCENE, DRAW);
 }
 
 void Hooks::RenderLayerHook<sdk::renderer::layer::PostEffect>::update(sdk::renderer::layer::PostEffect* layer, void* render_ctx) {
-    LAYER_HOOK_BODY(post_effect, PostEffect, update);
+    LAYER_HOOK_BODY(post_effect, PostEffect, update, POST_EFFECT, UPDATE);
 }
 
 void Hooks::RenderLayerHook<sdk::renderer::layer::PostEffect>::draw(sdk::renderer::layer::PostEffect* layer, void* render_ctx) {
-    LAYER_HOOK_BODY(post_effect, PostEffect, draw);
+    LAYER_HOOK_BODY(post_effect, PostEffect, draw, POST_EFFECT, DRAW);
 }
 
 void Hooks::RenderLayerHook<sdk::renderer::layer::Overlay>::update(sdk::renderer::layer::Overlay* layer, void* render_ctx) {
-    LAYER_HOOK_BODY(overlay, Overlay, update);
+    LAYER_HOOK_BODY(overlay, Overlay, update, OVERLAY, UPDATE);
 }
 
 void Hooks::RenderLayerHook<sdk::renderer::layer::Overlay>::draw(sdk::renderer::layer::Overlay* layer, void* render_ctx) {
-    LAYER_HOOK_BODY(overlay, Overlay, draw);
+    LAYER_HOOK_BODY(overlay, Overlay, draw, OVERLAY, DRAW);
+}
+
+namespace {
+struct TransformPattern {
+    utility::CachedScan pat;
+    uint32_t offset;
+};
+
+// Namespace scope so they're all found in the same pass as the other startup scans, see utility::CachedScan
+const std::vector<TransformPattern> update_transform_patterns {
+    { "E8 ? ? ? ? 48 8B 5B ? 48 85 DB 75 ? 48 8B 4D 40 48 ? ?", 1 }, // RE2 - MHRise v1.0
+    { "33 D2 E8 ? ? ? ? B8 01 00 00 00 F0 0F", 3 }, // RE7/RE2/RE3 update to TDB v70/newer games?
+    { "0F B6 D1 48 8B CB E8 ? ? ? ? 48 8B 9B ? ? ? ?", 7 }, // RE7
+    { "0F B6 D0 48 8B CB E8 ? ? ? ? 48 8B 9B ? ? ? ?", 7 } // RE7 Demo
+};
+
+const utility::CachedScan gui_draw_call_pattern{"49 8B 0C CE 48 83 79 10 00 74 ? E8 ? ? ? ?"};
+const utility::CachedScan gui_draw_call_fallback_pattern{"49 8B 0C CE 48 83 79 20 00 74 ? E8 ? ? ? ?"}; // RE7
 }
 
 std::optional<std::string> Hooks::hook_update_transform() {
@@ -162,22 +233,10 @@ std::optional<std::string> Hooks::hook_update_transform() {
         sub_141DD4140(v14, 0i64, v10);
     */
 
-    struct TransformPattern {
-        std::string pat;
-        uint32_t offset;
-    };
-
-    std::vector<TransformPattern> pats {
-        { "E8 ? ? ? ? 48 8B 5B ? 48 85 DB 75 ? 48 8B 4D 40 48 ? ?", 1 }, // RE2 - MHRise v1.0
-        { "33 D2 E8 ? ? ? ? B8 01 00 00 00 F0 0F", 3 }, // RE7/RE2/RE3 update to TDB v70/newer games?
-        { "0F B6 D1 48 8B CB E8 ? ? ? ? 48 8B 9B ? ? ? ?", 7 }, // RE7
-        { "0F B6 D0 48 8B CB E8 ? ? ? ? 48 8B 9B ? ? ? ?", 7 } // RE7 Demo
-    };
-
     uintptr_t update_transform = 0;
 
-    for (auto& pat : pats) {
-        auto result = utility::scan(game, pat.pat.c_str());
+    for (auto& pat : update_transform_patterns) {
+        auto result = utility::scan_cached(game, pat.pat);
 
         if (result) {
             update_transform = utility::calculate_absolute(*result + pat.offset);
@@ -285,12 +344,12 @@ std::optional<std::string> Hooks::hook_gui_draw() {
     *(_QWORD *)&v35 = draw_task_function; <-- "gui_draw_call" is found within this function.
     */
     spdlog::info("[Hooks] Scanning for first GUI draw call...");
-    auto gui_draw_call = utility::scan(game, "49 8B 0C CE 48 83 79 10 00 74 ? E8 ? ? ? ?");
+    auto gui_draw_call = utility::scan_cached(game, gui_draw_call_pattern);
 
     if (!gui_draw_call) {
         spdlog::info("[Hooks] Scanning for fallback GUI draw call...");
         // RE7 (+0x20 grabs the owner ptr, 0x10 in others)
-        gui_draw_call = utility::scan(game, "49 8B 0C CE 48 83 79 20 00 74 ? E8 ? ? ? ?");
+        gui_draw_call = utility::scan_cached(game, gui_draw_call_fallback_pattern);
 
         if (!gui_draw_call) {
             return "Unable to find gui_draw_call pattern.";
@@ -692,15 +751,21 @@ void* Hooks::update_transform_hook_internal(RETransform* t, uint8_t a2, uint32_t
         return m_update_transform_hook->get_original<decltype(update_transform_hook)>()(t, a2, a3);
     }
 
-    auto& mods = g_framework->get_mods()->get_mods();
+    const auto& mods = g_framework->get_mods();
+    const auto& pre_subscribers = mods->dispatch(ModCallback::PRE_UPDATE_TRANSFORM);
+    const auto& post_subscribers = mods->dispatch(ModCallback::UPDATE_TRANSFORM);
 
-    for (auto& mod : mods) {
+    if (pre_subscribers.empty() && post_subscribers.empty()) {
+        return m_update_transform_hook->get_original<decltype(update_transform_hook)>()(t, a2, a3);
+    }
+
+    for (auto mod : pre_subscribers) {
         mod->on_pre_update_transform(t);
     }
 
     auto ret = m_update_transform_hook->get_original<decltype(update_transform_hook)>()(t, a2, a3);
 
-    for (auto& mod : mods) {
+    for (auto mod : post_subscribers) {
         mod->on_update_transform(t);
     }
 
@@ -716,15 +781,15 @@ void* Hooks::update_camera_controller_hook_internal(void* a1, RopewayPlayerCamer
         return m_update_camera_controller_hook->get_original<decltype(update_camera_controller_hook)>()(a1, camera_controller);
     }
 
-    auto& mods = g_framework->get_mods()->get_mods();
+    const auto& mods = g_framework->get_mods();
 
-    for (auto& mod : mods) {
+    for (auto mod : mods->dispatch(ModCallback::PRE_UPDATE_CAMERA_CONTROLLER)) {
         mod->on_pre_update_camera_controller(camera_controller);
     }
 
     auto ret = m_update_camera_controller_hook->get_original<decltype(update_camera_controller_hook)>()(a1, camera_controller);
 
-    for (auto& mod : mods) {
+    for (auto mod : mods->dispatch(ModCallback::UPDATE_CAMERA_CONTROLLER)) {
         mod->on_update_camera_controller(camera_controller);
     }
 
@@ -740,15 +805,15 @@ void* Hooks::update_camera_controller2_hook_internal(void* a1, RopewayPlayerCame
         return m_update_camera_controller2_hook->get_original<decltype(update_camera_controller2_hook)>()(a1, camera_controller);
     }
 
-    auto& mods = g_framework->get_mods()->get_mods();
+    const auto& mods = g_framework->get_mods();
 
-    for (auto& mod : mods) {
+    for (auto mod : mods->dispatch(ModCallback::PRE_UPDATE_CAMERA_CONTROLLER2)) {
         mod->on_pre_update_camera_controller2(camera_controller);
     }
 
     auto ret = m_update_camera_controller2_hook->get_original<decltype(update_camera_controller2_hook)>()(a1, camera_controller);
 
-    for (auto& mod : mods) {
+    for (auto mod : mods->dispatch(ModCallback::UPDATE_CAMERA_CONTROLLER2)) {
         mod->on_update_camera_controller2(camera_controller);
     }
 
@@ -766,11 +831,17 @@ void* Hooks::gui_draw_hook_internal(REComponent* gui_element, void* primitive_co
         return original_func(gui_element, primitive_context);
     }
 
-    auto& mods = g_framework->get_mods()->get_mods();
+    const auto& mods = g_framework->get_mods();
+    const auto& pre_subscribers = mods->dispatch(ModCallback::PRE_GUI_DRAW_ELEMENT);
+    const auto& post_subscribers = mods->dispatch(ModCallback::GUI_DRAW_ELEMENT);
+
+    if (pre_subscribers.empty() && post_subscribers.empty()) {
+        return original_func(gui_element, primitive_context);
+    }
 
     bool any_false = false;
 
-    for (auto& mod : mods) {
+    for (auto mod : pre_subscribers) {
         if (!mod->on_pre_gui_draw_element(gui_element, primitive_context)) {
             any_false = true;
         }
@@ -782,7 +853,7 @@ void* Hooks::gui_draw_hook_internal(REComponent* gui_element, void* primitive_co
         ret = original_func(gui_element, primitive_context);
     }
 
-    for (auto& mod : mods) {
+    for (auto mod : post_subscribers) {
         mod->on_gui_draw_element(gui_element, primitive_context);
     }
 
@@ -800,15 +871,15 @@ void Hooks::update_before_lock_scene_hook_internal(void* ctx) {
         return original(ctx);
     }
 
-    auto& mods = g_framework->get_mods()->get_mods();
+    const auto& mods = g_framework->get_mods();
 
-    for (auto& mod : mods) {
+    for (auto mod : mods->dispatch(ModCallback::PRE_UPDATE_BEFORE_LOCK_SCENE)) {
         mod->on_pre_update_before_lock_scene(ctx);
     }
 
     original(ctx);
 
-    for (auto& mod : mods) {
+    for (auto mod : mods->dispatch(ModCallback::UPDATE_BEFORE_LOCK_SCENE)) {
         mod->on_update_before_lock_scene(ctx);
     }
 }
@@ -824,15 +895,15 @@ void Hooks::lightshaft_draw_hook_internal(void* shaft, void* render_context) {
         return original(shaft, render_context);
     }
 
-    auto& mods = g_framework->get_mods()->get_mods();
+    const auto& mods = g_framework->get_mods();
 
-    for (auto& mod : mods) {
+    for (auto mod : mods->dispatch(ModCallback::PRE_LIGHTSHAFT_DRAW)) {
         mod->on_pre_lightshaft_draw(shaft, render_context);
     }
 
     original(shaft, render_context);
 
-    for (auto& mod : mods) {
+    for (auto mod : mods->dispatch(ModCallback::LIGHTSHAFT_DRAW)) {
         mod->on_lightshaft_draw(shaft, render_context);
     }
 }
@@ -862,13 +933,15 @@ void Hooks::global_application_entry_hook_internal(void* entry, const char* name
         Hooks::ApplicationEntryData profiler_entry{};
         
         auto now = std::chrono::high_resolution_clock::now();
-        auto& mods = g_framework->get_mods()->get_mods();
+        const auto& mods = g_framework->get_mods();
 
         if (hash == "BeginRendering"_fnv) {
+            sdk::renderer::update_camera_snapshot();
+            sdk::advance_scene_snapshot_frame();
             g_framework->run_imgui_frame(false);
         }
 
-        for (auto& mod : mods) {
+        for (auto mod : mods->dispatch(ModCallback::PRE_APPLICATION_ENTRY)) {
             mod->on_pre_application_entry(entry, name, hash);
         }
 
@@ -882,7 +955,7 @@ void Hooks::global_application_entry_hook_internal(void* entry, const char* name
 
         now = std::chrono::high_resolution_clock::now();
 
-        for (auto& mod : mods) {
+        for (auto mod : mods->dispatch(ModCallback::APPLICATION_ENTRY)) {
             mod->on_application_entry(entry, name, hash);
         }
 
@@ -892,18 +965,20 @@ void Hooks::global_application_entry_hook_internal(void* entry, const char* name
         m_application_entry_times[name] = profiler_entry;
     } else {
         if (hash == "BeginRendering"_fnv) {
+            sdk::renderer::update_camera_snapshot();
+            sdk::advance_scene_snapshot_frame();
             g_framework->run_imgui_frame(false);
         }
 
-        auto& mods = g_framework->get_mods()->get_mods();
+        const auto& mods = g_framework->get_mods();
 
-        for (auto& mod : mods) {
+        for (auto mod : mods->dispatch(ModCallback::PRE_APPLICATION_ENTRY)) {
             mod->on_pre_application_entry(entry, name, hash);
         }
         
         original(entry);
 
-        for (auto& mod : mods) {
+        for (auto mod : mods->dispatch(ModCallback::APPLICATION_ENTRY)) {
             mod->on_application_entry(entry, name, hash);
         }
     }
@@ -914,9 +989,9 @@ void Hooks::global_application_entry_hook(void* entry, const char* name, size_t
 }
 
 float* Hooks::view_get_size_hook_internal(REManagedObject* scene_view, float* result) {
-    const auto& mods = g_framework->get_mods()->get_mods();
+    const auto& mods = g_framework->get_mods();
 
-    for (auto& mod : mods) {
+    for (auto mod : mods->dispatch(ModCallback::PRE_VIEW_GET_SIZE)) {
         mod->on_pre_view_get_size(scene_view, result);
     }
 
@@ -924,7 +999,7 @@ float* Hooks::view_get_size_hook_internal(REManagedObject* scene_view, float* re
 
     auto ret = original(scene_view, result);
 
-    for (auto& mod : mods) {
+    for (auto mod : mods->dispatch(ModCallback::VIEW_GET_SIZE)) {
         mod->on_view_get_size(scene_view, result);
     }
 
@@ -936,9 +1011,9 @@ float* Hooks::view_get_size_hook(REManagedObject* scene_view, float* result) {
 }
 
 Matrix4x4f* Hooks::camera_get_projection_matrix_hook_internal(REManagedObject* camera, Matrix4x4f* result) {
-    const auto& mods = g_framework->get_mods()->get_mods();
+    const auto& mods = g_framework->get_mods();
 
-    for (auto& mod : mods) {
+    for (auto mod : mods->dispatch(ModCallback::PRE_CAMERA_GET_PROJECTION_MATRIX)) {
         mod->on_pre_camera_get_projection_matrix(camera, result);
     }
 
@@ -946,7 +1021,7 @@ Matrix4x4f* Hooks::camera_get_projection_matrix_hook_internal(REManagedObject* c
 
     auto ret = original(camera, result);
 
-    for (auto& mod : mods) {
+    for (auto mod : mods->dispatch(ModCallback::CAMERA_GET_PROJECTION_MATRIX)) {
         mod->on_camera_get_projection_matrix(camera, result);
     }
 
@@ -958,9 +1033,9 @@ Matrix4x4f* Hooks::camera_get_projection_matrix_hook(REManagedObject* camera, Ma
 }
 
 Matrix4x4f* Hooks::camera_get_view_matrix_hook_internal(REManagedObject* camera, Matrix4x4f* result) {
-    const auto& mods = g_framework->get_mods()->get_mods();
+    const auto& mods = g_framework->get_mods();
 
-    for (auto& mod : mods) {
+    for (auto mod : mods->dispatch(ModCallback::PRE_CAMERA_GET_VIEW_MATRIX)) {
         mod->on_pre_camera_get_view_matrix(camera, result);
     }
 
@@ -968,7 +1043,7 @@ Matrix4x4f* Hooks::camera_get_view_matrix_hook_internal(REManagedObject* camera,
 
     auto ret = original(camera, result);
 
-    for (auto& mod : mods) {
+    for (auto mod : mods->dispatch(ModCallback::CAMERA_GET_VIEW_MATRIX)) {
         mod->on_camera_get_view_matrix(camera, result);
     }
 
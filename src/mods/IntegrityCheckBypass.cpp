@@ -3,6 +3,7 @@
 
 #include "utility/Module.hpp"
 #include "utility/Scan.hpp"
+#include "utility/ScanBatch.hpp"
 
 #include "sdk/RETypeDB.hpp"
 
@@ -11,78 +12,90 @@
 #include "IntegrityCheckBypass.hpp"
 
 struct IntegrityCheckPattern {
-    std::string pat{};
+    utility::CachedScan pat;
     uint32_t offset{};
 };
 
-std::optional<std::string> IntegrityCheckBypass::on_initialize() {
-    // Patterns for assigning or accessing of the integrity check boolean (RE3)
-    // and for jumping past the integrity checks (RE8)
-    // In RE8, the integrity checks cause a noticeable stutter as well.
-    std::vector<IntegrityCheckPattern> possible_patterns {
+namespace {
+// Patterns for assigning or accessing of the integrity check boolean (RE3)
+// and for jumping past the integrity checks (RE8)
+// In RE8, the integrity checks cause a noticeable stutter as well.
+const std::vector<IntegrityCheckPattern> possible_patterns {
 #ifdef RE3
-        /*
-        cmp     qword ptr [rax+18h], 0
-        cmovz   ecx, r15d
-        mov     cs:bypass_integrity_checks, cl*/
-        // Referenced above "steam_api64.dll"
-        {"48 ? ? 18 00 41 ? ? ? 88 0D ? ? ? ?", 11}, 
-        {"48 ? ? 18 00 0F ? ? 88 0D ? ? ? ? 49 ? ? ? 48", 10},
+    /*
+    cmp     qword ptr [rax+18h], 0
+    cmovz   ecx, r15d
+    mov     cs:bypass_integrity_checks, cl*/
+    // Referenced above "steam_api64.dll"
+    {"48 ? ? 18 00 41 ? ? ? 88 0D ? ? ? ?", 11}, 
+    {"48 ? ? 18 00 0F ? ? 88 0D ? ? ? ? 49 ? ? ? 48", 10},
 #elif defined(RE8)
-        /*
-        These are partially obfuscated and are within protected sections.
-        The ja jumps past the checksum checks which cause very large stutters if they are ran.
-        We'll replace the ja to always jump past the checksum checks.
-
-        There are various patterns here because the code is obfuscated, there's an element of randomness per update.
-        Lots of random junk code. Some instructions are obfuscated into multiple instructions as well.
-        We're taking a shot in the dark here hoping that the obfuscated code
-        stays generally the same past a game update.
-        */
-
-        /*
-        sub     eax, ecx
-        ja      NO_CHECKSUM_CHECKS1
-        mov     eax, [rsp+whatever]
-        */
-        // app.PlayerCore.onDamage, app.EnemyCore.onDie2 (onDie2 gets called from onDie)
-        {"29 c8 0f 87 ? ? ? ? 8b 84", 2},
-
-        /*
-        sub     eax, ecx
-        ja      NO_CHECKSUM_CHECKS2
+    /*
+    These are partially obfuscated and are within protected sections.
+    The ja jumps past the checksum checks which cause very large stutters if they are ran.
+    We'll replace the ja to always jump past the checksum checks.
+
+    There are various patterns here because the code is obfuscated, there's an element of randomness per update.
+    Lots of random junk code. Some instructions are obfuscated into multiple instructions as well.
+    We're taking a shot in the dark here hoping that the obfuscated code
+    stays generally the same past a game update.
+    */
+
+    /*
+    sub     eax, ecx
+    ja      NO_CHECKSUM_CHECKS1
+    mov     eax, [rsp+whatever]
+    */
+    // app.PlayerCore.onDamage, app.EnemyCore.onDie2 (onDie2 gets called from onDie)
+    {"29 c8 0f 87 ? ? ? ? 8b 84", 2},
+
+    /*
+    sub     eax, ecx
+    ja      NO_CHECKSUM_CHECKS2
 .       xor     eax, eax
-        sub     eax, [rsp+whatever]
-        */
-        // app.PlayerCore.onDamage #2
-        {"29 c8 0f 87 ? ? ? ? 31 C0 2B", 2},
-
-        /*
-        mov     eax, [rsp+whatever]
-        sub     eax, ecx
-        ja      NO_CHECKSUM_CHECKS3
-        xor     eax, eax
-        */
-        // app.PlayerCore.onDamage #3, app.EnemyCore.onDie2 #2
-        {"8b 84 ? ? ? ? ? 29 c8 0f 87 ? ? ? ?", 9},
-        /* 
-        There is another one inside of app.GlobalService.msgSceneTransition_afterDeactivate
-        but didn't bother to patch it out. Reason being that it seems to only get called when loading is finished. 
-        Maybe some more investigation is required here?
-        */
-        // The above function names can be found within il2cpp_dump.json, which is dumped with REFramework's "Dump SDK" button in developer mode.
+    sub     eax, [rsp+whatever]
+    */
+    // app.PlayerCore.onDamage #2
+    {"29 c8 0f 87 ? ? ? ? 31 C0 2B", 2},
+
+    /*
+    mov     eax, [rsp+whatever]
+    sub     eax, ecx
+    ja      NO_CHECKSUM_CHECKS3
+    xor     eax, eax
+    */
+    // app.PlayerCore.onDamage #3, app.EnemyCore.onDie2 #2
+    {"8b 84 ? ? ? ? ? 29 c8 0f 87 ? ? ? ?", 9},
+    /* 
+    There is another one inside of app.GlobalService.msgSceneTransition_afterDeactivate
+    but didn't bother to patch it out. Reason being that it seems to only get called when loading is finished. 
+    Maybe some more investigation is required here?
+    */
+    // The above function names can be found within il2cpp_dump.json, which is dumped with REFramework's "Dump SDK" button in developer mode.
 #endif
-    };
+};
 
+// Scanned while the game is suspended at startup (see the REENGINE_AT block in REFramework.cpp)
+// sub rax, 128E329h, present in MHRise and RE8.
+const utility::CachedScan sussy_constant_pattern{"29 E3 28 01", true};
+const utility::CachedScan sussy_pattern_2{"E8 ? ? ? ? 3D F2 01 00 00 0F 84 ? ? ? ? 48 8D 0D ? ? ? ? E8"};
+const utility::CachedScan sussy_pattern_3{"8D ? 02 E8 ? ? ? ? 0F B6 C8 48 ? ? 50 48 ? ? 18 0F"};
+const utility::CachedScan sussy_pattern_3_alternative{"8D ? 05 E8 ? ? ? ? 0F B6 C8 48 ? ? 50 48 ? ? 18 0F"};
+const utility::CachedScan sussy_pattern_4{"72 ? 41 8B ? E8 ? ? ? ? 0F B6 C8 48 ? ? 50 48 ? ? 18 0F"};
+const utility::CachedScan conditional_jmp_pattern{"48 8B 8D D0 03 00 00 48 29 C1 75 ?"};
+const utility::CachedScan stack_destroyer_pattern{"48 89 11 48 c7 04 24 00 00 00 00 48 81 c4 28 01 00 00"};
+}
+
+std::optional<std::string> IntegrityCheckBypass::on_initialize() {
     std::unordered_set<uintptr_t> already_patched{};
 
     const auto module_size = *utility::get_module_size(g_framework->get_module().as<HMODULE>());
     const auto module_end = g_framework->get_module() + module_size;
 
     for (auto& possible_pattern : possible_patterns) {
-        spdlog::info("Scanning for {}", possible_pattern.pat);
+        spdlog::info("Scanning for {}", possible_pattern.pat.pattern());
 
-        auto integrity_check_ref = utility::scan(g_framework->get_module().as<HMODULE>(), possible_pattern.pat);
+        auto integrity_check_ref = utility::scan_cached(g_framework->get_module().as<HMODULE>(), possible_pattern.pat);
 
         if (!integrity_check_ref) {
             continue;
@@ -317,26 +330,28 @@ void IntegrityCheckBypass::immediate_patch_re8() {
     const auto game_size = utility::get_module_size(game).value_or(0);
     const auto game_end = (uintptr_t)game + game_size;
 
-    // Present in MHRise and RE8.
+    bool patched_sussy1 = false;
+
     // sub rax, 128E329h
-    const uint32_t sussy_constant = 0x128E329;
-    std::optional<uintptr_t> sussy_result{};
+    const auto sussy_results = utility::scan_all_cached(game, sussy_constant_pattern);
 
-    bool patched_sussy1 = false;
+    for (size_t i = 0; i < sussy_results.size(); ++i) {
+        const auto sussy_result = sussy_results[i];
+
+        // Anything after the first result has to end 0x100 bytes short of the end of the module
+        if (i > 0 && sussy_result + 4 > game_end - 0x100) {
+            break;
+        }
 
-    for (sussy_result = utility::scan_data(game, (const uint8_t*)&sussy_constant, sizeof(sussy_constant)); 
-         sussy_result.has_value(); 
-         sussy_result = utility::scan_data(*sussy_result + 1, (game_end - (*sussy_result + 1)) - 0x100, (const uint8_t*)&sussy_constant, sizeof(sussy_constant)))
-    {
         // Find the start of the instruction, given the sussy_constant is in the middle of it.
-        const auto resolved_instruction = utility::resolve_instruction(*sussy_result);
+        const auto resolved_instruction = utility::resolve_instruction(sussy_result);
 
         // If this instruction didn't get resolved, go onto the next one. We probably ran into garbage data.
         if (resolved_instruction) {
             const auto sussy_function_start = utility::find_function_start(resolved_instruction->addr);
 
             if (!sussy_function_start) {
-                spdlog::error("[IntegrityCheckBypass]: Could not find function start for sussy_constant @ 0x{:x}", *sussy_result);
+                spdlog::error("[IntegrityCheckBypass]: Could not find function start for sussy_constant @ 0x{:x}", sussy_result);
                 continue;
             }
 
@@ -361,7 +376,7 @@ void IntegrityCheckBypass::immediate_patch_re8() {
         lea     rcx, ProtectionGlobalContext
         call    ProtectionTripResult
     */
-    const auto sussy_result_2 = utility::scan(game, "E8 ? ? ? ? 3D F2 01 00 00 0F 84 ? ? ? ? 48 8D 0D ? ? ? ? E8");
+    const auto sussy_result_2 = utility::scan_cached(game, sussy_pattern_2);
 
     if (sussy_result_2) {
         const auto sussy_function_start = utility::find_function_start(sussy_result_2.value());
@@ -380,14 +395,14 @@ void IntegrityCheckBypass::immediate_patch_re8() {
     // and stuff like DLC loading gets skipped so it needs to always return 0
     // there are really obvious constants to go off of within these functions
     // but they look like they might be auto generated so can't rely on them
-    const auto sussy_result_3 = utility::scan(game, "8D ? 02 E8 ? ? ? ? 0F B6 C8 48 ? ? 50 48 ? ? 18 0F");
+    const auto sussy_result_3 = utility::scan_cached(game, sussy_pattern_3);
 
     if (sussy_result_3) {
         const auto func = utility::calculate_absolute(*sussy_result_3 + 4);
         static auto patch = Patch::create(func, { 0xB0, 0x00, 0xC3 }, true);
         spdlog::info("[IntegrityCheckBypass]: Patched sussy_function 3");
     } else {
-        const auto sussy_result_alternative = utility::scan(game, "8D ? 05 E8 ? ? ? ? 0F B6 C8 48 ? ? 50 48 ? ? 18 0F");
+        const auto sussy_result_alternative = utility::scan_cached(game, sussy_pattern_3_alternative);
 
         if (sussy_result_alternative) {
             const auto func = utility::calculate_absolute(*sussy_result_alternative + 4);
@@ -398,7 +413,7 @@ void IntegrityCheckBypass::immediate_patch_re8() {
         }
     }
 
-    const auto sussy_result_4 = utility::scan(game, "72 ? 41 8B ? E8 ? ? ? ? 0F B6 C8 48 ? ? 50 48 ? ? 18 0F");
+    const auto sussy_result_4 = utility::scan_cached(game, sussy_pattern_4);
 
     if (sussy_result_4) {
         const auto func = utility::calculate_absolute(*sussy_result_4 + 6);
@@ -420,7 +435,7 @@ void IntegrityCheckBypass::immediate_patch_re4() {
     spdlog::info("[IntegrityCheckBypass]: Scanning RE4...");
 
     const auto game = utility::get_executable();
-    const auto conditional_jmp_block = utility::scan(game, "48 8B 8D D0 03 00 00 48 29 C1 75 ?");
+    const auto conditional_jmp_block = utility::scan_cached(game, conditional_jmp_pattern);
 
     if (!conditional_jmp_block) {
         spdlog::error("[IntegrityCheckBypass]: Could not find conditional_jmp!");
@@ -439,7 +454,7 @@ void IntegrityCheckBypass::remove_stack_destroyer() {
     spdlog::info("[IntegrityCheckBypass]: Searching for stack destroyer...");
 
     const auto game = utility::get_executable();
-    const auto fn = utility::scan(game, "48 89 11 48 c7 04 24 00 00 00 00 48 81 c4 28 01 00 00");
+    const auto fn = utility::scan_cached(game, stack_destroyer_pattern);
 
     if (!fn) {
         spdlog::error("[IntegrityCheckBypass]: Could not find stack destroyer!");
@@ -53,6 +53,36 @@ bool is_drawing_ui() {
 }
 }
 
+namespace detail {
+// The plugin's callbacks for one hook, passed as the userdata of a raw HookManager hook.
+// The trampolines forward straight to the plugin, no std::function in between.
+struct PluginHook {
+    REFPreHookFn pre_fn{};
+    REFPostHookFn post_fn{};
+    REFPreHookWithUserdataFn pre_fn_with_userdata{};
+    REFPostHookWithUserdataFn post_fn_with_userdata{};
+    void* userdata{};
+
+    static HookManager::PreHookResult pre(void* hook, std::span<uintptr_t> args, std::span<sdk::RETypeDefinition*> arg_tys, uintptr_t ret_addr) {
+        return (HookManager::PreHookResult)((PluginHook*)hook)->pre_fn((int)args.size(), (void**)args.data(), (REFrameworkTypeDefinitionHandle*)arg_tys.data(), ret_addr);
+    }
+
+    static void post(void* hook, uintptr_t& ret_val, sdk::RETypeDefinition* ret_ty, uintptr_t ret_addr) {
+        ((PluginHook*)hook)->post_fn((void**)&ret_val, (REFrameworkTypeDefinitionHandle)ret_ty, ret_addr);
+    }
+
+    static HookManager::PreHookResult pre_with_userdata(void* hook, std::span<uintptr_t> args, std::span<sdk::RETypeDefinition*> arg_tys, uintptr_t ret_addr) {
+        const auto self = (PluginHook*)hook;
+        return (HookManager::PreHookResult)self->pre_fn_with_userdata(self->userdata, (int)args.size(), (void**)args.data(), (REFrameworkTypeDefinitionHandle*)arg_tys.data(), ret_addr);
+    }
+
+    static void post_with_userdata(void* hook, uintptr_t& ret_val, sdk::RETypeDefinition* ret_ty, uintptr_t ret_addr) {
+        const auto self = (PluginHook*)hook;
+        self->post_fn_with_userdata(self->userdata, (void**)&ret_val, (REFrameworkTypeDefinitionHandle)ret_ty, ret_addr);
+    }
+};
+}
+
 REFrameworkPluginFunctions g_plugin_functions {
     reframework_on_lua_state_created,
     reframework_on_lua_state_destroyed,
@@ -167,24 +197,32 @@ REFrameworkSDKFunctions g_sdk_functions {
         return (REFrameworkManagedObjectHandle)sdk::VM::create_managed_string(utility::widen(str));
     },
     [](REFrameworkMethodHandle fn, REFPreHookFn pre_fn, REFPostHookFn post_fn, bool ignore_jmp) -> unsigned int {
-        return g_hookman.add((sdk::REMethodDefinition*)fn, [pre_fn](auto& args, auto& arg_tys, uintptr_t ret_addr) {
-                if (pre_fn != nullptr) {
-                    return (HookManager::PreHookResult)pre_fn((int)args.size(),
-                        (void**)args.data(), (REFrameworkTypeDefinitionHandle*)arg_tys.data(), ret_addr);
-                } else {
-                    return (HookManager::PreHookResult)REFRAMEWORK_HOOK_CALL_ORIGINAL;
-                }
-            },
-            [post_fn](auto& ret_val, auto* ret_ty, uintptr_t ret_addr) {
-                if (post_fn != nullptr) {
-                    post_fn((void**)&ret_val, (REFrameworkTypeDefinitionHandle)ret_ty, ret_addr);
-                }
-            },
-            ignore_jmp);
+        auto hook = std::make_shared<detail::PluginHook>(detail::PluginHook{.pre_fn = pre_fn, .post_fn = post_fn});
+
+        return g_hookman.add_raw((sdk::REMethodDefinition*)fn,
+            pre_fn != nullptr ? &detail::PluginHook::pre : nullptr,
+            post_fn != nullptr ? &detail::PluginHook::post : nullptr,
+            std::move(hook), ignore_jmp);
     },
     [](REFrameworkMethodHandle fn, unsigned int id) { g_hookman.remove((sdk::REMethodDefinition*)fn, (HookManager::HookId)id); },
     &sdk::memory::allocate,
-    &sdk::memory::deallocate
+    &sdk::memory::deallocate,
+    [](REFrameworkMethodHandle fn, REFPreHookWithUserdataFn pre_fn, REFPostHookWithUserdataFn post_fn, void* userdata, bool ignore_jmp) -> unsigned int {
+        auto hook = std::make_shared<detail::PluginHook>(detail::PluginHook{.pre_fn_with_userdata = pre_fn, .post_fn_with_userdata = post_fn, .userdata = userdata});
+
+        return g_hookman.add_raw((sdk::REMethodDefinition*)fn,
+            pre_fn != nullptr ? &detail::PluginHook::pre_with_userdata : nullptr,
+            post_fn != nullptr ? &detail::PluginHook::post_with_userdata : nullptr,
+            std::move(hook), ignore_jmp);
+    },
+    [](REFrameworkManagedObjectHandle obj, REFrameworkMethodHandle fn, REFPreHookWithUserdataFn pre_fn, REFPostHookWithUserdataFn post_fn, void* userdata) -> unsigned int {
+        auto hook = std::make_shared<detail::PluginHook>(detail::PluginHook{.pre_fn_with_userdata = pre_fn, .post_fn_with_userdata = post_fn, .userdata = userdata});
+
+        return g_hookman.add_vtable_raw((::REManagedObject*)obj, (sdk::REMethodDefinition*)fn,
+            pre_fn != nullptr ? &detail::PluginHook::pre_with_userdata : nullptr,
+            post_fn != nullptr ? &detail::PluginHook::post_with_userdata : nullptr,
+            std::move(hook));
+    }
 };
 
 #define RETYPEDEF(var) ((sdk::RETypeDefinition*)var)
@@ -299,18 +337,13 @@ REFrameworkTDBMethod g_tdb_method_data {
         }
 
         auto m = REMETHOD(method);
+        const auto num_args = in_args_size / sizeof(void*);
 
-        if (m->get_num_params() != in_args_size / sizeof(void*)) {
+        if (m->get_invoke_plan()->num_params != num_args) {
             return REFRAMEWORK_ERROR_IN_ARGS_SIZE_MISMATCH;
         }
 
-        std::vector<void*> cpp_args{};
-
-        for (auto i = 0; i < in_args_size / sizeof(void*); i++) {
-            cpp_args.push_back(in_args[i]);
-        }
-
-        auto ret = m->invoke(thisptr, cpp_args);
+        auto ret = m->invoke_span(thisptr, std::span{in_args, num_args});
 
         memcpy(out, &ret, sizeof(reframework::InvokeRet));
 
@@ -1,10 +1,13 @@
 #define NOMINMAX
 
+#include <algorithm>
 #include <cstdint>
 #include <filesystem>
+#include <limits>
 
 #include <imgui.h>
 
+#include "sdk/Application.hpp"
 #include "sdk/REContext.hpp"
 #include "sdk/REManagedObject.hpp"
 #include "sdk/RETypeDB.hpp"
@@ -56,6 +59,11 @@ ScriptState::ScriptState(const ScriptState::GarbageCollectionData& gc_data,bool
     std::scoped_lock _{ m_execution_mutex };
     m_is_main_state = is_main_state;
     m_lua.registry()["state"] = this;
+    *(ScriptState**)lua_getextraspace(m_lua.lua_state()) = this;
+
+    // Wrap the default allocator so we know how much each state allocates
+    m_base_alloc = lua_getallocf(m_lua, &m_base_alloc_ud);
+    lua_setallocf(m_lua, &ScriptState::lua_alloc, this);
     m_lua.open_libraries(sol::lib::base, sol::lib::package, sol::lib::string, sol::lib::math, sol::lib::table, sol::lib::bit32,
         sol::lib::utf8, sol::lib::os, sol::lib::coroutine);
 
@@ -425,10 +433,15 @@ void ScriptState::on_application_entry(size_t hash) {
     }
 
     if (hash == "EndRendering"_fnv && m_gc_data.gc_handler == ScriptState::GarbageCollectionHandler::REFRAMEWORK_MANAGED) {
+        const auto gc_start = std::chrono::high_resolution_clock::now();
+
         switch (m_gc_data.gc_type) {
             case ScriptState::GarbageCollectionType::FULL:
                 lua_gc(m_lua, LUA_GCCOLLECT);
                 break;
+            case ScriptState::GarbageCollectionType::ADAPTIVE:
+                step_adaptive_gc();
+                break;
             case ScriptState::GarbageCollectionType::STEP: 
                 {
                     const auto now = std::chrono::high_resolution_clock::now();
@@ -448,7 +461,97 @@ void ScriptState::on_application_entry(size_t hash) {
                 lua_gc(m_lua, LUA_GCCOLLECT);
                 break;
         };
+
+        const auto gc_time = std::chrono::duration<float, std::micro>(std::chrono::high_resolution_clock::now() - gc_start).count();
+        m_gc_stats.gc_time = m_gc_stats.gc_time * 0.9f + gc_time * 0.1f;
+    }
+
+    if (hash == "EndRendering"_fnv) {
+        const auto g = G(m_lua.lua_state());
+        m_gc_stats.heap_size = (uint64_t)(g->totalbytes + g->GCdebt);
+    }
+}
+
+void* ScriptState::lua_alloc(void* ud, void* ptr, size_t osize, size_t nsize) {
+    auto state = (ScriptState*)ud;
+    auto result = state->m_base_alloc(state->m_base_alloc_ud, ptr, osize, nsize);
+
+    // osize is the type of the object being created when ptr is null
+    const auto old_size = ptr != nullptr ? osize : 0;
+
+    if (result != nullptr && nsize > old_size) {
+        // only ever written by the thread holding the state
+        auto& allocated = state->m_gc_stats.bytes_allocated;
+        allocated.store(allocated.load(std::memory_order_relaxed) + (nsize - old_size), std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+void ScriptState::step_adaptive_gc() {
+    const auto now = std::chrono::high_resolution_clock::now();
+    const auto allocated = m_gc_stats.bytes_allocated.load(std::memory_order_relaxed);
+    const auto new_bytes = allocated - m_gc_pacer.last_allocated;
+
+    m_gc_pacer.last_allocated = allocated;
+    m_gc_pacer.debt += (int64_t)new_bytes;
+
+    if (m_gc_pacer.last_frame.time_since_epoch().count() != 0) {
+        const auto seconds = std::chrono::duration<float>(now - m_gc_pacer.last_frame).count();
+
+        if (seconds > 0.0f) {
+            m_gc_stats.allocation_rate = m_gc_stats.allocation_rate * 0.9f + ((float)new_bytes / seconds) * 0.1f;
+        }
+    }
+
+    m_gc_pacer.last_frame = now;
+
+    // The delta time is in the engine's own units, only its ratio to the average matters.
+    // Slower than usual frames get less of the budget so we don't make a spike worse.
+    const auto delta = sdk::Application::get()->get_delta_time();
+    auto headroom = 1.0f;
+
+    if (delta > 0.0f) {
+        m_gc_pacer.average_delta = m_gc_pacer.average_delta > 0.0f ? m_gc_pacer.average_delta * 0.95f + delta * 0.05f : delta;
+        headroom = std::clamp(m_gc_pacer.average_delta / delta, 0.25f, 1.0f);
+    }
+
+    const auto budget = std::chrono::duration_cast<std::chrono::microseconds>(m_gc_data.gc_budget * headroom);
+
+    if (m_gc_data.gc_mode == ScriptState::GarbageCollectionMode::GENERATIONAL) {
+        // In generational mode a step is a whole minor collection, which pays off the entire debt.
+        // LUA_GCSTEP also never reports a finished cycle there (the collector never sits in GCSpause),
+        // so stepping in a loop would just run minor collections back to back until the budget is gone.
+        if (m_gc_pacer.debt > 0) {
+            lua_gc(m_lua, LUA_GCSTEP, (int)std::clamp<int64_t>(m_gc_pacer.debt / 1024, 1, std::numeric_limits<int>::max()));
+            m_gc_pacer.debt = 0;
+        }
+    }
+
+    // Incremental mode: pay the collector for what was allocated, at most 1MB of debt per step so we can stop at the budget.
+    while (m_gc_pacer.debt > 0) {
+        const auto step_kb = (int)std::clamp<int64_t>(m_gc_pacer.debt / 1024, 1, 1024);
+        const auto cycle_done = lua_gc(m_lua, LUA_GCSTEP, step_kb) != 0;
+
+        m_gc_pacer.debt -= (int64_t)step_kb * 1024;
+
+        // a finished cycle already got rid of the garbage
+        if (cycle_done) {
+            m_gc_pacer.debt = 0;
+            break;
+        }
+
+        if (std::chrono::high_resolution_clock::now() - now >= budget) {
+            break;
+        }
     }
+
+    const auto g = G(m_lua.lua_state());
+    const auto heap_size = (int64_t)(g->totalbytes + g->GCdebt);
+
+    // A burst of allocations shouldn't keep us collecting for seconds afterwards.
+    m_gc_pacer.debt = std::clamp<int64_t>(m_gc_pacer.debt, 0, heap_size);
+    m_gc_stats.gc_debt = m_gc_pacer.debt;
 }
 
 bool ScriptState::on_pre_gui_draw_element(REComponent* gui_element, void* context) {
@@ -525,6 +628,14 @@ void ScriptState::add_vtable(::REManagedObject* obj, sdk::REMethodDefinition* fn
 }
 
 void ScriptState::install_hooks() {
+    if (m_hooks_to_add.empty()) {
+        return;
+    }
+
+    // All of the script's queued hooks go live at once, with one thread freeze.
+    // Applied when the batch goes out of scope, even if something below throws.
+    FunctionHook::Batch batch{};
+
     for (; !m_hooks_to_add.empty(); m_hooks_to_add.pop_front()) {
         auto hookdef = m_hooks_to_add.front();
         auto fn = hookdef.fn;
@@ -534,7 +645,7 @@ void ScriptState::install_hooks() {
         const auto hookman_data = HookManager::EitherOr{hookdef.obj, hookdef.fn, ignore_jmp_object.is<bool>() ? ignore_jmp_object.as<bool>() : false};
         auto id = g_hookman.add_either_or(
             hookman_data,
-            [pre_cb, state = this](auto& args, auto& arg_tys, uintptr_t ret_addr) -> HookManager::PreHookResult {
+            [pre_cb, state = this](auto args, auto arg_tys, uintptr_t ret_addr) -> HookManager::PreHookResult {
                 using PreHookResult = HookManager::PreHookResult;
 
                 auto _ = state->scoped_lock();
@@ -549,12 +660,13 @@ void ScriptState::install_hooks() {
                         return result;
                     }
 
-                    auto script_args = state->lua().create_table();
+                    // Sized up front so filling it doesn't rehash.
+                    auto script_args = state->lua().create_table((int)args.size(), 0);
 
                     // Call the script function.
                     // Convert the args to a table that we pass to the script function.
                     for (auto i = 0u; i < args.size(); ++i) {
-                        script_args[i + 1] = (void*)args[i];
+                        script_args.raw_set(i + 1, (void*)args[i]);
                     }
 
                     auto script_result = pre_cb(script_args);
@@ -571,8 +683,7 @@ void ScriptState::install_hooks() {
 
                     // Apply the changes to arguments that the script function may have made.
                     for (auto i = 0u; i < args.size(); ++i) {
-                        auto arg = script_args[i + 1];
-                        args[i] = (uintptr_t)arg.get<void*>();
+                        args[i] = (uintptr_t)script_args.raw_get<void*>(i + 1);
                     }
                 } catch (const std::exception& e) {
                     ScriptRunner::get()->spew_error(e.what());
@@ -715,7 +826,7 @@ void ScriptRunner::hook_battle_rule() {
 
     if (from_packet_data_method != nullptr) {
         g_hookman.add(from_packet_data_method, 
-        [this](std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr) -> HookManager::PreHookResult {
+        [this](std::span<uintptr_t> args, std::span<sdk::RETypeDefinition*> arg_tys, uintptr_t ret_addr) -> HookManager::PreHookResult {
             auto packet = (::REManagedObject*)args[2];
             if (packet == nullptr) {
                 return HookManager::PreHookResult::CALL_ORIGINAL;
@@ -843,14 +954,28 @@ void ScriptRunner::on_draw_ui() {
                 m_console_spawned = true;
             }
         }
-        //Garbage collection currently only showing from main lua state, might rework to show total later?
         if (ImGui::TreeNode("Garbage Collection Stats")) {
             std::scoped_lock _{ m_access_mutex };
 
-            auto g = G(m_main_state->lua().lua_state());
-            const auto bytes_in_use = g->totalbytes + g->GCdebt;
+            const auto draw_gc_stats = [](const char* name, ScriptState& state) {
+                const auto& stats = state.get_gc_stats();
 
-            ImGui::Text("Megabytes in use: %.2f", (float)bytes_in_use / 1024.0f / 1024.0f);
+                if (ImGui::TreeNode(name)) {
+                    ImGui::Text("Megabytes in use: %.2f", (float)stats.heap_size.load() / 1024.0f / 1024.0f);
+                    ImGui::Text("Allocation rate: %.2f MB/s", stats.allocation_rate.load() / 1024.0f / 1024.0f);
+                    ImGui::Text("GC time: %.1f us/frame", stats.gc_time.load());
+                    ImGui::Text("GC debt: %.2f KB", (float)stats.gc_debt.load() / 1024.0f);
+                    ImGui::TreePop();
+                }
+            };
+
+            if (m_main_state != nullptr) {
+                draw_gc_stats("Main State", *m_main_state);
+            }
+
+            for (size_t i = 0; i < m_states.size(); ++i) {
+                draw_gc_stats((std::string{"State "} + std::to_string(i)).c_str(), *m_states[i]);
+            }
 
             ImGui::TreePop();
         }
@@ -883,7 +1008,10 @@ void ScriptRunner::on_draw_ui() {
                 m_main_state->gc_data_changed(make_gc_data());
             }
 
-            if ((uint32_t)m_gc_mode->value() != (uint32_t)ScriptState::GarbageCollectionMode::GENERATIONAL) {
+            // the adaptive pacer uses the budget in both modes
+            if ((uint32_t)m_gc_mode->value() != (uint32_t)ScriptState::GarbageCollectionMode::GENERATIONAL
+                || (uint32_t)m_gc_type->value() == (uint32_t)ScriptState::GarbageCollectionType::ADAPTIVE)
+            {
                 if (m_gc_budget->draw("Garbage Collection Budget")) {
                     std::scoped_lock _{ m_access_mutex };
                     m_main_state->gc_data_changed(make_gc_data());
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <deque>
 #include <vector>
 #include <unordered_map>
@@ -21,6 +23,8 @@
 
 #include "HookManager.hpp"
 
+#include "bindings/ManagedObjectRefs.hpp"
+
 namespace regenny {
 namespace via {
 namespace clr {
@@ -106,6 +110,7 @@ public:
     enum class GarbageCollectionType : uint32_t {
         STEP = 0,
         FULL = 1,
+        ADAPTIVE = 2,
         LAST
     };
 
@@ -125,6 +130,15 @@ public:
         uint32_t gc_major_multiplier{100};
     };
 
+    // Written by the thread running the state, read by the UI.
+    struct GarbageCollectionStats {
+        std::atomic<uint64_t> bytes_allocated{0}; // total ever requested through our allocator
+        std::atomic<uint64_t> heap_size{0};
+        std::atomic<float> allocation_rate{0.0f}; // bytes per second, smoothed
+        std::atomic<float> gc_time{0.0f};         // microseconds spent collecting per frame, smoothed
+        std::atomic<int64_t> gc_debt{0};          // bytes the adaptive pacer still owes the collector
+    };
+
     ScriptState(const GarbageCollectionData& gc_data,bool is_main_state);
     ~ScriptState();
 
@@ -144,6 +158,10 @@ public:
     void lock() { m_execution_mutex.lock(); }
     void unlock() { m_execution_mutex.unlock(); }
     auto scoped_lock() { return std::scoped_lock{m_execution_mutex}; }
+    auto& managed_object_refs() { return m_managed_object_refs; }
+
+    // Stored in the extra space of the lua_State, coroutines inherit it.
+    static ScriptState* from(lua_State* l) { return *(ScriptState**)lua_getextraspace(l); }
 
     // add_hook enqueues the hook definition to be installed the next time install_hooks is called.
     void add_hook(sdk::REMethodDefinition* fn, sol::protected_function pre_cb, sol::protected_function post_cb, sol::object ignore_jmp_obj);
@@ -153,11 +171,32 @@ public:
     void install_hooks();
 
     void gc_data_changed(GarbageCollectionData data);
+    const auto& get_gc_stats() const { return m_gc_stats; }
 
 private:
+    static void* lua_alloc(void* ud, void* ptr, size_t osize, size_t nsize);
+
+    // Spreads collection over frames according to how much was allocated since the last one.
+    void step_adaptive_gc();
+
+    // Declared before m_lua, the __gc metamethods and the allocator still use these while the state closes.
+    bindings::ManagedObjectRefs m_managed_object_refs{};
+
+    lua_Alloc m_base_alloc{nullptr};
+    void* m_base_alloc_ud{nullptr};
+    GarbageCollectionStats m_gc_stats{};
+
     sol::state m_lua{};
 
     GarbageCollectionData m_gc_data{};
+
+    struct GarbageCollectionPacer {
+        uint64_t last_allocated{0};
+        int64_t debt{0};
+        float average_delta{0.0f};
+        std::chrono::high_resolution_clock::time_point last_frame{};
+    } m_gc_pacer{};
+
     bool m_is_main_state;
     std::recursive_mutex m_execution_mutex{};
 
@@ -307,7 +346,8 @@ private:
         {
             "Step",
             "Full",
-        }, (int)ScriptState::GarbageCollectionType::STEP)
+            "Adaptive",
+        }, (int)ScriptState::GarbageCollectionType::ADAPTIVE)
     };
 
     const ModCombo::Ptr m_gc_mode {
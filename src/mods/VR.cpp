@@ -1,6 +1,8 @@
 #define NOMINMAX
 
+#include <cstring>
 #include <fstream>
+#include <unordered_map>
 #include <imgui.h>
 #include <imgui_internal.h>
 #include <glm/gtx/transform.hpp>
@@ -2321,6 +2323,85 @@ struct GUIRestoreData {
 
 thread_local std::vector<std::unique_ptr<GUIRestoreData>> g_elements_to_reset{};
 
+// What on_pre_gui_draw_element decided for a game object, so it doesn't have to
+// convert and hash the name (and look for meshes) for every element on every frame.
+enum class GUIElementAction : uint8_t {
+    DEFAULT,
+    ALWAYS_DRAW,
+    NEVER_DRAW,
+};
+
+struct GUIElementClassification {
+    // The object's transform and raw name storage (inline characters or the string pointer) when it was classified.
+    // If the pointer got reused for another object, one of these won't match.
+    ::RETransform* transform{nullptr};
+    std::array<uint8_t, sizeof(::REString)> name_fingerprint{};
+
+    size_t name_hash{};
+    GUIElementAction action{GUIElementAction::DEFAULT};
+    int8_t has_mesh{-1}; // -1 = not looked up yet
+};
+
+thread_local std::unordered_map<::REGameObject*, GUIElementClassification> g_gui_classifications{};
+
+GUIElementAction classify_gui_element_name(size_t name_hash) {
+    switch (name_hash) {
+    // Don't mess with this, causes weird black boxes on the sides of the screen
+    case "GUI_PillarBox"_fnv:
+    case "GUIEventPillar"_fnv:
+    // These allow the cutscene transitions to display (fade to black)
+    case "BlackFade"_fnv:
+    case "WhiteFade"_fnv:
+    case "Fade_In_Out_Black"_fnv:
+    case "Fade_In_Out_White"_fnv:
+    case "FadeInOutBlack"_fnv:
+    case "FadeInOutWhite"_fnv:
+    case "GUIBlackMask"_fnv:
+    case "GenomeCodexGUI"_fnv:
+    case "sm42_020_keystrokeDevice01A_gimmick"_fnv: // this one is the keypad in the locker room...
+        return GUIElementAction::ALWAYS_DRAW;
+
+#if defined(RE2) || defined(RE3)
+    // the weird buggy overlay in the inventory
+    case "GuiBack"_fnv:
+        return GUIElementAction::NEVER_DRAW;
+#endif
+
+#if defined(RE4)
+    case "Gui_ui2510"_fnv: // Black bars in cutscenes
+        return GUIElementAction::NEVER_DRAW;
+#endif
+
+    default:
+        return GUIElementAction::DEFAULT;
+    };
+}
+
+GUIElementClassification& classify_gui_element(::REGameObject* game_object) {
+    auto& entry = g_gui_classifications[game_object];
+
+    const auto same_object = entry.transform == game_object->transform &&
+        memcmp(entry.name_fingerprint.data(), &game_object->name, sizeof(::REString)) == 0;
+
+    if (same_object) {
+        return entry;
+    }
+
+    // Objects come and go with menus and scenes, don't let dead ones pile up.
+    if (g_gui_classifications.size() > 4096) {
+        g_gui_classifications.clear();
+        return classify_gui_element(game_object);
+    }
+
+    entry = GUIElementClassification{};
+    entry.transform = game_object->transform;
+    memcpy(entry.name_fingerprint.data(), &game_object->name, sizeof(::REString));
+    entry.name_hash = utility::hash(utility::re_string::get_string(game_object->name));
+    entry.action = classify_gui_element_name(entry.name_hash);
+
+    return entry;
+}
+
 bool VR::on_pre_gui_draw_element(REComponent* gui_element, void* primitive_context) {
     inside_gui_draw = true;
 
@@ -2333,36 +2414,14 @@ bool VR::on_pre_gui_draw_element(REComponent* gui_element, void* primitive_conte
     if (game_object != nullptr && game_object->transform != nullptr) {
         auto context = sdk::get_thread_context();
 
-        const auto name = utility::re_string::get_string(game_object->name);
-        const auto name_hash = utility::hash(name);
-
-        switch (name_hash) {
-        // Don't mess with this, causes weird black boxes on the sides of the screen
-        case "GUI_PillarBox"_fnv:
-        case "GUIEventPillar"_fnv:
-        // These allow the cutscene transitions to display (fade to black)
-        case "BlackFade"_fnv:
-        case "WhiteFade"_fnv:
-        case "Fade_In_Out_Black"_fnv:
-        case "Fade_In_Out_White"_fnv:
-        case "FadeInOutBlack"_fnv:
-        case "FadeInOutWhite"_fnv:
-        case "GUIBlackMask"_fnv:
-        case "GenomeCodexGUI"_fnv:
-        case "sm42_020_keystrokeDevice01A_gimmick"_fnv: // this one is the keypad in the locker room...
-            return true;
+        auto& classification = classify_gui_element(game_object);
+        const auto name_hash = classification.name_hash;
 
-#if defined(RE2) || defined(RE3)
-        // the weird buggy overlay in the inventory
-        case "GuiBack"_fnv:
-            return false;
-#endif
-
-#if defined(RE4)
-        case "Gui_ui2510"_fnv: // Black bars in cutscenes
+        switch (classification.action) {
+        case GUIElementAction::ALWAYS_DRAW:
+            return true;
+        case GUIElementAction::NEVER_DRAW:
             return false;
-#endif
-
         default:
             break;
         };
@@ -2425,7 +2484,11 @@ bool VR::on_pre_gui_draw_element(REComponent* gui_element, void* primitive_conte
                 // we don't want to mess with any game object that has a mesh
                 // because it might be something physical in the game world
                 // that the player can interact with
-                if (utility::re_component::find(game_object->transform, via_render_mesh_typedef->get_type()) != nullptr) {
+                if (classification.has_mesh == -1) {
+                    classification.has_mesh = utility::re_component::find(game_object->transform, via_render_mesh_typedef->get_type()) != nullptr ? 1 : 0;
+                }
+
+                if (classification.has_mesh == 1) {
                     return true;
                 }
 
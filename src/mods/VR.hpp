@@ -207,6 +207,9 @@ private:
 
 private:
     // Hooks
+    // (detect_mod_callbacks needs to see these to subscribe us to them)
+    template <typename T> friend ModCallbacks detect_mod_callbacks();
+
     void on_view_get_size(REManagedObject* scene_view, float* result) override;
     static void inputsystem_update_hook(void* ctx, REManagedObject* input_system);
     void on_camera_get_projection_matrix(REManagedObject* camera, Matrix4x4f* result) override;
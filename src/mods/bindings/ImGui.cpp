@@ -3,6 +3,7 @@
 
 #include "../ScriptRunner.hpp"
 #include "sdk/SceneManager.hpp"
+#include "sdk/Renderer.hpp"
 #include "REFramework.hpp"
 #include "utility/ImGui.hpp"
 
@@ -1285,93 +1286,72 @@ ImGuiTableSortSpecs* table_get_sort_specs() {
 } // namespace api::imgui
 
 namespace api::draw {
-std::optional<Vector2f> world_to_screen(sol::object world_pos_object) {
-    auto scene = sdk::get_current_scene();
-
-    if (scene == nullptr) {
-        return std::nullopt;
-    }
-
-    auto context = sdk::get_thread_context();
-
-    static auto scene_def = sdk::find_type_definition("via.Scene");
-    auto first_transform = sdk::call_native_func_easy<RETransform*>(scene, scene_def, "get_FirstTransform");
-
-    if (first_transform == nullptr) {
-        return std::nullopt;
-    }
-
-    if (world_pos_object.is<sol::nil_t>()) {
-        return std::nullopt;
-    }
-
-    Vector4f world_pos{};
-
+std::optional<Vector3f> to_world_pos(sol::object world_pos_object) {
     if (world_pos_object.is<Vector2f>()) {
         auto& v2f = world_pos_object.as<Vector2f&>();
-        world_pos = Vector4f{v2f.x, v2f.y, 0.0f, 1.0f};
+        return Vector3f{v2f.x, v2f.y, 0.0f};
     } else if (world_pos_object.is<Vector3f>()) {
-        auto& v3f = world_pos_object.as<Vector3f&>();
-        world_pos = Vector4f{v3f.x, v3f.y, v3f.z, 1.0f};
+        return world_pos_object.as<Vector3f&>();
     } else if (world_pos_object.is<Vector4f>()) {
         auto& v4f = world_pos_object.as<Vector4f&>();
-        world_pos = Vector4f{v4f.x, v4f.y, v4f.z, v4f.w};
-    } else {
-        return std::nullopt;
+        return Vector3f{v4f.x, v4f.y, v4f.z};
     }
 
-    static auto transform_def = utility::re_managed_object::get_type_definition(first_transform);
-    static auto next_transform_method = transform_def->get_method("get_Next");
-    static auto get_gameobject_method = transform_def->get_method("get_GameObject");
-    static auto get_position_method = transform_def->get_method("get_Position");
-    static auto get_axisz_method = transform_def->get_method("get_AxisZ");
-    static auto math_t = sdk::find_type_definition("via.math");
+    return std::nullopt;
+}
 
-    auto camera = sdk::get_primary_camera();
+std::optional<Vector2f> world_to_screen(sol::object world_pos_object) {
+    const auto world_pos = to_world_pos(world_pos_object);
 
-    if (camera == nullptr) {
+    if (!world_pos) {
         return std::nullopt;
     }
 
-    auto main_view = sdk::get_main_view();
-
-    if (main_view == nullptr) {
-        return std::nullopt;
-    }
+    return sdk::renderer::world_to_screen(*world_pos);
+}
 
-    auto camera_gameobject = get_gameobject_method->call<REGameObject*>(context, camera);
-    auto camera_transform = camera_gameobject->transform;
+// Projects every position in the table at once using this frame's camera snapshot.
+// Results line up with the input, points that can't be projected are false.
+// Passing the table from the previous call as out avoids allocating a new one every frame.
+sol::table world_to_screen_batch(sol::this_state s, sol::table positions, sol::object out_obj, sol::object cull_offscreen_obj) {
+    sol::state_view lua{s};
 
-    Vector4f camera_origin{};
-    get_position_method->call<void*>(&camera_origin, context, camera_transform);
+    static thread_local std::vector<Vector3f> world_positions{};
+    static thread_local std::vector<std::optional<Vector2f>> screen_positions{};
+    static thread_local std::vector<bool> convertible{};
 
-    camera_origin.w = 1.0f;
+    const auto count = positions.size();
 
-    Vector4f camera_forward{};
-    get_axisz_method->call<void*>(&camera_forward, context, camera_transform);
+    world_positions.resize(count);
+    screen_positions.resize(count);
+    convertible.resize(count);
 
-    camera_forward.w = 1.0f;
+    for (size_t i = 0; i < count; ++i) {
+        const auto world_pos = to_world_pos(positions.get<sol::object>(i + 1));
 
-    // Translate 2d position to 3d position (screen to world)
-    Matrix4x4f proj{}, view{};
-    float screen_size[2]{};
-    sdk::call_object_func<void*>(camera, "get_ProjectionMatrix", &proj, context, camera);
-    sdk::call_object_func<void*>(camera, "get_ViewMatrix", &view, context, camera);
-    sdk::call_object_func<void*>(main_view, "get_WindowSize", &screen_size, context, main_view);
+        world_positions[i] = world_pos.value_or(Vector3f{});
+        convertible[i] = world_pos.has_value();
+    }
 
-    Vector4f screen_pos{};
+    const auto cull_offscreen = cull_offscreen_obj.is<bool>() && cull_offscreen_obj.as<bool>();
+    sdk::renderer::world_to_screen(world_positions, screen_positions, cull_offscreen);
 
-    const auto delta = world_pos - camera_origin;
+    auto out = out_obj.is<sol::table>() ? out_obj.as<sol::table>() : lua.create_table(count, 0);
 
-    // behind camera
-    if (glm::dot(Vector3f{delta}, Vector3f{-camera_forward}) <= 0.0f) {
-        return std::nullopt;
+    for (size_t i = 0; i < count; ++i) {
+        if (convertible[i] && screen_positions[i]) {
+            out[i + 1] = *screen_positions[i];
+        } else {
+            out[i + 1] = false;
+        }
     }
 
-    static auto world_to_screen_method = math_t->get_method("worldPos2ScreenPos(via.vec3, via.mat4, via.mat4, via.Size)"); // there are 2 of them.
-    world_to_screen_method->call<void*>(&screen_pos, context, &world_pos, &view, &proj, &screen_size);
+    // Trim leftovers from a larger previous batch
+    for (auto i = out.size(); i > count; --i) {
+        out[i] = sol::lua_nil;
+    }
 
-    return Vector2f{screen_pos.x, screen_pos.y};
+    return out;
 }
 
 void world_text(const char* text, sol::object world_pos_object, ImU32 color = 0xFFFFFFFF) {
@@ -2100,6 +2080,7 @@ void bindings::open_imgui(ScriptState* s) {
     auto draw = lua.create_table();
 
     draw["world_to_screen"] = api::draw::world_to_screen;
+    draw["world_to_screen_batch"] = api::draw::world_to_screen_batch;
     draw["world_text"] = api::draw::world_text;
     draw["text"] = api::draw::text;
     draw["filled_rect"] = api::draw::filled_rect;
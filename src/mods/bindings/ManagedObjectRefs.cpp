@@ -0,0 +1,92 @@
+#include "ManagedObjectRefs.hpp"
+
+namespace bindings {
+ManagedObjectRefs::ManagedObjectRefs() {
+    m_entries.resize(1024);
+}
+
+ManagedObjectRefs::Entry* ManagedObjectRefs::find(::REManagedObject* obj) {
+    const auto mask = m_entries.size() - 1;
+
+    for (auto i = index_of(obj); m_entries[i].obj != nullptr; i = (i + 1) & mask) {
+        if (m_entries[i].obj == obj) {
+            return &m_entries[i];
+        }
+    }
+
+    return nullptr;
+}
+
+ManagedObjectRefs::Entry& ManagedObjectRefs::get(::REManagedObject* obj) {
+    if (auto entry = find(obj); entry != nullptr) {
+        return *entry;
+    }
+
+    // Keep the load factor under 1/2 so probes stay short
+    if ((m_size + 1) * 2 > m_entries.size()) {
+        grow();
+    }
+
+    const auto mask = m_entries.size() - 1;
+    auto i = index_of(obj);
+
+    while (m_entries[i].obj != nullptr) {
+        i = (i + 1) & mask;
+    }
+
+    m_entries[i] = Entry{};
+    m_entries[i].obj = obj;
+    ++m_size;
+
+    return m_entries[i];
+}
+
+void ManagedObjectRefs::remove_if_unused(::REManagedObject* obj) {
+    auto entry = find(obj);
+
+    if (entry == nullptr || entry->ref_count > 0 || entry->ephemeral_count) {
+        return;
+    }
+
+    const auto mask = m_entries.size() - 1;
+    auto hole = (size_t)(entry - m_entries.data());
+
+    // Backward shift, move every following entry that would still be reachable from the hole into it
+    for (auto i = (hole + 1) & mask; m_entries[i].obj != nullptr; i = (i + 1) & mask) {
+        const auto home = index_of(m_entries[i].obj);
+
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+            m_entries[hole] = m_entries[i];
+            hole = i;
+        }
+    }
+
+    m_entries[hole] = Entry{};
+    --m_size;
+}
+
+void ManagedObjectRefs::grow() {
+    auto old_entries = std::move(m_entries);
+
+    m_entries.clear();
+    m_entries.resize(old_entries.size() * 2);
+    m_size = 0;
+
+    const auto mask = m_entries.size() - 1;
+
+    for (auto& entry : old_entries) {
+        if (entry.obj == nullptr) {
+            continue;
+        }
+
+        auto i = index_of(entry.obj);
+
+        while (m_entries[i].obj != nullptr) {
+            i = (i + 1) & mask;
+        }
+
+        m_entries[i] = entry;
+        ++m_size;
+    }
+}
+}
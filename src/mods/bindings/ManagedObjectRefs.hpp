@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+class REManagedObject;
+
+namespace bindings {
+// Per ScriptState bookkeeping for the managed objects that have been pushed into Lua.
+// Used to live in the _sol_lua_push_ref_counts/_sol_lua_push_ephemeral_counts tables,
+// which meant several table accesses for every object pushed.
+// Open addressing with linear probing, removals shift the following entries back so there are no tombstones.
+class ManagedObjectRefs {
+public:
+    struct Entry {
+        ::REManagedObject* obj{nullptr};
+        int32_t ref_count{0};                     // references we actually hold on the object
+        std::optional<int32_t> ephemeral_count{}; // pushes of local objects, no reference held
+        bool validated{false};                    // is_managed_object already passed for this object
+    };
+
+    ManagedObjectRefs();
+
+    // nullptr if the object isn't tracked
+    Entry* find(::REManagedObject* obj);
+
+    // Inserts an empty entry if the object isn't tracked yet
+    Entry& get(::REManagedObject* obj);
+
+    // Drops the entry once nothing refers to the object anymore
+    void remove_if_unused(::REManagedObject* obj);
+
+    size_t size() const {
+        return m_size;
+    }
+
+    // Registry reference to the weak table that maps objects to their userdata,
+    // so pushing the same object twice hands back the same userdata.
+    int get_userdata_cache() const {
+        return m_userdata_cache;
+    }
+
+    void set_userdata_cache(int ref) {
+        m_userdata_cache = ref;
+    }
+
+private:
+    size_t index_of(::REManagedObject* obj) const {
+        // Objects are at least 16 byte aligned, the low bits carry no information
+        return (size_t)(((uintptr_t)obj >> 4) * 0x9E3779B97F4A7C15ull) & (m_entries.size() - 1);
+    }
+
+    void grow();
+
+    std::vector<Entry> m_entries{};
+    size_t m_size{0};
+    int m_userdata_cache{-2}; // LUA_NOREF
+};
+}
@@ -1,13 +1,17 @@
+#include <array>
 #include <cstdint>
 #include <concepts>
+#include <mutex>
 
 #include <hde64.h>
 
 #include "HookManager.hpp"
+#include "sdk/REComponent.hpp"
 #include "sdk/REContext.hpp"
 #include "sdk/REManagedObject.hpp"
 #include "sdk/RETypeDB.hpp"
 #include "sdk/SceneManager.hpp"
+#include "sdk/SceneSnapshot.hpp"
 #include "sdk/ResourceManager.hpp"
 #include "sdk/MotionFsm2Layer.hpp"
 #include "sdk/TDBVer.hpp"
@@ -47,12 +51,21 @@ namespace detail {
 namespace api::re_managed_object {
 namespace detail {
 void add_ref(lua_State* l, ::REManagedObject* obj, bool force = false) {
-    auto sv = sol::state_view{l};
-    
-    // we shouldn't really do this very much
-    // so it shouldn't be too terrible on performance
-    if (!utility::re_managed_object::is_managed_object(obj)) {
-        throw sol::error{(std::stringstream{} << "sol_lua_push: " << (uintptr_t)obj << " is not a managed object").str()};
+    auto& refs = ScriptState::from(l)->managed_object_refs();
+    auto entry = refs.find(obj);
+
+    // is_managed_object is expensive (IsBadReadPtr and friends)
+    // so only do it once for as long as we're tracking the object
+    if (entry == nullptr || !entry->validated) {
+        if (!utility::re_managed_object::is_managed_object(obj)) {
+            throw sol::error{(std::stringstream{} << "sol_lua_push: " << (uintptr_t)obj << " is not a managed object").str()};
+        }
+
+        if (entry == nullptr) {
+            entry = &refs.get(obj);
+        }
+
+        entry->validated = true;
     }
 
     // Throwing automatic add_ref on the backburner; it doesn't seem to work
@@ -70,18 +83,14 @@ void add_ref(lua_State* l, ::REManagedObject* obj, bool force = false) {
         // the reference counting is not necessary, but it will let us
         // catch bugs if an REManagedObject pointer is being created
         // without coming through our sol_lua_push function
-        sol::lua_table ref_counts = sv["_sol_lua_push_ref_counts"];
-        sol::lua_table ephemeral_counts = sv["_sol_lua_push_ephemeral_counts"];
-        std::optional<int> current_ref_count = ref_counts[(uintptr_t)obj];
-
-        if (current_ref_count && *current_ref_count > 0) {
+        if (entry->ref_count > 0) {
             // don't unnecessarily increase the ref count
             // if the user is the one doing it
             if (force) {
                 return;
             }
 
-            ref_counts[(uintptr_t)obj] = *current_ref_count + 1;
+            ++entry->ref_count;
         } else {
             // only add the ref once when the user requests it
             // so they don't screw something up
@@ -89,35 +98,31 @@ void add_ref(lua_State* l, ::REManagedObject* obj, bool force = false) {
                 utility::re_managed_object::add_ref(obj);
             }
 
-            ref_counts[(uintptr_t)obj] = 1;
+            entry->ref_count = 1;
         }
 
         // when the user adds a ref to an ephemeral object
         if (force) {
-            std::optional<int> current_ephemeral_count = ephemeral_counts[(uintptr_t)obj];
-
-            if (current_ephemeral_count && *current_ephemeral_count > 0) {
-                ephemeral_counts[(uintptr_t)obj] = *current_ephemeral_count - 1;
+            if (entry->ephemeral_count && *entry->ephemeral_count > 0) {
+                --*entry->ephemeral_count;
             } else {
-                ephemeral_counts[(uintptr_t)obj] = sol::make_object(l, sol::nil);
+                entry->ephemeral_count = std::nullopt;
             }
         }
     } else {
-        // ephemeral counts is just a table
+        // ephemeral counts are just
         // to help with tracking the local objects
         // so we don't spam the log with warnings when they get gc'd
-        sol::lua_table ephemeral_counts = sv["_sol_lua_push_ephemeral_counts"];
-        std::optional<int> current_ref_count = ephemeral_counts[(uintptr_t)obj];
-
-        if (current_ref_count) {
-            ephemeral_counts[(uintptr_t)obj] = *current_ref_count + 1;
-        } else {
-            ephemeral_counts[(uintptr_t)obj] = 1;
-        }
-
-        //ref_counts[(uintptr_t)obj] = sol::make_object(l, sol::nil);
+        entry->ephemeral_count = entry->ephemeral_count.value_or(0) + 1;
     }
 }
+
+void forget_userdata(lua_State* l, ::REManagedObject* obj) {
+    lua_rawgeti(l, LUA_REGISTRYINDEX, ScriptState::from(l)->managed_object_refs().get_userdata_cache());
+    lua_pushnil(l);
+    lua_rawsetp(l, -2, obj);
+    lua_pop(l, 1);
+}
 }
 
 // used by metatable for REManagedObject
@@ -139,45 +144,28 @@ void add_ref(lua_State* l, ::REManagedObject* obj, bool force = false) {
 
 void release(sol::this_state s, ::REManagedObject* obj, bool force = false) {
     auto l = s.lua_state();
-    auto sv = sol::state_view(l);
-
-    sol::lua_table objects = sv["_sol_lua_push_objects"];
-    sol::lua_table ref_counts = sv["_sol_lua_push_ref_counts"];
-    sol::lua_table ephemeral_counts = sv["_sol_lua_push_ephemeral_counts"];
+    auto& refs = ScriptState::from(l)->managed_object_refs();
+    auto entry = refs.find(obj);
 
-    if (std::optional<int> ref_count = ref_counts[(uintptr_t)obj]; ref_count && *ref_count > 0) {
+    if (entry != nullptr && entry->ref_count > 0) {
         // because of our internal refcount keeping, we shouldn't need to double check
         // whether it's an actual object or not. hopefully?
         //if (utility::re_managed_object::is_managed_object(obj)) {
             utility::re_managed_object::release(obj);
         //}
 
-        int new_ref_count = *ref_count - 1;
-
-        if (new_ref_count == 0) {
-            if (sol::object object = ephemeral_counts[(uintptr_t)obj]; !object.valid()) {
-                objects[(uintptr_t)obj] = sol::make_object(l, sol::nil);
-            }
-
-            ref_counts[(uintptr_t)obj] = sol::make_object(l, sol::nil);
-        } else {
-            ref_counts[(uintptr_t)obj] = new_ref_count;
+        if (--entry->ref_count == 0 && !entry->ephemeral_count) {
+            detail::forget_userdata(l, obj);
         }
-
-        //ephemeral_counts[(uintptr_t)obj] = sol::make_object(l, sol::nil);
-    } else if (std::optional<int> ephemeral_count = ephemeral_counts[(uintptr_t)obj]; ephemeral_count && *ephemeral_count > 0) {
+    } else if (entry != nullptr && entry->ephemeral_count.value_or(0) > 0) {
         if (force && utility::re_managed_object::is_managed_object(obj)) {
             utility::re_managed_object::release(obj);
         }
 
         // ephemeral counts don't actually release the object, they just decrement the count.
-        int new_ephemeral_count = *ephemeral_count - 1;
-
-        if (new_ephemeral_count == 0) {
-            objects[(uintptr_t)obj] = sol::make_object(l, sol::nil);
-            ephemeral_counts[(uintptr_t)obj] = sol::make_object(l, sol::nil);
-        } else {
-            ephemeral_counts[(uintptr_t)obj] = new_ephemeral_count;
+        if (--*entry->ephemeral_count == 0) {
+            detail::forget_userdata(l, obj);
+            entry->ephemeral_count = std::nullopt;
         }
     } else {
         if (force) {
@@ -188,6 +176,8 @@ void release(sol::this_state s, ::REManagedObject* obj, bool force = false) {
             spdlog::warn("REManagedObject:release attempted to release an object that was not managed by our Lua state");
         }
     }
+
+    refs.remove_if_unused(obj);
 }
 }
 
@@ -196,13 +186,15 @@ void release(sol::this_state s, ::REManagedObject* obj, bool force = false) {
 template<detail::ManagedObjectBased T>
 int sol_lua_push(sol::types<T*>, lua_State* l, T* obj) {
     if (obj != nullptr) {
-        auto sv = sol::state_view{l};
-        sol::lua_table objects = sv["_sol_lua_push_objects"];
+        const auto userdata_cache = ScriptState::from(l)->managed_object_refs().get_userdata_cache();
+
+        lua_rawgeti(l, LUA_REGISTRYINDEX, userdata_cache);
+
+        if (lua_rawgetp(l, -1, obj) != LUA_TNIL) {
+            lua_remove(l, -2); // the cache table
 
-        if (sol::object lua_obj = objects[(uintptr_t)obj]; !lua_obj.is<sol::nil_t>()) {
             // renew the reference so it doesn't get collected
             // had to dig deep in the lua source to figure out this nonsense
-            lua_obj.push();
             auto g = G(l);
             auto tv = s2v(l->top - 1);
             auto& gc = tv->value_.gc;
@@ -210,6 +202,8 @@ int sol_lua_push(sol::types<T*>, lua_State* l, T* obj) {
 
             return 1;
         } else {
+            lua_pop(l, 2);
+
             if ((uintptr_t)obj != detail::FAKE_OBJECT_ADDR) {
                 api::re_managed_object::detail::add_ref(l, (::REManagedObject*)obj, false);
             }
@@ -224,7 +218,7 @@ int sol_lua_push(sol::types<T*>, lua_State* l, T* obj) {
                     if (auto it = api::sdk::s_fnv_cache.find(td); it != api::sdk::s_fnv_cache.end()) {
                         typename_hash = it->second;
                     } else {
-                        typename_hash = utility::hash(td->get_full_name());
+                        typename_hash = utility::hash(td->get_full_name_view());
                         api::sdk::s_fnv_cache[td] = typename_hash;
                     }
 
@@ -259,10 +253,11 @@ int sol_lua_push(sol::types<T*>, lua_State* l, T* obj) {
                     backpedal = sol::stack::push<sol::detail::as_pointer_tag<std::remove_pointer_t<T>>>(l, obj);
                 }
 
-                auto ref = sol::stack::get<sol::object>(l, -backpedal);
-
                 // keep a weak reference to the object for caching
-                objects[(uintptr_t)obj] = ref;
+                lua_rawgeti(l, LUA_REGISTRYINDEX, userdata_cache);
+                lua_pushvalue(l, -1 - backpedal);
+                lua_rawsetp(l, -2, obj);
+                lua_pop(l, 1);
 
                 return backpedal;
             } else {
@@ -325,7 +320,77 @@ int sol_lua_push(sol::types<T*>, lua_State* l, T* obj) {
 }
 
 namespace api::sdk {
-std::vector<void*>& build_args(sol::variadic_args va);
+// Arguments for a single native call. Lives on the caller's stack so nested calls
+// (e.g. a script calling a method from inside a hook) don't clobber each other.
+class NativeArgs {
+public:
+    static constexpr size_t INLINE_COUNT = 16;
+
+    NativeArgs(size_t count)
+        : m_count{count}
+    {
+        if (count > INLINE_COUNT) {
+            m_heap_args.resize(count);
+            m_heap_vecs.resize(count);
+        }
+    }
+
+    NativeArgs(const NativeArgs&) = delete;
+    NativeArgs& operator=(const NativeArgs&) = delete;
+
+    ~NativeArgs() {
+        for (size_t i = 0; i < m_num_inline_keep_alive; ++i) {
+            utility::re_managed_object::release(m_inline_keep_alive[i]);
+        }
+
+        for (auto obj : m_heap_keep_alive) {
+            utility::re_managed_object::release(obj);
+        }
+    }
+
+    void*& operator[](size_t i) {
+        return data()[i];
+    }
+
+    // Backing storage for vector arguments that need to be widened, one slot per argument.
+    Vector4f& vec_storage(size_t i) {
+        return m_count > INLINE_COUNT ? m_heap_vecs[i] : m_inline_vecs[i];
+    }
+
+    void** data() {
+        return m_count > INLINE_COUNT ? m_heap_args.data() : m_inline_args.data();
+    }
+
+    std::span<void* const> span() {
+        return std::span{data(), m_count};
+    }
+
+    // Takes over a reference the caller already holds, released once the call is done.
+    // At most one per argument, so only calls with more than INLINE_COUNT of them touch the heap.
+    void keep_alive(::REManagedObject* obj) {
+        if (obj == nullptr) {
+            return;
+        }
+
+        if (m_num_inline_keep_alive < INLINE_COUNT) {
+            m_inline_keep_alive[m_num_inline_keep_alive++] = obj;
+        } else {
+            m_heap_keep_alive.push_back(obj);
+        }
+    }
+
+private:
+    size_t m_count{};
+    std::array<void*, INLINE_COUNT> m_inline_args{};
+    std::array<Vector4f, INLINE_COUNT> m_inline_vecs{};
+    std::vector<void*> m_heap_args{};
+    std::vector<Vector4f> m_heap_vecs{};
+    std::array<::REManagedObject*, INLINE_COUNT> m_inline_keep_alive{};
+    size_t m_num_inline_keep_alive{};
+    std::vector<::REManagedObject*> m_heap_keep_alive{};
+};
+
+void build_args(sol::variadic_args va, ::sdk::REMethodDefinition* fn, NativeArgs& out);
 sol::object parse_data(lua_State* l, void* data, ::sdk::RETypeDefinition* data_type, bool from_method);
 sol::object get_native_field(sol::object obj, ::sdk::RETypeDefinition* ty, const char* name);
 sol::object get_native_field_from_field(sol::object obj, ::sdk::RETypeDefinition* ty, ::sdk::REField* field);
@@ -402,14 +467,17 @@ struct ValueType {
             return sol::make_object(l, sol::nil);
         }
 
-        auto ret_val = def->invoke(real_obj, ::api::sdk::build_args(va));
+        ::api::sdk::NativeArgs args{(size_t)va.size()};
+        ::api::sdk::build_args(va, def, args);
+
+        auto ret_val = def->invoke_span(real_obj, args.span());
 
         if (ret_val.exception_thrown) {
             throw sol::error("Invoke threw an exception");
         }
 
         // Convert return values to the correct Lua types.
-        auto ret_ty = def->get_return_type();
+        auto ret_ty = def->get_invoke_plan()->ret_ty;
 
         return ::api::sdk::parse_data(l, &ret_val, ret_ty, true);
     }
@@ -773,10 +841,10 @@ sol::object parse_data(lua_State* l, void* data, ::sdk::RETypeDefinition* data_t
             auto underlying_type = data_type->get_underlying_type();
 
             if (underlying_type != nullptr) {
-                full_name_hash = utility::hash(underlying_type->get_full_name());
+                full_name_hash = utility::hash(underlying_type->get_full_name_view());
             }
         } else {
-            full_name_hash = utility::hash(data_type->get_full_name());
+            full_name_hash = utility::hash(data_type->get_full_name_view());
         }
 
         const auto vm_obj_type = data_type->get_vm_obj_type();
@@ -919,10 +987,10 @@ void set_data(void* data, ::sdk::RETypeDefinition* data_type, sol::object& value
             auto underlying_type = data_type->get_underlying_type();
 
             if (underlying_type != nullptr) {
-                full_name_hash = utility::hash(underlying_type->get_full_name());
+                full_name_hash = utility::hash(underlying_type->get_full_name_view());
             }
         } else {
-            full_name_hash = utility::hash(data_type->get_full_name());
+            full_name_hash = utility::hash(data_type->get_full_name_view());
         }
 
         switch (full_name_hash) {
@@ -1069,76 +1137,256 @@ sol::object get_native_field(sol::object obj, ::sdk::RETypeDefinition* ty, const
     return get_native_field_from_field(obj, ty, field);
 }
 
-std::vector<void*>& build_args(sol::variadic_args va) {
-    auto l = va.lua_state();
+namespace detail {
+// Managed strings made from Lua string arguments. Scripts mostly pass the same few
+// constant strings over and over, so they're kept alive and reused instead of
+// creating a new managed string on every call.
+// Every string handed out carries its own reference for the caller, so evicting the
+// cache never frees a string that's still sitting in someone's argument list.
+class ManagedStringCache {
+public:
+    // The caller owns one reference to the returned string (see NativeArgs::keep_alive).
+    ::REManagedObject* get(std::string_view str) {
+        if (str.length() > MAX_LENGTH) {
+            auto managed_str = (::REManagedObject*)::sdk::VM::create_managed_string(utility::widen(str));
+
+            if (managed_str != nullptr) {
+                utility::re_managed_object::add_ref(managed_str);
+            }
+
+            return managed_str;
+        }
+
+        std::scoped_lock _{m_mtx};
+
+        if (auto it = m_strings.find(str); it != m_strings.end()) {
+            utility::re_managed_object::add_ref(it->second);
+            return it->second;
+        }
+
+        if (m_strings.size() >= MAX_ENTRIES) {
+            clear_unlocked();
+        }
+
+        auto managed_str = (::REManagedObject*)::sdk::VM::create_managed_string(utility::widen(str));
+
+        if (managed_str == nullptr) {
+            return nullptr;
+        }
+
+        // One reference for the cache, one for the caller
+        utility::re_managed_object::add_ref(managed_str);
+        utility::re_managed_object::add_ref(managed_str);
+        m_strings.emplace(str, managed_str);
+
+        return managed_str;
+    }
+
+private:
+    static constexpr size_t MAX_LENGTH = 256;
+    static constexpr size_t MAX_ENTRIES = 1024;
+
+    struct Hash {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view str) const {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+
+    // Only drops the cache's own references, callers still holding a string keep it alive.
+    void clear_unlocked() {
+        for (auto& [_, managed_str] : m_strings) {
+            utility::re_managed_object::release(managed_str);
+        }
+
+        m_strings.clear();
+    }
+
+    std::mutex m_mtx{};
+    std::unordered_map<std::string, ::REManagedObject*, Hash, std::equal_to<>> m_strings{};
+};
+
+ManagedStringCache g_managed_strings{};
+
+// Fallback for when the argument doesn't match what the parameter expects,
+// or the parameter isn't one of the types we know how to convert directly.
+void* build_arg_generic(lua_State* l, sol::stack_proxy arg, NativeArgs& args, Vector4f& vec_storage) {
+    auto i = arg.stack_index();
+
+    // sol2 doesn't seem to differentiate between Lua integers and numbers. So
+    // we must do it ourselves.
+    if (lua_isboolean(l, i)) {
+        auto b = lua_toboolean(l, i);
+        return (void*)(intptr_t)b;
+    } else if (lua_isinteger(l, i)) {
+        auto n = (intptr_t)lua_tointeger(l, i);
+        return (void*)n;
+    } else if (lua_isnumber(l, i)) {
+        auto f = lua_tonumber(l, i);
+        auto n = *(intptr_t*)&f;
+        return (void*)n;
+    } else if (lua_isstring(l, i)) {
+        size_t len{};
+        auto s = lua_tolstring(l, i, &len);
+        auto managed_str = g_managed_strings.get(std::string_view{s, len});
+        args.keep_alive(managed_str);
+        return managed_str;
+    } else if (arg.is<Vector2f>()) {
+        auto& v = arg.as<Vector2f&>();
+        vec_storage = Vector4f{v.x, v.y, 0.0f, 0.0f};
+        return (void*)&vec_storage;
+    } else if (arg.is<Vector3f>()) {
+        auto& v = arg.as<Vector3f&>();
+        vec_storage = Vector4f{v.x, v.y, v.z, 0.0f};
+        return (void*)&vec_storage;
+    } else if (arg.is<Vector4f>()) {
+        auto& v = arg.as<Vector4f&>();
+        return (void*)&v;
+    } else if (arg.is<Matrix4x4f>()) {
+        auto& v = arg.as<Matrix4x4f&>();
+        return (void*)&v;
+    } else if (arg.is<glm::quat>()) {
+        auto& v = arg.as<glm::quat&>();
+        return (void*)&v;
+    } else if (arg.is<::REManagedObject*>()) {
+        return arg.as<::REManagedObject*>();
+    } else if (arg.is<ValueType>()) {
+        auto& b = arg.as<ValueType&>();
+        return (void*)b.address();
+    }
+
+    return arg.as<void*>();
+}
+
+// Converts straight to what the parameter expects when the Lua value is the matching type.
+// Returns false if the generic conversion should be used instead.
+bool build_arg_typed(lua_State* l, sol::stack_proxy arg, ::sdk::InvokePlan::ParamKind kind, NativeArgs& args, Vector4f& vec_storage, void*& out) {
+    using ParamKind = ::sdk::InvokePlan::ParamKind;
+
+    const auto i = arg.stack_index();
+    const auto lua_ty = lua_type(l, i);
+
+    switch (kind) {
+    case ParamKind::BOOLEAN:
+        if (lua_ty != LUA_TBOOLEAN) {
+            return false;
+        }
+
+        out = (void*)(intptr_t)lua_toboolean(l, i);
+        return true;
+    case ParamKind::INTEGER:
+        if (lua_ty != LUA_TNUMBER) {
+            return false;
+        }
 
-    static std::vector<void*> args{};
-    static std::vector<Vector4f> vec_storage{};
+        out = lua_isinteger(l, i) ? (void*)(intptr_t)lua_tointeger(l, i) : (void*)(intptr_t)lua_tonumber(l, i);
+        return true;
+    case ParamKind::SINGLE: [[fallthrough]];
+    case ParamKind::DOUBLE: {
+        if (lua_ty != LUA_TNUMBER) {
+            return false;
+        }
+
+        // The invoke wrappers take floating point args as doubles.
+        const auto f = (double)lua_tonumber(l, i);
+        out = (void*)*(intptr_t*)&f;
+        return true;
+    }
+    case ParamKind::STRING: {
+        if (lua_ty != LUA_TSTRING) {
+            return false;
+        }
+
+        size_t len{};
+        const auto s = lua_tolstring(l, i, &len);
+        const auto managed_str = g_managed_strings.get(std::string_view{s, len});
+        args.keep_alive(managed_str);
+        out = managed_str;
+        return true;
+    }
+    case ParamKind::VEC2:
+        if (lua_ty != LUA_TUSERDATA || !arg.is<Vector2f>()) {
+            return false;
+        }
+
+        vec_storage = Vector4f{arg.as<Vector2f&>(), 0.0f, 0.0f};
+        out = (void*)&vec_storage;
+        return true;
+    case ParamKind::VEC3:
+        if (lua_ty != LUA_TUSERDATA || !arg.is<Vector3f>()) {
+            return false;
+        }
+
+        vec_storage = Vector4f{arg.as<Vector3f&>(), 0.0f};
+        out = (void*)&vec_storage;
+        return true;
+    case ParamKind::VEC4:
+        if (lua_ty != LUA_TUSERDATA || !arg.is<Vector4f>()) {
+            return false;
+        }
+
+        out = (void*)&arg.as<Vector4f&>();
+        return true;
+    case ParamKind::QUATERNION:
+        if (lua_ty != LUA_TUSERDATA || !arg.is<glm::quat>()) {
+            return false;
+        }
+
+        out = (void*)&arg.as<glm::quat&>();
+        return true;
+    case ParamKind::MATRIX:
+        if (lua_ty != LUA_TUSERDATA || !arg.is<Matrix4x4f>()) {
+            return false;
+        }
+
+        out = (void*)&arg.as<Matrix4x4f&>();
+        return true;
+    default:
+        return false;
+    }
+}
+}
+
+void build_args(sol::variadic_args va, ::sdk::REMethodDefinition* fn, NativeArgs& out) {
+    auto l = va.lua_state();
 
-    args.clear();
-    vec_storage.clear();
+    const auto plan = fn->get_invoke_plan();
+    const auto& param_kinds = plan->param_kinds;
+    size_t index = 0;
 
     for (auto&& arg : va) {
-        auto i = arg.stack_index();
+        auto& vec_storage = out.vec_storage(index);
+        auto& result = out[index];
+        const auto kind = index < param_kinds.size() ? param_kinds[index] : ::sdk::InvokePlan::ParamKind::OTHER;
 
-        if (lua_isnil(l, i)) {
-            args.push_back(nullptr);
+        ++index;
+
+        if (lua_isnil(l, arg.stack_index())) {
+            result = nullptr;
             continue;
         }
 
-        // sol2 doesn't seem to differentiate between Lua integers and numbers. So
-        // we must do it ourselves.
-        if (lua_isboolean(l, i)) {
-            auto b = lua_toboolean(l, i);
-            args.push_back((void*)(intptr_t)b);
-        } else if (lua_isinteger(l, i)) {
-            auto n = (intptr_t)lua_tointeger(l, i);
-            args.push_back((void*)n);
-        } else if (lua_isnumber(l, i)) {
-            auto f = lua_tonumber(l, i);
-            auto n = *(intptr_t*)&f;
-            args.push_back((void*)n);
-        } else if (lua_isstring(l, i)) {
-            auto s = lua_tostring(l, i);
-            args.push_back(::sdk::VM::create_managed_string(utility::widen(s)));
-        } else if (arg.is<Vector2f>()) {
-            auto& v = arg.as<Vector2f&>();
-            args.push_back((void*)&vec_storage.emplace_back(v.x, v.y, 0.0f, 0.0f));
-        } else if (arg.is<Vector3f>()) {
-            auto& v = arg.as<Vector3f&>();
-            args.push_back((void*)&vec_storage.emplace_back(v.x, v.y, v.z, 0.0f));
-        } else if (arg.is<Vector4f>()) {
-            auto& v = arg.as<Vector4f&>();
-            args.push_back((void*)&v);
-        } else if (arg.is<Matrix4x4f>()) {
-            auto& v = arg.as<Matrix4x4f&>();
-            args.push_back((void*)&v);
-        } else if (arg.is<glm::quat>()) {
-            auto& v = arg.as<glm::quat&>();
-            args.push_back((void*)&v);
-        } else if (arg.is<::REManagedObject*>()) {
-            args.push_back(arg.as<::REManagedObject*>());
-        } else if (arg.is<ValueType>()) {
-            auto& b = arg.as<ValueType&>();
-            args.push_back((void*)b.address());
-        } else {
-            args.push_back(arg.as<void*>());
+        if (!detail::build_arg_typed(l, arg, kind, out, vec_storage, result)) {
+            result = detail::build_arg_generic(l, arg, out, vec_storage);
         }
     }
-
-    return args;
 }
 
 sol::object call_native_func_direct(sol::object obj, ::sdk::REMethodDefinition* fn, sol::variadic_args va) {
     auto l = va.lua_state();
-    auto ret_ty = fn->get_return_type();
+    auto ret_ty = fn->get_invoke_plan()->ret_ty;
 
     if (ret_ty == nullptr) {
         return sol::make_object(l, sol::nil);
     }
 
     auto real_obj = get_real_obj(obj);
-    auto ret_val = fn->invoke(real_obj, build_args(va));
+
+    NativeArgs args{(size_t)va.size()};
+    build_args(va, fn, args);
+
+    auto ret_val = fn->invoke_span(real_obj, args.span());
 
     if (ret_val.exception_thrown) {
         throw sol::error("Invoke threw an exception");
@@ -1208,7 +1456,58 @@ void hook_vtable(sol::this_state s, ::REManagedObject* obj, ::sdk::REMethodDefin
 }
 
 namespace api::re_managed_object {
-sol::object index(sol::this_state s, sol::object lua_obj, sol::variadic_args args) {
+namespace detail {
+// Registry key for the per type member caches, only its address is used.
+static const char s_member_caches_key{};
+
+// Pushes the member cache for t, creating it if needed. Each cache maps a member name to
+// the REMethodDefinition userdata (methods) or a light userdata REField* (fields),
+// so a name only has to be resolved once per type rather than on every access.
+// Misses aren't cached, any string can go through to get_Item and the cache would grow without bound.
+// Methods stay REMethodDefinition userdata so scripts can keep doing obj.Method:call(...),
+// obj.Method:get_name() or pass it to sdk.hook, calling it goes through its __call.
+void push_member_cache(lua_State* l, ::sdk::RETypeDefinition* t) {
+    if (lua_rawgetp(l, LUA_REGISTRYINDEX, &s_member_caches_key) != LUA_TTABLE) {
+        lua_pop(l, 1);
+        lua_newtable(l);
+        lua_pushvalue(l, -1);
+        lua_rawsetp(l, LUA_REGISTRYINDEX, &s_member_caches_key);
+    }
+
+    if (lua_rawgetp(l, -1, t) != LUA_TTABLE) {
+        lua_pop(l, 1);
+        lua_newtable(l);
+        lua_pushvalue(l, -1);
+        lua_rawsetp(l, -3, t);
+    }
+
+    lua_remove(l, -2);
+}
+
+// Resolves name on t and stores the result in the member cache on top of the stack,
+// leaving the cached value (nil if there's no such member) pushed on top of it.
+void resolve_member(lua_State* l, ::sdk::RETypeDefinition* t, const char* name) {
+    if (auto field = t->get_field(name); field != nullptr) {
+        lua_pushlightuserdata(l, field);
+    } else if (auto method = t->get_method(name); method != nullptr) {
+        sol::stack::push(l, method);
+    } else {
+        lua_pushnil(l);
+        return;
+    }
+
+    lua_pushvalue(l, -1);
+    lua_setfield(l, -3, name);
+}
+
+// Returns through the stack, so the result doesn't take a registry reference on the way out.
+sol::stack_object push_result(lua_State* l, const sol::object& obj) {
+    obj.push(l);
+    return sol::stack_object{l, lua_gettop(l)};
+}
+}
+
+sol::stack_object index(sol::this_state s, sol::object lua_obj, sol::variadic_args args) {
     auto obj = lua_obj.as<REManagedObject*>();
     if (obj == nullptr) {
         throw sol::error("Attempted to index invalid REManagedObject");
@@ -1216,22 +1515,46 @@ sol::object index(sol::this_state s, sol::object lua_obj, sol::variadic_args arg
     auto index = args[0];
 
     auto type_def = utility::re_managed_object::get_type_definition(obj);
-    std::string name;
-    if (index.is<const char*>()) {
-        name = index.as<const char*>();
-        auto field = type_def->get_field(name.c_str());
-        if (field != nullptr) {
-            return api::sdk::get_native_field_from_field(lua_obj, type_def, field);
+    auto l = s.lua_state();
+
+    if (type_def == nullptr) {
+        lua_pushnil(l);
+        return sol::stack_object{l, lua_gettop(l)};
+    }
+
+    if (index.get_type() == sol::type::string) {
+        const auto name = index.as<const char*>();
+
+        detail::push_member_cache(l, type_def);
+
+        if (lua_getfield(l, -1, name) == LUA_TNIL) {
+            lua_pop(l, 1);
+            detail::resolve_member(l, type_def, name);
         }
-        auto method = type_def->get_method(name.c_str());
-        if (method != nullptr) {
-            return sol::make_object(s, method);
+
+        const auto member_ty = lua_type(l, -1);
+
+        if (member_ty == LUA_TLIGHTUSERDATA) {
+            auto field = (::sdk::REField*)lua_touserdata(l, -1);
+            lua_pop(l, 2);
+
+            return detail::push_result(l, api::sdk::get_native_field_from_field(lua_obj, type_def, field));
+        }
+
+        // The method's REMethodDefinition userdata, handed back as is
+        if (member_ty == LUA_TUSERDATA) {
+            lua_remove(l, -2);
+
+            return sol::stack_object{l, lua_gettop(l)};
         }
+
+        lua_pop(l, 2);
     }
 
     if (auto fn = type_def->get_method("get_Item"); fn != nullptr) {
         try {
-            const auto params = fn->get_param_types();
+            const auto plan = fn->get_invoke_plan();
+            const auto& params = plan->param_types;
 
             if (!params.empty()) {
                 static auto system_object = sdk::find_type_definition("System.Object");
@@ -1243,20 +1566,22 @@ sol::object index(sol::this_state s, sol::object lua_obj, sol::variadic_args arg
                 if (first_param != nullptr && first_param != system_object) {
                     if (index.is<const char*>()) {
                         if (first_param != system_string) {
-                            return sol::make_object(s, sol::nil);
+                            lua_pushnil(l);
+                            return sol::stack_object{l, lua_gettop(l)};
                         }
                     }
                 }
             }
 
-            return ::api::sdk::call_native_func_direct(lua_obj, fn, args);
+            return detail::push_result(l, ::api::sdk::call_native_func_direct(lua_obj, fn, args));
         } catch (...) {
             
         }
     }
 
     //throw sol::error("Attempted to index invalid REManagedObject field: " + name);
-    return sol::make_object(s, sol::nil);
+    lua_pushnil(l);
+    return sol::stack_object{l, lua_gettop(l)};
 }
 
 void new_index(sol::this_state s, sol::object lua_obj, sol::variadic_args args) {
@@ -1280,7 +1605,8 @@ void new_index(sol::this_state s, sol::object lua_obj, sol::variadic_args args)
     }
 
     if (auto fn = type_def->get_method("set_Item"); fn != nullptr) {
-        const auto params = fn->get_param_types();
+        const auto plan = fn->get_invoke_plan();
+        const auto& params = plan->param_types;
 
         if (!params.empty()) {
             static auto system_object = sdk::find_type_definition("System.Object");
@@ -1355,10 +1681,12 @@ void bindings::open_sdk(ScriptState* s) {
     lua.do_string(R"(
         _sol_lua_push_objects = setmetatable({}, { __mode = "v" })
         _sol_lua_push_usertypes = {}
-        _sol_lua_push_ref_counts = {}
-        _sol_lua_push_ephemeral_counts = {}
     )");
 
+    // reference counts live natively in the ScriptState, only the userdata cache has to be a (weak) table
+    lua_getglobal(lua.lua_state(), "_sol_lua_push_objects");
+    s->managed_object_refs().set_userdata_cache(luaL_ref(lua.lua_state(), LUA_REGISTRYINDEX));
+
     auto sdk = lua.create_table();
     sdk["get_tdb_version"] = []() -> int { return sdk::RETypeDB::get()->version; };
     sdk["game_namespace"] = game_namespace;
@@ -1387,6 +1715,57 @@ void bindings::open_sdk(ScriptState* s) {
     sdk["get_native_field"] = api::sdk::get_native_field;
     sdk["set_native_field"] = api::sdk::set_native_field;
     sdk["get_primary_camera"] = api::sdk::get_primary_camera;
+    // Game objects from the scene snapshot shared with the tools, so scripts don't each walk the scene.
+    // Only the roots unless max_depth asks for more levels below them.
+    // With a component type (name or type definition), the ones anywhere in the scene with a component of that type.
+    // Always a snapshot of the current frame, objects from an older one may already be destroyed.
+    sdk["get_scene_objects"] = [](sol::this_state s, sol::object component_type, sol::object max_depth) {
+        auto out = sol::state_view{s}.create_table();
+
+        ::sdk::RETypeDefinition* t{nullptr};
+
+        if (component_type.is<std::string>()) {
+            t = ::sdk::find_type_definition(component_type.as<std::string>());
+        } else if (component_type.is<::sdk::RETypeDefinition*>()) {
+            t = component_type.as<::sdk::RETypeDefinition*>();
+        }
+
+        if (t != nullptr) {
+            if (const auto components = ::sdk::find_scene_components(t)) {
+                auto i = 1;
+
+                for (auto component : *components) {
+                    if (const auto owner = utility::re_component::get_game_object(component); owner != nullptr) {
+                        out.raw_set(i++, (::REManagedObject*)owner);
+                    }
+                }
+
+                return out;
+            }
+
+            const auto snapshot = ::sdk::get_current_scene_snapshot(max_depth.is<uint32_t>() ? max_depth.as<uint32_t>() : UINT32_MAX);
+            auto i = 1;
+
+            for (auto index : snapshot->find_with_component(t)) {
+                out.raw_set(i++, (::REManagedObject*)snapshot->game_objects[index]);
+            }
+        } else if (component_type.is<sol::nil_t>()) {
+            const auto depth = max_depth.is<uint32_t>() ? max_depth.as<uint32_t>() : 0;
+            const auto snapshot = ::sdk::get_current_scene_snapshot(depth);
+            auto i = 1;
+
+            // The cached snapshot can go deeper than what was asked for
+            for (size_t index = 0; index < snapshot->size(); ++index) {
+                if (snapshot->depths[index] <= depth) {
+                    out.raw_set(i++, (::REManagedObject*)snapshot->game_objects[index]);
+                }
+            }
+        }
+
+        return out;
+    };
+    sdk["set_scene_snapshot_interval"] = &::sdk::set_scene_snapshot_interval;
+    sdk["get_scene_snapshot_interval"] = &::sdk::get_scene_snapshot_interval;
     sdk["hook"] = api::sdk::hook;
     sdk["hook_vtable"] = api::sdk::hook_vtable;
     sdk.new_enum("PreHookResult", "CALL_ORIGINAL", HookManager::PreHookResult::CALL_ORIGINAL, "SKIP_ORIGINAL", HookManager::PreHookResult::SKIP_ORIGINAL);
@@ -1545,14 +1924,18 @@ void bindings::open_sdk(ScriptState* s) {
         auto l = va.lua_state();
 
         auto real_obj = ::api::sdk::get_real_obj(obj);
-        auto ret_val = def->invoke(real_obj, ::api::sdk::build_args(va));
+
+        ::api::sdk::NativeArgs args{(size_t)va.size()};
+        ::api::sdk::build_args(va, def, args);
+
+        auto ret_val = def->invoke_span(real_obj, args.span());
 
         if (ret_val.exception_thrown) {
             throw sol::error("Invoke threw an exception");
         }
 
         // Convert return values to the correct Lua types.
-        auto ret_ty = def->get_return_type();
+        auto ret_ty = def->get_invoke_plan()->ret_ty;
 
         return ::api::sdk::parse_data(l, &ret_val, ret_ty, true);
     };
@@ -1749,10 +2132,34 @@ void bindings::open_sdk(ScriptState* s) {
         "get_size", &sdk::SystemArray::get_size,
         "get_element", &sdk::SystemArray::get_element,
         "get_elements", &sdk::SystemArray::get_elements,
+        // Addresses instead of objects, so nothing gets pushed through sol_lua_push.
+        // Reference arrays give the object addresses, value type arrays the address of each element.
+        "get_elements_raw", [](sol::this_state s, sdk::SystemArray* arr) {
+            auto out = sol::state_view{s}.create_table((int)arr->get_size(), 0);
+
+            arr->for_each([&](size_t i, void* element) {
+                out.raw_set(i + 1, (uintptr_t)element);
+            });
+
+            return out;
+        },
+        // fn(index, address) for each element, like get_elements_raw. Return false to stop.
+        "foreach", [](sdk::SystemArray* arr, sol::protected_function fn) {
+            arr->for_each([&](size_t i, void* element) {
+                auto result = fn(i, (uintptr_t)element);
+
+                if (!result.valid()) {
+                    throw sol::error{result.get<sol::error>()};
+                }
+
+                return !(result.get_type() == sol::type::boolean && result.get<bool>() == false);
+            });
+        },
         sol::meta_function::index, [](sol::this_state s, sdk::SystemArray* arr, sol::variadic_args args) {
             auto index = args[0];
             if (index.is<int32_t>()) {
-                return sol::make_object(s.L, arr->get_element(index));
+                sol::stack::push(s.L, arr->get_element(index));
+                return sol::stack_object{s.L, lua_gettop(s.L)};
             }
             return api::re_managed_object::index(s, sol::make_object(s.L, arr), args);
         },
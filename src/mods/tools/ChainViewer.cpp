@@ -7,6 +7,7 @@
 #include "REFramework.hpp"
 #include "utility/ImGui.hpp"
 #include "sdk/SceneManager.hpp"
+#include "sdk/SceneSnapshot.hpp"
 #include "sdk/RETypeDB.hpp"
 #include "sdk/REManagedObject.hpp"
 #include "sdk/Renderer.hpp"
@@ -96,23 +97,10 @@ void ChainViewer::on_frame() {
 
     auto context = sdk::get_thread_context();
 
-    static auto scene_def = sdk::find_type_definition("via.Scene");
-    auto first_transform = sdk::call_native_func_easy<RETransform*>(scene, scene_def, "get_FirstTransform");
-
-    if (first_transform == nullptr) {
-        return;
-    }
-
     m_delta_time.update();
 
-    static auto transform_def = utility::re_managed_object::get_type_definition(first_transform);
-    static auto folder_def = sdk::find_type_definition("via.Folder");
-    static auto gameobject_def = sdk::find_type_definition("via.GameObject");
-    static auto next_transform_method = transform_def->get_method("get_Next");
-    static auto child_transform_method = transform_def->get_method("get_Child");
+    static auto transform_def = sdk::find_type_definition("via.Transform");
     static auto get_gameobject_method = transform_def->get_method("get_GameObject");
-    static auto get_folder_path_method = folder_def->get_method("get_Path");
-    static auto get_folder_method = gameobject_def->get_method("get_Folder");
 
     auto camera = sdk::get_primary_camera();
 
@@ -165,10 +153,9 @@ void ChainViewer::on_frame() {
     ImGui::Begin("Chains");
 
     static auto chain_type = sdk::find_type_definition("via.motion.Chain");
-    static auto chain_runtime_type = chain_type->get_runtime_type();
     static auto chain_re_type = chain_type->get_type();
 
-    auto attempt_display_chains = [&](RETransform* transform) {
+    auto attempt_display_chains = [&](RETransform* transform, const std::string& owner_name, const std::string& folder_path) {
         auto chain = utility::re_component::find<regenny::via::motion::Chain>(transform, chain_re_type);
         bool made = false;
 
@@ -176,18 +163,6 @@ void ChainViewer::on_frame() {
             return;
         }
 
-        auto owner = get_gameobject_method->call<REGameObject*>(context, transform);
-
-        if (owner == nullptr) {
-            return;
-        }
-
-        auto owner_name = utility::re_string::get_string(owner->name);
-
-        if (owner_name.empty()) {
-            owner_name = "";
-        }
-
         ImGui::PushID(chain);
         made = ImGui::TreeNode(chain, owner_name.data());
 
@@ -201,15 +176,9 @@ void ChainViewer::on_frame() {
             col.w = glm::abs(glm::cos(m_pulse_time * glm::pi<float>()));
         }
 
-        const auto owner_folder = get_folder_method->call<::REManagedObject*>(context, owner);
-
-        if (owner_folder != nullptr) {
-            const auto folder_path = get_folder_path_method->call<::SystemString*>(context, owner_folder);
-
-            if (folder_path != nullptr) {       
-                ImGui::SameLine();
-                ImGui::TextColored(ImVec4{100.0f / 255.0f, 149.0f / 255.0f, 237.0f / 255.0f, 255 / 255.0f}, " [%s]", utility::re_string::get_string(folder_path).data());
-            }
+        if (!folder_path.empty()) {
+            ImGui::SameLine();
+            ImGui::TextColored(ImVec4{100.0f / 255.0f, 149.0f / 255.0f, 237.0f / 255.0f, 255 / 255.0f}, " [%s]", folder_path.data());
         }
 
         if (made) {
@@ -382,47 +351,22 @@ void ChainViewer::on_frame() {
         ImGui::PopID();
     };
 
-    static auto scene_find_components_method = scene_def->get_method("findComponents(System.Type)");
-
-    if (scene_find_components_method != nullptr && chain_runtime_type != nullptr) {
-        const auto components = scene_find_components_method->call<sdk::SystemArray*>(context, scene, chain_runtime_type);
-        
-        if (components != nullptr && !components->empty()) {
-            for (auto v : *components) {
-                if (v == nullptr) {
-                    continue;
-                }
-
-                const auto component = (::REComponent*)v;
-                const auto owner = get_gameobject_method->call<::REGameObject*>(context, component);
-
-                if (owner == nullptr) {
-                    continue;
-                }
-
-                const auto transform = owner->transform;
+    if (const auto components = sdk::find_scene_components(chain_type)) {
+        for (auto component : *components) {
+            const auto owner = utility::re_component::get_game_object(component);
 
-                if (transform == nullptr) {
-                    continue;
-                }
-
-                attempt_display_chains(transform);
+            if (owner == nullptr || owner->transform == nullptr) {
+                continue;
             }
+
+            attempt_display_chains(owner->transform, utility::re_string::get_string(owner->name), sdk::get_folder_path(owner));
         }
     } else {
-        for (auto transform = first_transform; 
-            transform != nullptr; 
-            transform = next_transform_method->call<RETransform*>(context, transform)) 
-        {
-            attempt_display_chains(transform);
+        // Two levels below the roots, as far as the old walk went
+        const auto snapshot = sdk::get_current_scene_snapshot(2);
 
-            for (auto t = child_transform_method->call<RETransform*>(context, transform); t != nullptr; t = next_transform_method->call<RETransform*>(context, t)) {
-                attempt_display_chains(t);
-
-                for (auto t2 = child_transform_method->call<RETransform*>(context,t); t2 != nullptr; t2 = next_transform_method->call<RETransform*>(context, t2)) {
-                    attempt_display_chains(t2);
-                }
-            }
+        for (auto i : snapshot->find_with_component(chain_type)) {
+            attempt_display_chains(snapshot->transforms[i], snapshot->names[i], snapshot->folder_paths[i]);
         }
     }
 
@@ -1,5 +1,7 @@
 #include "REFramework.hpp"
 #include "sdk/SceneManager.hpp"
+#include "sdk/SceneSnapshot.hpp"
+#include "sdk/Renderer.hpp"
 #include "sdk/RETypeDB.hpp"
 #include "sdk/REManagedObject.hpp"
 
@@ -54,97 +56,37 @@ void GameObjectsDisplay::on_frame() {
         return;
     }
 
-    auto scene = sdk::get_current_scene();
+    const auto snapshot = sdk::get_scene_snapshot();
 
-    if (scene == nullptr) {
+    if (snapshot->size() == 0) {
         return;
     }
 
-    auto context = sdk::get_thread_context();
+    // Only the scene's root objects
+    std::vector<size_t> indices{};
+    std::vector<Vector3f> positions{};
 
-    static auto scene_def = sdk::find_type_definition("via.Scene");
-    auto first_transform = sdk::call_native_func_easy<RETransform*>(scene, scene_def, "get_FirstTransform");
-
-    if (first_transform == nullptr) {
-        return;
-    }
-
-    static auto transform_def = utility::re_managed_object::get_type_definition(first_transform);
-    static auto next_transform_method = transform_def->get_method("get_Next");
-    static auto get_gameobject_method = transform_def->get_method("get_GameObject");
-    static auto get_position_method = transform_def->get_method("get_Position");
-    static auto get_axisz_method = transform_def->get_method("get_AxisZ");
-
-    auto math = sdk::get_native_singleton("via.math");
-    auto math_t = sdk::find_type_definition("via.math");
-
-    auto camera = sdk::get_primary_camera();
-
-    if (camera == nullptr) {
-        return;
-    }
-
-    auto main_view = sdk::get_main_view();
-
-    if (main_view == nullptr) {
-        return;
-    }
-
-    auto camera_gameobject = get_gameobject_method->call<REGameObject*>(context, camera);
-    auto camera_transform = camera_gameobject->transform;
-
-    Vector4f camera_origin{};
-    get_position_method->call<void*>(&camera_origin, context, camera_transform);
-
-    camera_origin.w = 1.0f;
-
-    Vector4f camera_forward{};
-    get_axisz_method->call<void*>(&camera_forward, context, camera_transform);
-
-    camera_forward.w = 1.0f;
-
-    // Translate 2d position to 3d position (screen to world)
-    Matrix4x4f proj{}, view{};
-    float screen_size[2]{};
-    sdk::call_object_func<void*>(camera, "get_ProjectionMatrix", &proj, context, camera);
-    sdk::call_object_func<void*>(camera, "get_ViewMatrix", &view, context, camera);
-    sdk::call_object_func<void*>(main_view, "get_WindowSize", &screen_size, context, main_view);
-
-    static auto world_to_screen = math_t->get_method("worldPos2ScreenPos(via.vec3, via.mat4, via.mat4, via.Size)");
-
-    Vector4f pos{};
-    Vector4f screen_pos{};
-
-    auto draw_list = ImGui::GetBackgroundDrawList();
-
-    for (auto transform = first_transform; 
-        transform != nullptr; 
-        transform = next_transform_method->call<RETransform*>(context, transform)) 
-    {
-        auto owner = get_gameobject_method->call<REGameObject*>(context, transform);
-
-        if (owner == nullptr) {
+    for (size_t i = 0; i < snapshot->size(); ++i) {
+        if (snapshot->depths[i] != 0 || snapshot->names[i].empty()) {
             continue;
         }
 
-        auto owner_name = utility::re_string::get_string(owner->name);
-
-        if (owner_name.empty()) {
-            continue;
-        }
+        indices.push_back(i);
+        positions.push_back(Vector3f{snapshot->positions[i]});
+    }
 
-        get_position_method->call<void*>(&pos, context, transform);
-        pos.w = 1.0f;
+    // Behind the camera comes back empty
+    std::vector<std::optional<Vector2f>> screen_positions(positions.size());
+    sdk::renderer::world_to_screen(positions, screen_positions);
 
-        const auto delta = pos - camera_origin;
+    auto draw_list = ImGui::GetBackgroundDrawList();
 
-        // behind camera
-        if (glm::dot(Vector3f{delta}, Vector3f{-camera_forward}) <= 0.0f) {
+    for (size_t i = 0; i < indices.size(); ++i) {
+        if (!screen_positions[i]) {
             continue;
         }
 
-        world_to_screen->call<void*>(&screen_pos, context, &pos, &view, &proj, &screen_size);
-        draw_list->AddText(ImVec2(screen_pos.x, screen_pos.y), ImGui::GetColorU32(ImVec4(1.0f, 1.0f, 1.0f, 1.0f)), owner_name.c_str());
+        const auto& screen_pos = *screen_positions[i];
+        draw_list->AddText(ImVec2(screen_pos.x, screen_pos.y), ImGui::GetColorU32(ImVec4(1.0f, 1.0f, 1.0f, 1.0f)), snapshot->names[indices[i]].c_str());
     }
 }
-
@@ -4,6 +4,9 @@
 #include <deque>
 #include <algorithm>
 #include <regex>
+#include <map>
+#include <future>
+#include <thread>
 #include <json.hpp>
 
 #include <windows.h>
@@ -15,6 +18,7 @@
 #include <utility/ImGui.hpp>
 #include "sdk/Renderer.hpp"
 #include "sdk/MotionFsm2Layer.hpp"
+#include "sdk/TDBSnapshot.hpp"
 
 #include "../mods/ScriptRunner.hpp"
 
@@ -347,6 +351,13 @@ void ObjectExplorer::on_draw_dev_ui() {
         t.detach();
     }
 
+    ImGui::SameLine();
+    ImGui::Checkbox("Compact il2cpp_dump.json", &m_compact_sdk_dump);
+
+    if (ImGui::Button("Dump TDB Snapshot")) {
+        sdk::write_tdb_snapshot(REFramework::get_persistent_dir("tdb_snapshot.bin"), REFRAMEWORK_GAME_NAME);
+    }
+
     if (m_dumping_sdk) {
         const char* overlay = nullptr;
         float progress = m_sdk_dump_progress;
@@ -362,9 +373,6 @@ void ObjectExplorer::on_draw_dev_ui() {
         case SdkDumpStage::DUMP_TYPES: 
             overlay = "Dumping Types...";
             break;
-        case SdkDumpStage::DUMP_RSZ:
-            overlay = "Dumping RSZ...";
-            break;
         case SdkDumpStage::DUMP_METHODS:
             overlay = "Dumping Methods...";
             break;
@@ -374,15 +382,15 @@ void ObjectExplorer::on_draw_dev_ui() {
         case SdkDumpStage::DUMP_PROPERTIES:
             overlay = "Dumping Properties...";
             break;
-        case SdkDumpStage::DUMP_RSZ_2:
-            overlay = "Adjusting RSZ...";
-            break;
         case SdkDumpStage::DUMP_DESERIALIZER_CHAIN:
             overlay = "Dumping Deserializer Chains...";
             break;
         case SdkDumpStage::DUMP_NON_TDB_TYPES:
             overlay = "Dumping Non-TDB Types...";
             break;
+        case SdkDumpStage::WRITE_JSON:
+            overlay = "Writing il2cpp_dump.json...";
+            break;
         case SdkDumpStage::GENERATE_SDK:
             overlay = "Generating IDA SDK...";
             progress = static_cast<float>(ImGui::GetTime()) * -0.35f;
@@ -507,65 +515,38 @@ void ObjectExplorer::on_draw_dev_ui() {
 
     if (m_do_init || ImGui::InputText("Type Name", m_type_name.data(), 256)) {
         m_displayed_types.clear();
+        m_search.reset();
 
         if (auto t = get_type(m_type_name.data())) {
             m_displayed_types.push_back(t);
-        }
-        else {
-            std::function<bool(const std::string&)> search_algo{};
-
-            if (m_search_using_regex) {
-                search_algo = [this](const auto& a) { return std::regex_search(a, std::regex{ m_type_name.data() }); };
-            } else {
-                search_algo = [this](const auto& a) { return a.find(m_type_name.data()) != std::string::npos; };
-            }
-
-            try {
-                // Search the list for a partial match instead
-                for (auto i = std::find_if(m_sorted_types.begin(), m_sorted_types.end(), search_algo);
-                    i != m_sorted_types.end();
-                    i = std::find_if(i + 1, m_sorted_types.end(), search_algo))
-                {
-                    if (auto t = get_type(*i)) {
-                        m_displayed_types.push_back(t);
-                    }
-                }
-            } catch (...) {
-
-            }
+        } else {
+            // Search the list for a partial match instead
+            start_search(SearchKind::TYPE, m_type_name.data());
         }
     }
 
     if (m_do_init || ImGui::InputText("Method Signature", m_type_member.data(), 256)) {
         m_displayed_types.clear();
+        m_search.reset();
         m_type_field[0] = '\0';
 
         if (!std::string_view{m_type_member.data()}.empty()) {
-            for (auto i = std::find_if(m_sorted_types.begin(), m_sorted_types.end(), [this](const auto& a) { return is_filtered_type(a); });
-                i != m_sorted_types.end();
-                i = std::find_if(i + 1, m_sorted_types.end(), [this](const auto& a) { return is_filtered_type(a); })) {
-                if (auto t = get_type(*i)) {
-                    m_displayed_types.push_back(t);
-                }
-            }
+            start_search(SearchKind::METHOD, m_type_member.data());
         }
     }
 
     if (m_do_init || ImGui::InputText("Field Signature", m_type_field.data(), 256)) {
         m_displayed_types.clear();
+        m_search.reset();
         m_type_member[0] = '\0';
 
         if (!std::string_view{m_type_field.data()}.empty()) {
-            for (auto i = std::find_if(m_sorted_types.begin(), m_sorted_types.end(), [this](const auto& a) { return is_filtered_type(a); });
-                i != m_sorted_types.end();
-                i = std::find_if(i + 1, m_sorted_types.end(), [this](const auto& a) { return is_filtered_type(a); })) {
-                if (auto t = get_type(*i)) {
-                    m_displayed_types.push_back(t);
-                }
-            }
+            start_search(SearchKind::FIELD, m_type_field.data());
         }
     }
 
+    update_search();
+
     if (ImGui::InputText("Method Address", m_method_address.data(), 17, ImGuiInputTextFlags_::ImGuiInputTextFlags_CharsHexadecimal)) {
         m_displayed_method = nullptr;
 
@@ -755,12 +736,12 @@ void ObjectExplorer::on_lua_state_created(sol::state& lua) {
 }
 
 #ifdef TDB_DUMP_ALLOWED
-std::shared_ptr<detail::ParsedType> ObjectExplorer::init_type(nlohmann::json& il2cpp_dump, sdk::RETypeDB* tdb, uint32_t i) {
-    if (g_itypedb.find(i) != g_itypedb.end()) {
-        return g_itypedb[i];
+std::shared_ptr<detail::ParsedType> ObjectExplorer::init_type(sdk::RETypeDB* tdb, uint32_t i) {
+    if (auto it = g_itypedb.find(i); it != g_itypedb.end()) {
+        return it->second;
     }
 
-    auto desc = init_type_min(il2cpp_dump, tdb, i);
+    auto desc = init_type_min(tdb, i);
 
     g_itypedb[i] = desc;
     g_fqntypedb[desc->t->get_fqn_hash()] = desc;
@@ -774,14 +755,11 @@ std::string ObjectExplorer::generate_full_name(sdk::RETypeDB* tdb, uint32_t i) {
     }
 
     auto& raw_t = (*tdb->types)[i];
-    auto full_name = raw_t.get_full_name();
 
-    spdlog::info("{:s}", full_name);
-
-    return full_name;
+    return raw_t.get_full_name();
 }
 
-std::shared_ptr<detail::ParsedType> ObjectExplorer::init_type_min(json& il2cpp_dump, sdk::RETypeDB* tdb, uint32_t i) {
+std::shared_ptr<detail::ParsedType> ObjectExplorer::init_type_min(sdk::RETypeDB* tdb, uint32_t i) {
     auto& t = *tdb->get_type(i);
     auto br = BitReader{&t};
 
@@ -794,31 +772,14 @@ std::shared_ptr<detail::ParsedType> ObjectExplorer::init_type_min(json& il2cpp_d
     return desc;
 }
 
-void ObjectExplorer::export_deserializer_chain(nlohmann::json& il2cpp_dump, sdk::RETypeDB* tdb, REType* t, std::optional<std::string> real_name) {
+nlohmann::json ObjectExplorer::get_deserializer_chain(sdk::RETypeDB* tdb, REType* t) {
     /*const auto is_clr_type = (((uint8_t)t->flags >> 5) & 1) != 0;
 
     if (is_clr_type) {
         return;
     }*/
 
-    std::string full_name{};
-
     // Export info about native deserializers for the python script
-    if (!real_name) {
-        auto tdef = utility::re_type::get_type_definition(t);
-        full_name = t->classInfo != nullptr ? generate_full_name(tdb, tdef->get_index()) : t->name;
-    }
-    else {
-        full_name = *real_name;
-    }
-
-    auto& type_entry = il2cpp_dump[full_name];
-
-    // already done it
-    if (type_entry.contains("deserializer_chain") || type_entry.contains("RSZ")) {
-        return;
-    }
-
     std::deque<nlohmann::json> chain_raw{};
 
     for (auto super = t; super != nullptr; super = (sdk::RETypeCLR*)super->super) {
@@ -832,7 +793,7 @@ void ObjectExplorer::export_deserializer_chain(nlohmann::json& il2cpp_dump, sdk:
         json des_entry{};
 
         auto tdef = utility::re_type::get_type_definition(super);
-        
+
         des_entry["address"] = (std::stringstream{} << "0x" << std::hex << deserializer_normalized).str();
         des_entry["name"] = super->classInfo != nullptr ? generate_full_name(tdb, tdef->get_index()) : super->name;
 
@@ -842,109 +803,173 @@ void ObjectExplorer::export_deserializer_chain(nlohmann::json& il2cpp_dump, sdk:
 
     // dont create an empty entry
     if (chain_raw.empty()) {
-        return;
+        return json{};
     }
 
-    type_entry["deserializer_chain"] = chain_raw;
+    return chain_raw;
 }
-#endif
 
-void ObjectExplorer::generate_sdk() {
-    // enums
-    //auto ref = utility::scan(g_framework->get_module().as<HMODULE>(), "66 C7 40 18 01 01 48 89 05 ? ? ? ?");
-    //auto& l = *(std::map<uint64_t, REEnumData>*)(utility::calculate_absolute(*ref + 9));
+nlohmann::json ObjectExplorer::get_field_default(sdk::RETypeDB* tdb, const detail::ParsedField& pf, genny::Constant* cs) {
+    if (pf.init_data_offset == 0 || pf.type == nullptr) {
+        return json{};
+    }
 
-    m_dumping_sdk = true;
-    m_sdk_dump_stage = SdkDumpStage::DUMP_INITIALIZATION;
-    uint32_t k = 0;
-    auto n_types = 0ull;
+    auto init_data = &(*tdb->bytePool)[pf.init_data_offset];
 
-    genny::Sdk sdk{};
-    auto g = sdk.global_ns();
+    // WACKY
+    if (pf.init_data_offset < 0) {
+        init_data = &((uint8_t*)tdb->stringPool)[pf.init_data_offset * -1];
+    }
 
-    g->type("int8_t")->size(1);
-    g->type("int16_t")->size(2);
-    g->type("int32_t")->size(4);
-    g->type("int64_t")->size(8);
-    g->type("wchar_t")->size(2);
-    g->type("uint8_t")->size(1);
-    g->type("uint16_t")->size(2);
-    g->type("uint32_t")->size(4);
-    g->type("uint64_t")->size(8);
-    g->type("float")->size(4);
-    g->type("double")->size(8);
-    g->type("bool")->size(1);
-    g->type("char")->size(1);
-    g->type("int")->size(4);
-    g->type("void")->size(0);
-    //g->type("void*")->size(8);
+    auto init_data_type = pf.type;
+    auto full_name{ init_data_type->full_name };
 
-    json il2cpp_dump{};
+    // edge case
+    if (pf.type->super != nullptr && pf.type->super->full_name == "System.Enum") {
+        switch (pf.type->t->get_size() - pf.type->super->t->get_size()) {
+        case 1:
+            full_name = "System.Byte";
+            break;
+        case 2:
+            full_name = "System.UInt16";
+            break;
+        case 4:
+            full_name = "System.UInt32";
+            break;
+        case 8:
+            full_name = "System.UInt64";
+            break;
+        }
+    }
 
-#ifdef TDB_DUMP_ALLOWED
-    auto tdb = (sdk::RETypeDB*)reframework::get_types()->get_type_db();
+    json out{};
 
-    // Types
-    for (uint32_t i = 0; i < tdb->numTypes; ++i) {
-        init_type(il2cpp_dump, tdb, i);
+    switch (utility::hash(full_name)) {
+    case "System.Boolean"_fnv:
+        out = *(bool*)init_data;
+        if (cs != nullptr) cs->integer(*(bool*)init_data);
+        break;
+    case "System.Char"_fnv:
+        out = *(wchar_t*)init_data;
+        if (cs != nullptr) cs->integer(*(wchar_t*)init_data);
+        break;
+    case "System.Byte"_fnv:
+        out = *(uint8_t*)init_data;
+        if (cs != nullptr) cs->integer(*(uint8_t*)init_data);
+        break;
+    case "System.SByte"_fnv:
+        out = *(int8_t*)init_data;
+        if (cs != nullptr) cs->integer(*(int8_t*)init_data);
+        break;
+    case "System.UInt16"_fnv:
+        out = *(uint16_t*)init_data;
+        if (cs != nullptr) cs->integer(*(uint16_t*)init_data);
+        break;
+    case "System.Int16"_fnv:
+        out = *(int16_t*)init_data;
+        if (cs != nullptr) cs->integer(*(int16_t*)init_data);
+        break;
+    case "System.UInt32"_fnv:
+        out = *(uint32_t*)init_data;
+        if (cs != nullptr) cs->integer(*(uint32_t*)init_data);
+        break;
+    case "System.Int32"_fnv:
+        out = *(int32_t*)init_data;
+        if (cs != nullptr) cs->integer(*(int32_t*)init_data);
+        break;
+    case "System.UInt64"_fnv:
+        out = *(uint64_t*)init_data;
+        if (cs != nullptr) cs->integer(*(uint64_t*)init_data);
+        break;
+    case "System.Int64"_fnv:
+        out = *(int64_t*)init_data;
+        if (cs != nullptr) cs->integer(*(int64_t*)init_data);
+        break;
+    case "System.Single"_fnv:
+        out = *(float*)init_data;
+        if (cs != nullptr) cs->real(*(float*)init_data);
+        break;
+    case "System.Double"_fnv:
+        out = *(double*)init_data;
+        if (cs != nullptr) cs->real(*(double*)init_data);
+        break;
+    case "System.String"_fnv:
+        out = (char*)init_data;
+        if (cs != nullptr) cs->string((char*)init_data);
+        break;
+    default:
+        out = "REFRAMEWORK_UNIMPLEMENTED_INIT_TYPE";
+        break;
     }
 
-    for (uint32_t i = 0; i < tdb->numTypes; ++i) {
-        auto desc = init_type(il2cpp_dump, tdb, i);
+    return out;
+}
 
-        desc->full_name = generate_full_name(tdb, i);
-        g_stypedb[desc->full_name] = desc;
+nlohmann::json ObjectExplorer::dump_param(const detail::ParsedParams& p) {
+    auto param_entry = json{
+        {"type", p.type->full_name},
+        {"name", p.name},
+    };
+
+    if (auto param_flags = get_full_enum_value_name("via.clr.ParamFlag", p.flags); !param_flags.empty()) {
+        param_entry["flags"] = param_flags;
     }
 
-    m_sdk_dump_stage = SdkDumpStage::DUMP_TYPES;
+#if TDB_VER >= 69
+    if (auto param_modifier = get_full_enum_value_name("via.clr.ParamModifier", p.modifier); !param_modifier.empty()) {
+        param_entry["modifier"] = param_modifier;
+    }
+#endif
 
-    // Finish off initialization of types
-    for (uint32_t i = 0; i < tdb->numTypes; ++i) {
-        m_sdk_dump_progress = static_cast<float>(i) / tdb->numTypes;
+    return param_entry;
+}
 
-        auto desc = init_type(il2cpp_dump, tdb, i);
-        auto& t = *desc->t;
+// Builds the il2cpp_dump.json record for every TDB type sharing one full name.
+// Only reads the parsed type graph, so it's safe to call from the writer threads.
+void ObjectExplorer::dump_type_record(nlohmann::json& record, sdk::RETypeDB* tdb, const std::vector<uint32_t>& indices) {
+    const auto get_desc = [](uint32_t i) -> const detail::ParsedType* {
+        if (auto it = g_itypedb.find(i); it != g_itypedb.end()) {
+            return it->second.get();
+        }
 
-        auto tdef = desc->t;
+        return nullptr;
+    };
 
-        auto& type_entry = (il2cpp_dump[desc->full_name] = {});
+    // Types with the same name used to overwrite each other in the DOM, last one wins
+    if (auto desc = get_desc(indices.back()); desc != nullptr) {
+        auto& t = *desc->t;
         const auto crc = t.get_crc_hash();
         const auto fqn = t.get_fqn_hash();
         const auto type_info = t.get_type();
 
-        type_entry = {
+        record = {
             {"address", (std::stringstream{} << std::hex << get_original_va(&t)).str()},
-            {"id", i},
+            {"id", indices.back()},
             {"fqn", (std::stringstream{} << std::hex << fqn).str()},
             {"crc", (std::stringstream{} << std::hex << crc).str()},
             {"size", (std::stringstream{} << std::hex << t.get_size()).str()},
         };
 
-        if (tdef->declaring_typeid != 0) {
-            desc->owner = init_type(il2cpp_dump, tdb, tdef->declaring_typeid);
-        }
-
-        if (tdef->parent_typeid != 0) {
-            desc->super = init_type(il2cpp_dump, tdb, tdef->parent_typeid);
-            type_entry["parent"] = desc->super->full_name;
+        if (desc->super != nullptr) {
+            record["parent"] = desc->super->full_name;
         }
 
         if (auto type_flags_str = get_full_enum_value_name("via.clr.TypeFlag", t.type_flags); !type_flags_str.empty()) {
-            type_entry["flags"] = type_flags_str;
+            record["flags"] = type_flags_str;
         }
 
         if (type_info != nullptr && type_info->name != nullptr) {
             if (type_info->name != desc->full_name) {
-                type_entry["native_typename"] = type_info->name;
+                record["native_typename"] = type_info->name;
             }
         }
 
-        type_entry["name_hierarchy"] = t.get_name_hierarchy();
-        type_entry["is_generic_type"] = t.is_generic_type();
-        type_entry["is_generic_type_definition"] = t.is_generic_type_definition();
+        record["name_hierarchy"] = t.get_name_hierarchy();
+        record["is_generic_type"] = t.is_generic_type();
+        record["is_generic_type_definition"] = t.is_generic_type_definition();
 
         if (auto gtd = t.get_generic_type_definition(); gtd != nullptr) {
-            type_entry["generic_type_definition"] = gtd->get_full_name();
+            record["generic_type_definition"] = gtd->get_full_name();
         }
 
         const auto generics = t.get_generic_argument_types();
@@ -952,12 +977,12 @@ void ObjectExplorer::generate_sdk() {
         if (!generics.empty()) {
             for (auto gt : generics) {
                 if (gt != nullptr) {
-                    type_entry["generic_arg_types"].push_back({
+                    record["generic_arg_types"].push_back({
                         {"type", gt->get_full_name()},
                         {"typeid", gt->get_index()}
                     });
                 } else {
-                    type_entry["generic_arg_types"].push_back({
+                    record["generic_arg_types"].push_back({
                         {"type", "unknown"},
                         {"typeid", 0}
                     });
@@ -966,65 +991,382 @@ void ObjectExplorer::generate_sdk() {
         }
     }
 
-    m_sdk_dump_stage = SdkDumpStage::DUMP_RSZ;
+    for (const auto i : indices) {
+        const auto desc = get_desc(i);
 
-    // Initialize RSZ
-    // Dont do it in init_type because it calls init_type
-    for (uint32_t i = 0; i < tdb->numTypes; ++i) {
-        m_sdk_dump_progress = static_cast<float>(i) / tdb->numTypes;
+        if (desc == nullptr) {
+            continue;
+        }
 
-        auto pt = init_type(il2cpp_dump, tdb, i);
-        auto& t = *pt->t;
+        const auto type_info = desc->t->get_type();
 
-        const auto type_info = t.get_type();
+        // RSZ
+        if (type_info != nullptr) {
+            if (utility::re_type::is_clr_type(type_info)) {
+                auto clr_t = (sdk::RETypeCLR*)type_info;
+                auto& deserialize_list = clr_t->deserializers;
 
-        if (type_info == nullptr) {
-            continue;
-        }
+                for (const auto& sequence : deserialize_list) {
+                    const auto code = sequence.get_code();
+                    const auto size = sequence.get_size();
+                    const auto align = sequence.get_align();
+                    const auto depth = sequence.get_depth();
+                    const auto is_array = sequence.is_array();
+                    const auto is_static = sequence.is_static();
 
-        if (!utility::re_type::is_clr_type(type_info)) {
-            export_deserializer_chain(il2cpp_dump, tdb, type_info, pt->full_name);
-            continue;
+                    auto rsz_entry = json{};
+
+                    rsz_entry["type"] = generate_full_name(tdb, (sequence.get_native_type())->get_index());
+#if TDB_VER >= 69
+                    rsz_entry["code"] = get_enum_value_name("via.typeinfo.TypeCode", code);
+#else
+                    rsz_entry["code"] = g_typecode_names[code];
+#endif
+                    rsz_entry["code_id"] = code;
+                    rsz_entry["align"] = align;
+                    rsz_entry["size"] = (std::stringstream{} << "0x" << std::hex << (uint32_t)size).str();
+                    rsz_entry["depth"] = depth;
+                    rsz_entry["array"] = is_array;
+                    rsz_entry["static"] = is_static;
+                    rsz_entry["offset_from_fieldptr"] = (std::stringstream{} << "0x" << std::hex << sequence.offset).str();
+
+#if TDB_VER <= 49
+                    rsz_entry["potential_name"] = sequence.prop->name;
+#else
+                    // Try and guess what the field name is for the RSZ entry
+                    // In RE7, the deserializer points to the reflection property,
+                    // so we can just grab the name from there instead of comparing field offsets.
+                    if (i != 0) {
+                        uint32_t fieldptr_adjustment = 0;
+                        auto depth_t = desc;
+
+                        // Get the topmost one because of depth
+                        for (auto d = 0; d < (int32_t)depth; ++d) {
+                            if (!depth_t->t->has_fieldptr_offset() || depth_t->super == nullptr) {
+                                break;
+                            }
+
+                            const auto field_ptr = depth_t->t->get_fieldptr_offset();
+
+                            depth_t = depth_t->super.get();
+
+                            if (!depth_t->t->has_fieldptr_offset()) {
+                                break;
+                            }
+
+                            const auto field_ptr2 = depth_t->t->get_fieldptr_offset();
+
+                            fieldptr_adjustment += field_ptr - field_ptr2;
+                        }
+
+                        for (auto& f : depth_t->parsed_fields) {
+                            if (f->f->is_static() != is_static) {
+                                continue;
+                            }
+
+                            if (f->offset_from_fieldptr + fieldptr_adjustment == (uint32_t)sequence.offset) {
+                                rsz_entry["potential_name"] = f->name;
+                                break;
+                            }
+                        }
+                    }
+#endif
+
+                    record["RSZ"].emplace_back(std::move(rsz_entry));
+                }
+            }
+
+            // do this because it empty
+            if (!record.contains("RSZ") && !record.contains("deserializer_chain")) {
+                if (auto chain = get_deserializer_chain(tdb, type_info); !chain.is_null()) {
+                    record["deserializer_chain"] = std::move(chain);
+                }
+            }
         }
 
-        auto clr_t = (sdk::RETypeCLR*)type_info;
-        auto& deserialize_list = clr_t->deserializers;
+        // Methods
+        for (const auto& pm : desc->parsed_methods) {
+            auto& method_entry = record["methods"][pm->name + std::to_string(pm->index)];
 
-        for (const auto& sequence : deserialize_list) {
-            const auto code = sequence.get_code();
-            const auto size = sequence.get_size();
-            const auto align = sequence.get_align();
-            const auto depth = sequence.get_depth();
-            const auto is_array = sequence.is_array();
-            const auto is_static = sequence.is_static();
-            
-            auto rsz_entry = json{};
-            
+            method_entry["id"] = pm->index;
+            method_entry["function"] = (std::stringstream{} << std::hex << get_original_va(pm->m->get_function())).str();
+
+            if (auto impl_flags_str = get_full_enum_value_name("via.clr.MethodImplFlag", pm->impl_flags); !impl_flags_str.empty()) {
+                method_entry["impl_flags"] = impl_flags_str;
+            }
+
+            if (auto flags_str = get_full_enum_value_name("via.clr.MethodFlag", pm->flags); !flags_str.empty()) {
+                method_entry["flags"] = flags_str;
+            }
+
+            if (pm->vtable_index >= 0) {
+                method_entry["vtable_index"] = pm->vtable_index;
+            }
+
+            // Invoke wrapper for arbitrary amount of arguments, so we can just pass it on the VM stack/context as an array
+            method_entry["invoke_id"] = pm->invoke_id;
 
-            rsz_entry["type"] = generate_full_name(tdb, (sequence.get_native_type())->get_index());
 #if TDB_VER >= 69
-            rsz_entry["code"] = get_enum_value_name("via.typeinfo.TypeCode", code);
+            method_entry["returns"] = pm->return_val != nullptr ? dump_param(*pm->return_val) : json{};
 #else
-            rsz_entry["code"] = g_typecode_names[code];
+            const auto return_type = pm->m->get_return_type();
+
+            method_entry["returns"] = json{
+                {"type", return_type != nullptr ? return_type->get_full_name() : ""},
+                {"name", ""},
+            };
 #endif
-            rsz_entry["code_id"] = code;
-            rsz_entry["align"] = align;
-            rsz_entry["size"] = (std::stringstream{} << "0x" << std::hex << (uint32_t)size).str();
-            rsz_entry["depth"] = depth;
-            rsz_entry["array"] = is_array;
-            rsz_entry["static"] = is_static;
-            rsz_entry["offset_from_fieldptr"] = (std::stringstream{} << "0x" << std::hex << sequence.offset).str();
 
-#if TDB_VER <= 49
-            rsz_entry["potential_name"] = sequence.prop->name;
+            for (const auto& p : pm->params) {
+                method_entry["params"].emplace_back(p != nullptr ? dump_param(*p) : json{});
+            }
+        }
+
+        // Fields
+        for (const auto& pf : desc->parsed_fields) {
+            auto& field_entry = record["fields"][pf->name];
+
+            field_entry = {
+                {"id", pf->index},
+                {"type", pf->type != nullptr ? pf->type->full_name : ""},
+                {"offset_from_base", (std::stringstream{} << "0x" << std::hex << pf->offset_from_base).str()},
+                {"offset_from_fieldptr", (std::stringstream{} << "0x" << std::hex << pf->offset_from_fieldptr).str()},
+#if TDB_VER >= 66
+                {"init_data_index", pf->init_data_index}
 #endif
+            };
+
+            if (auto field_flags_str = get_full_enum_value_name("via.clr.FieldFlag", pf->flags); !field_flags_str.empty()) {
+                field_entry["flags"] = field_flags_str;
+            }
+
+            if (auto default_value = get_field_default(tdb, *pf); !default_value.is_null()) {
+                field_entry["default"] = std::move(default_value);
+            }
+        }
+
+        // Properties
+        for (const auto& pp : desc->parsed_props) {
+            record["properties"][pp->name] = {
+                {"id", pp->index},
+                {"getter", pp->getter != nullptr ? pp->getter->name : ""},
+                {"setter", pp->setter != nullptr ? pp->setter->name : ""},
+            };
+        }
+    }
+}
+
+// Streams il2cpp_dump.json out without ever building the whole document.
+// Records are built and serialized in parallel a block at a time, then written in key order
+// so the output matches what dumping the full DOM used to produce.
+void ObjectExplorer::write_il2cpp_dump(sdk::RETypeDB* tdb, const std::unordered_map<std::string, nlohmann::json>& native_entries, bool compact) {
+    struct Entry {
+        std::string_view name{};
+        std::vector<uint32_t> tdb_indices{};
+        const json* native{nullptr};
+    };
+
+    // The DOM was a std::map, keep the same ordering
+    std::map<std::string_view, Entry> sorted_entries{};
+
+    for (uint32_t i = 0; i < tdb->numTypes; ++i) {
+        if (auto it = g_itypedb.find(i); it != g_itypedb.end() && it->second != nullptr) {
+            auto& entry = sorted_entries[it->second->full_name];
+            entry.name = it->second->full_name;
+            entry.tdb_indices.push_back(i);
+        }
+    }
+
+    for (const auto& [name, native] : native_entries) {
+        auto& entry = sorted_entries[name];
+        entry.name = name;
+        entry.native = &native;
+    }
+
+    std::vector<const Entry*> entries{};
+    entries.reserve(sorted_entries.size());
+
+    for (const auto& [name, entry] : sorted_entries) {
+        entries.push_back(&entry);
+    }
+
+    // get_original_va lazily reads the module from disk, do it before the workers need it
+    if (tdb->numTypes > 0) {
+        get_original_va(tdb->get_type(0));
+    }
+
+    constexpr size_t ENTRIES_PER_BLOCK = 256;
+    const size_t num_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t blocks_per_wave = num_threads * 4;
+    const size_t num_blocks = (entries.size() + ENTRIES_PER_BLOCK - 1) / ENTRIES_PER_BLOCK;
+    const int indent = compact ? -1 : 4;
+    const std::string_view separator = compact ? "," : ",\n";
+
+    const auto serialize_block = [&](size_t block, std::string& out) {
+        const auto start = block * ENTRIES_PER_BLOCK;
+        const auto end = std::min(start + ENTRIES_PER_BLOCK, entries.size());
+
+        for (auto i = start; i < end; ++i) {
+            const auto& entry = *entries[i];
+
+            json record{};
+
+            if (!entry.tdb_indices.empty()) {
+                dump_type_record(record, tdb, entry.tdb_indices);
+            }
+
+            // Native info only fills in what the TDB didn't already provide
+            if (entry.native != nullptr) {
+                for (const auto& [key, value] : entry.native->items()) {
+                    if (record.contains(key) || (key == "deserializer_chain" && record.contains("RSZ"))) {
+                        continue;
+                    }
+
+                    record[key] = value;
+                }
+            }
+
+            // Dumping the record wrapped in an object gets us the key and the right indentation,
+            // then the wrapper's own braces are cut off.
+            json wrapper = json::object();
+            wrapper[std::string{entry.name}] = std::move(record);
+
+            const auto dumped = wrapper.dump(indent, ' ', false, json::error_handler_t::ignore);
+            const size_t brace_size = compact ? 1 : 2;
+
+            if (i != 0) {
+                out += separator;
+            }
+
+            out.append(dumped, brace_size, dumped.size() - brace_size * 2);
+        }
+    };
+
+    std::vector<char> write_buffer(1 << 20);
+    std::ofstream out{};
+    out.rdbuf()->pubsetbuf(write_buffer.data(), write_buffer.size());
+    out.open(REFramework::get_persistent_dir("il2cpp_dump.json"));
+
+    if (!out) {
+        throw std::runtime_error{"Failed to open il2cpp_dump.json for writing"};
+    }
+
+    if (entries.empty()) {
+        out << "{}" << std::endl;
+        return;
+    }
+
+    out << (compact ? "{" : "{\n");
+
+    std::vector<std::string> wave_output(blocks_per_wave);
+
+    // Waves keep only a bounded amount of serialized text in memory at once
+    for (size_t wave_start = 0; wave_start < num_blocks; wave_start += blocks_per_wave) {
+        const auto wave_end = std::min(wave_start + blocks_per_wave, num_blocks);
+
+        std::atomic<size_t> next_block{wave_start};
+        std::mutex error_mutex{};
+        std::string error{};
+
+        std::vector<std::thread> workers{};
+
+        for (size_t i = 0; i < std::min(num_threads, wave_end - wave_start); ++i) {
+            workers.emplace_back([&]() {
+                for (auto block = next_block++; block < wave_end; block = next_block++) try {
+                    auto& block_output = wave_output[block - wave_start];
+
+                    block_output.clear();
+                    serialize_block(block, block_output);
+                } catch (const std::exception& e) {
+                    std::scoped_lock _{error_mutex};
+                    error = e.what();
+                }
+            });
+        }
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        if (!error.empty()) {
+            throw std::runtime_error{error};
+        }
+
+        for (auto block = wave_start; block < wave_end; ++block) {
+            const auto& block_output = wave_output[block - wave_start];
+            out.write(block_output.data(), block_output.size());
+        }
+
+        m_sdk_dump_progress = static_cast<float>(wave_end) / num_blocks;
+    }
+
+    out << (compact ? "}" : "\n}") << std::endl;
+}
+#endif
+
+void ObjectExplorer::generate_sdk() {
+    // enums
+    //auto ref = utility::scan(g_framework->get_module().as<HMODULE>(), "66 C7 40 18 01 01 48 89 05 ? ? ? ?");
+    //auto& l = *(std::map<uint64_t, REEnumData>*)(utility::calculate_absolute(*ref + 9));
+
+    m_dumping_sdk = true;
+    m_sdk_dump_stage = SdkDumpStage::DUMP_INITIALIZATION;
+    uint32_t k = 0;
+    auto n_types = 0ull;
+
+    genny::Sdk sdk{};
+    auto g = sdk.global_ns();
+
+    g->type("int8_t")->size(1);
+    g->type("int16_t")->size(2);
+    g->type("int32_t")->size(4);
+    g->type("int64_t")->size(8);
+    g->type("wchar_t")->size(2);
+    g->type("uint8_t")->size(1);
+    g->type("uint16_t")->size(2);
+    g->type("uint32_t")->size(4);
+    g->type("uint64_t")->size(8);
+    g->type("float")->size(4);
+    g->type("double")->size(8);
+    g->type("bool")->size(1);
+    g->type("char")->size(1);
+    g->type("int")->size(4);
+    g->type("void")->size(0);
+    //g->type("void*")->size(8);
+
+    const auto compact_dump = m_compact_sdk_dump;
+    std::unordered_map<std::string, json> native_entries{}; // things only the native reflection knows about
+
+#ifdef TDB_DUMP_ALLOWED
+    auto tdb = (sdk::RETypeDB*)reframework::get_types()->get_type_db();
+
+    // Types
+    for (uint32_t i = 0; i < tdb->numTypes; ++i) {
+        init_type(tdb, i);
+    }
+
+    for (uint32_t i = 0; i < tdb->numTypes; ++i) {
+        auto desc = init_type(tdb, i);
+
+        desc->full_name = generate_full_name(tdb, i);
+        g_stypedb[desc->full_name] = desc;
+    }
+
+    m_sdk_dump_stage = SdkDumpStage::DUMP_TYPES;
+
+    // Finish off initialization of types
+    for (uint32_t i = 0; i < tdb->numTypes; ++i) {
+        m_sdk_dump_progress = static_cast<float>(i) / tdb->numTypes;
+
+        auto desc = init_type(tdb, i);
+        auto tdef = desc->t;
 
-            il2cpp_dump[pt->full_name]["RSZ"].emplace_back(rsz_entry);
+        if (tdef->declaring_typeid != 0) {
+            desc->owner = init_type(tdb, tdef->declaring_typeid);
         }
 
-        // do this because it empty
-        if (!il2cpp_dump[pt->full_name].contains("RSZ")) {
-            export_deserializer_chain(il2cpp_dump, tdb, type_info, pt->full_name);
+        if (tdef->parent_typeid != 0) {
+            desc->super = init_type(tdb, tdef->parent_typeid);
         }
     }
 
@@ -1081,28 +1423,15 @@ void ObjectExplorer::generate_sdk() {
         const auto method_flags = m.flags;
 #endif
 
+        pm->index = i;
+        pm->impl_flags = (uint16_t)impl_flags;
+        pm->flags = (uint16_t)method_flags;
+        pm->vtable_index = (int32_t)vtable_index;
+
         g_imethoddb[i] = pm;
 
         //spdlog::info("{:s}.{:s}: 0x{:x}", desc->t->type->name, name, (uintptr_t)m.function);
 
-        auto& type_entry = il2cpp_dump[desc->full_name];
-        auto& method_entry = type_entry["methods"][pm->name + std::to_string(i)];
-
-        method_entry["id"] = i;
-        method_entry["function"] = (std::stringstream{} << std::hex << get_original_va(m.get_function())).str();
-
-        if (auto impl_flags_str = get_full_enum_value_name("via.clr.MethodImplFlag", impl_flags); !impl_flags_str.empty()) {
-            method_entry["impl_flags"] = impl_flags_str;
-        }
-
-        if (auto flags_str = get_full_enum_value_name("via.clr.MethodFlag", method_flags); !flags_str.empty()) {
-            method_entry["flags"] = flags_str;
-        }
-
-        if (vtable_index >= 0) {
-            method_entry["vtable_index"] = vtable_index;
-        }
-
         // Parameters
 #if TDB_VER >= 69
         auto param_ids = Address{ tdb->bytePool }.get(param_list).as<sdk::ParamList*>();
@@ -1120,7 +1449,7 @@ void ObjectExplorer::generate_sdk() {
 #endif
 
         // Invoke wrapper for arbitrary amount of arguments, so we can just pass it on the VM stack/context as an array
-        method_entry["invoke_id"] = invoke_id;
+        pm->invoke_id = invoke_id;
 
         auto parse_param = [&](uint32_t param_index, bool is_return = false) {
 #if TDB_VER >= 69
@@ -1140,11 +1469,15 @@ void ObjectExplorer::generate_sdk() {
             const auto flags = p.flags;
 #endif
 
-            if (auto it = g_itypedb.find(param_type_id); it == g_itypedb.end()) {
-                return json{};
-            }
+            auto it = g_itypedb.find(param_type_id);
 
-            auto& param_type = g_itypedb[param_type_id];
+            if (it == g_itypedb.end()) {
+                if (!is_return) {
+                    pm->params.emplace_back(nullptr);
+                }
+
+                return;
+            }
 
             auto pdesc = std::make_shared<detail::ParsedParams>();
             g_iparamdb[param_index] = pdesc;
@@ -1152,8 +1485,12 @@ void ObjectExplorer::generate_sdk() {
             auto param_name = Address{tdb->stringPool}.get(name_index).as<const char*>();
 
             pdesc->owner = pm;
-            pdesc->type = param_type;
+            pdesc->type = it->second;
             pdesc->name = param_name;
+            pdesc->flags = (uint16_t)flags;
+#if TDB_VER >= 69
+            pdesc->modifier = modifier;
+#endif
 
             if (is_return) {
                 pm->return_val = pdesc;
@@ -1161,23 +1498,6 @@ void ObjectExplorer::generate_sdk() {
             else {
                 pm->params.emplace_back(pdesc);
             }
-
-            auto param_entry = json{
-                {"type", pdesc->type->full_name},
-                {"name", pdesc->name},
-            };
-
-            if (auto param_flags = get_full_enum_value_name("via.clr.ParamFlag", flags); !param_flags.empty()) {
-                param_entry["flags"] = param_flags;
-            }
-
-#if TDB_VER >= 69
-            if (auto param_modifier = get_full_enum_value_name("via.clr.ParamModifier", modifier); !param_modifier.empty()) {
-                param_entry["modifier"] = param_modifier;
-            }
-#endif
-
-            return param_entry;
         };
 
         const auto return_type = m.get_return_type();
@@ -1185,12 +1505,7 @@ void ObjectExplorer::generate_sdk() {
 
         // Parse return type
 #if TDB_VER >= 69
-        method_entry["returns"] = parse_param(param_ids->returnType, true);
-#else
-        method_entry["returns"] = json{
-            {"type", return_type_name},
-            {"name", ""},
-        };
+        parse_param(param_ids->returnType, true);
 #endif
 
         // Parse all params
@@ -1204,9 +1519,7 @@ void ObjectExplorer::generate_sdk() {
             const auto param_index = f;
 #endif
 
-            auto param_entry = parse_param(param_index);
-
-            method_entry["params"].emplace_back(param_entry);
+            parse_param(param_index);
         }
 
         // Generate sdkgenny methods
@@ -1427,10 +1740,16 @@ void ObjectExplorer::generate_sdk() {
 
         pf->f = &f;
         pf->name = name;
+        pf->index = i;
         pf->owner = desc;
         pf->offset_from_fieldptr = offset;
         pf->offset_from_base = pf->offset_from_fieldptr;
         pf->type = g_itypedb[field_type];
+        pf->flags = (uint16_t)field_flags;
+        pf->init_data_offset = (int32_t)init_data_offset;
+#if TDB_VER >= 66
+        pf->init_data_index = (uint32_t)init_data_index;
+#endif
 
 #if TDB_VER >= 69
         pf->f_impl = &impl;
@@ -1545,114 +1864,8 @@ void ObjectExplorer::generate_sdk() {
             }
         }
         
-        const auto field_type_name = (pf->type != nullptr) ? pf->type->full_name : "";
-
-        //spdlog::info("{:s} {:s}.{:s}: 0x{:x}", field_type_name, desc->t->type->name, name, pf->offset_from_base);
-
-        auto& type_entry = il2cpp_dump[desc->full_name];
-        auto& field_entry = type_entry["fields"][pf->name];
-
-        field_entry = {
-            {"id", i},
-            {"type", field_type_name},
-            {"offset_from_base", (std::stringstream{} << "0x" << std::hex << pf->offset_from_base).str()},
-            {"offset_from_fieldptr", (std::stringstream{} << "0x" << std::hex << pf->offset_from_fieldptr).str()},
-#if TDB_VER >= 66
-            {"init_data_index", init_data_index}
-#endif
-        };
-
-        if (auto field_flags_str = get_full_enum_value_name("via.clr.FieldFlag", field_flags); !field_flags_str.empty()) {
-            field_entry["flags"] = field_flags_str;
-        }
-
-        if (init_data_offset != 0) {
-            auto init_data = &(*tdb->bytePool)[init_data_offset];
-
-            // WACKY
-            if (init_data_offset < 0) {
-                init_data = &((uint8_t*)tdb->stringPool)[init_data_offset * -1];
-            }
-
-            auto init_data_type = pf->type;
-            auto full_name{ init_data_type->full_name };
-
-            // edge case
-            if (pf->type->super != nullptr && pf->type->super->full_name == "System.Enum") {
-                switch (pf->type->t->get_size() - pf->type->super->t->get_size()) {
-                case 1:
-                    full_name = "System.Byte";
-                    break;
-                case 2:
-                    full_name = "System.UInt16";
-                    break;
-                case 4:
-                    full_name = "System.UInt32";
-                    break;
-                case 8:
-                    full_name = "System.UInt64";
-                    break;
-                }
-            }
-
-            switch (utility::hash(full_name)) {
-            case "System.Boolean"_fnv:
-                field_entry["default"] = *(bool*)init_data;
-                cs->integer(*(bool*)init_data);
-                break;
-            case "System.Char"_fnv:
-                field_entry["default"] = *(wchar_t*)init_data;
-                cs->integer(*(wchar_t*)init_data);
-                break;
-            case "System.Byte"_fnv:
-                field_entry["default"] = *(uint8_t*)init_data;
-                cs->integer(*(uint8_t*)init_data);
-                break;
-            case "System.SByte"_fnv:
-                field_entry["default"] = *(int8_t*)init_data;
-                cs->integer(*(int8_t*)init_data);
-                break;
-            case "System.UInt16"_fnv:
-                field_entry["default"] = *(uint16_t*)init_data;
-                cs->integer(*(uint16_t*)init_data);
-                break;
-            case "System.Int16"_fnv:
-                field_entry["default"] = *(int16_t*)init_data;
-                cs->integer(*(int16_t*)init_data);
-                break;
-            case "System.UInt32"_fnv:
-                field_entry["default"] = *(uint32_t*)init_data;
-                cs->integer(*(uint32_t*)init_data);
-                break;
-            case "System.Int32"_fnv:
-                field_entry["default"] = *(int32_t*)init_data;
-                cs->integer(*(int32_t*)init_data);
-                break;
-            case "System.UInt64"_fnv:
-                field_entry["default"] = *(uint64_t*)init_data;
-                cs->integer(*(uint64_t*)init_data);
-                break;
-            case "System.Int64"_fnv:
-                field_entry["default"] = *(int64_t*)init_data;
-                cs->integer(*(int64_t*)init_data);
-                break;
-            case "System.Single"_fnv:
-                field_entry["default"] = *(float*)init_data;
-                cs->real(*(float*)init_data);
-                break;
-            case "System.Double"_fnv:
-                field_entry["default"] = *(double*)init_data;
-                cs->real(*(double*)init_data);
-                break;
-            case "System.String"_fnv:
-                field_entry["default"] = (char*)init_data;
-                cs->string((char*)init_data);
-                break;
-            default:
-                field_entry["default"] = "REFRAMEWORK_UNIMPLEMENTED_INIT_TYPE";
-                break;
-            }
-        }
+        // Literal constants get their value from the init data
+        get_field_default(tdb, *pf, cs);
     }
     
     spdlog::info("PROPERTIES BEGIN");
@@ -1700,6 +1913,7 @@ void ObjectExplorer::generate_sdk() {
         auto& pp = desc->parsed_props.emplace_back(std::make_shared<detail::ParsedProperty>());
 
         pp->name = name;
+        pp->index = i;
         pp->owner = desc;
         pp->p = &p;
         pp->getter = getter;
@@ -1708,95 +1922,9 @@ void ObjectExplorer::generate_sdk() {
 #if TDB_VER >= 69
         pp->p_impl = &impl;
 #endif
-
-        auto getter_name = pp->getter != nullptr ? pp->getter->name : "";
-        auto setter_name = pp->setter != nullptr ? pp->setter->name : "";
-
-        //spdlog::info("{:s}.{:s}", desc->name, name);
-
-        auto& type_entry = il2cpp_dump[desc->full_name];
-
-        type_entry["properties"][pp->name] = {
-            {"id", i},
-            {"getter", getter_name},
-            {"setter", setter_name},
-        };
-
-        //spdlog::info("{:s} {:s}.{:s}: 0x{:x}", field_type_name, desc->t->type->name, name, pf->offset_from_base);
-    }
-
-
-    // Try and guess what the field names are for the RSZ entries
-    // In RE7, the deserializer points to the reflection property,
-    // so we can just grab the name from there instead of comparing field offsets.
-    
-#if TDB_VER > 49
-    m_sdk_dump_stage = SdkDumpStage::DUMP_RSZ_2;
-    k = 0;
-    n_types = m_sorted_types.size();
-    for (auto& t : g_itypedb) {
-        m_sdk_dump_progress = static_cast<float>(k++) / n_types;
-
-        auto tdef = t.second->t;
-
-        if (tdef == nullptr || tdef->get_index() == 0) {
-            continue;
-        }
-
-        auto& t_json = il2cpp_dump[t.second->full_name];
-
-        if (!t_json.contains("RSZ")) {
-            continue;
-        }
-
-        int32_t i = 0;
-
-        for (auto& rsz_entry : t_json["RSZ"]) {
-            const auto is_rsz_static = rsz_entry["static"].get<bool>();
-            const auto rsz_offset = std::stoul(std::string{ rsz_entry["offset_from_fieldptr"] }, nullptr, 16);
-            auto fieldptr_adjustment = 0;
-
-            auto depth_t = t.second;
-            const auto depth = rsz_entry["depth"].get<int32_t>();
-
-            // Get the topmost one because of depth
-            for (auto d = 0; d < depth; ++d) {
-                if (!depth_t->t->has_fieldptr_offset() || depth_t->super == nullptr) {
-                    break;
-                }
-
-                const auto field_ptr = depth_t->t->get_fieldptr_offset();
-
-                depth_t = depth_t->super;
-
-                if (!depth_t->t->has_fieldptr_offset()) {
-                    break;
-                }
-
-                const auto field_ptr2 = depth_t->t->get_fieldptr_offset();
-
-                fieldptr_adjustment += field_ptr - field_ptr2;
-            }
-
-            for (auto& f : depth_t->parsed_fields) {
-                const auto is_field_static = f->f->is_static();
-
-                if (is_field_static != is_rsz_static) {
-                    continue;
-                }
-
-                //const auto field_offset = is_field_static ? f->offset_from_fieldptr : (f->offset_from_fieldptr + fieldptr_adjustment);
-                const auto field_offset = f->offset_from_fieldptr + fieldptr_adjustment;
-
-                if (field_offset == rsz_offset) {
-                    rsz_entry["potential_name"] = f->name;
-                    break;
-                }
-            }
-        }
     }
 #endif
-#endif
+
     m_sdk_dump_stage = SdkDumpStage::DUMP_DESERIALIZER_CHAIN;
     k = 0;
     n_types = m_sorted_types.size();
@@ -1811,17 +1939,21 @@ void ObjectExplorer::generate_sdk() {
         }
 
 #ifdef TDB_DUMP_ALLOWED
-        export_deserializer_chain(il2cpp_dump, tdb, t);
+        if (auto chain = get_deserializer_chain(tdb, t); !chain.is_null()) {
+            auto tdef = utility::re_type::get_type_definition(t);
+            const auto full_name = t->classInfo != nullptr ? generate_full_name(tdb, tdef->get_index()) : std::string{t->name};
+            auto& chain_entry = native_entries[full_name];
 
-        auto& entry = il2cpp_dump[t->name];
-
-        if (!entry.contains("fqn")) {
-            entry["fqn"] = (std::stringstream{} << std::hex << t->classIndex).str();
-        }
-        
-        if (!entry.contains("crc")) {
-            entry["crc"] = (std::stringstream{} << std::hex << t->typeCRC).str();
+            if (!chain_entry.contains("deserializer_chain")) {
+                chain_entry["deserializer_chain"] = std::move(chain);
+            }
         }
+
+        // Only used if the TDB doesn't know about the type
+        auto& entry = native_entries[t->name];
+
+        entry["fqn"] = (std::stringstream{} << std::hex << t->classIndex).str();
+        entry["crc"] = (std::stringstream{} << std::hex << t->typeCRC).str();
 #endif
 
         if (t->fields == nullptr) {
@@ -1967,7 +2099,8 @@ void ObjectExplorer::generate_sdk() {
 
                 for (auto f = 0; f < descriptor->numParams; ++f) {
                     auto& param_d = (*descriptor->params)[f];
-                    auto param_t = g_itypedb[(*descriptor->params)[f].typeIndex];
+                    auto param_it = g_itypedb.find(param_d.typeIndex);
+                    auto param_t = param_it != g_itypedb.end() ? param_it->second : nullptr;
                     auto param_typename = (param_t != nullptr && param_d.typeIndex) != 0 ? param_t->full_name : param_d.typeName;
 
                     json_params.push_back({
@@ -1977,10 +2110,11 @@ void ObjectExplorer::generate_sdk() {
                     });
                 }
 
-                auto return_t = g_itypedb[descriptor->typeIndex];
+                auto return_it = g_itypedb.find(descriptor->typeIndex);
+                auto return_t = return_it != g_itypedb.end() ? return_it->second : nullptr;
                 auto return_name = (return_t != nullptr && descriptor->typeIndex != 0) ? return_t->full_name : descriptor->returnTypeName;
 
-                il2cpp_dump[t->name]["reflection_methods"][descriptor->name] = {
+                native_entries[t->name]["reflection_methods"][descriptor->name] = {
                     {"function", (std::stringstream{} << "0x" << std::hex << get_original_va(descriptor->functionPtr)).str()},
                     {"returns", return_name},
                     {"params", json_params},
@@ -2038,7 +2172,7 @@ void ObjectExplorer::generate_sdk() {
                 auto field_t = g_fqntypedb[variable->typeFqn];
                 auto field_t_name = (field_t != nullptr && variable->typeFqn != 0) ? field_t->full_name : variable->typeName;
 
-                auto& prop_entry = il2cpp_dump[t->name]["reflection_properties"][variable->name];
+                auto& prop_entry = native_entries[t->name]["reflection_properties"][variable->name];
 
                 prop_entry = {
                     {"getter", (std::stringstream{} << "0x" << std::hex << get_original_va(variable->function)).str()},
@@ -2077,11 +2211,16 @@ void ObjectExplorer::generate_sdk() {
         e->value(it.second.name, it.second.value);
     }*/
 
+#ifdef TDB_DUMP_ALLOWED
+    m_sdk_dump_stage = SdkDumpStage::WRITE_JSON;
+    m_sdk_dump_progress = 0.0f;
+
     try {
-        std::ofstream{ REFramework::get_persistent_dir("il2cpp_dump.json") } << il2cpp_dump.dump(4, ' ', false, json::error_handler_t::ignore) << std::endl;
+        write_il2cpp_dump(tdb, native_entries, compact_dump);
     } catch(std::exception& e) {
         spdlog::info("Failed to dump il2cpp_dump.json: {}", e.what());
     }
+#endif
 
     /*spdlog::info("Generating SDK...");
 
@@ -3865,22 +4004,6 @@ void ObjectExplorer::hook_method(sdk::REMethodDefinition* method, std::optional<
 
     auto& hooked = m_hooked_methods.emplace_back();
 
-    using namespace asmjit;
-    using namespace asmjit::x86;
-
-    CodeHolder code{};
-    code.init(m_jit_runtime.environment());
-
-    Assembler a{&code};
-
-    a.mov(r9, method);
-    a.movabs(r10, &ObjectExplorer::pre_hooked_method);
-    a.jmp(r10);
-
-    m_jit_runtime.add(&hooked.jitted_function, &code);
-
-    using MT = HookManager::PreHookResult(*)(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr);
-
     hooked.method = method;
 
     if (name) {
@@ -3889,7 +4012,7 @@ void ObjectExplorer::hook_method(sdk::REMethodDefinition* method, std::optional<
         hooked.name = method->get_declaring_type()->get_full_name() + "." + method->get_name();
     }
     
-    hooked.hook_id = g_hookman.add(method, (MT)hooked.jitted_function, nullptr);
+    hooked.hook_id = g_hookman.add_raw(method, &ObjectExplorer::pre_hooked_method, nullptr, method);
 }
 
 void ObjectExplorer::hook_all_methods(sdk::RETypeDefinition* t) {
@@ -3899,6 +4022,9 @@ void ObjectExplorer::hook_all_methods(sdk::RETypeDefinition* t) {
 
     const auto methods = t->get_methods();
 
+    // Every hook goes live together when this goes out of scope, with one thread freeze.
+    FunctionHook::Batch batch{};
+
     for (auto& m : methods) {
         const auto method_ptr = m.get_function();
         if (method_ptr == nullptr) {
@@ -4032,12 +4158,12 @@ void ObjectExplorer::populate_classes() {
                 continue;
             }
 
-            spdlog::info("{:s}", name);
             m_sorted_types.push_back(name);
             m_types[name] = t;
         }
 
         std::sort(m_sorted_types.begin(), m_sorted_types.end());
+        spdlog::info("Populated {} types", m_sorted_types.size());
         return;
     } catch(...) {
         spdlog::error("Unknown exception caught while populating classes, falling back to other method.");
@@ -4071,7 +4197,6 @@ void ObjectExplorer::populate_classes() {
                 continue;
             }
 
-            spdlog::info("{:s}", name);
             m_sorted_types.push_back(name);
             m_types[name] = re_type;
 
@@ -4080,6 +4205,7 @@ void ObjectExplorer::populate_classes() {
     }
     
     std::sort(m_sorted_types.begin(), m_sorted_types.end());
+    spdlog::info("Populated {} types", m_sorted_types.size());
 }
 
 void ObjectExplorer::populate_enums() {
@@ -4222,6 +4348,9 @@ void ObjectExplorer::init() {
     populate_classes();
     populate_enums();
 
+    // m_sorted_types and m_types aren't modified after this point, so the thread can read them directly
+    m_search_indices_future = std::async(std::launch::async, &ObjectExplorer::build_search_indices, std::cref(m_sorted_types), std::cref(m_types));
+
     if (m_function_occurrences.empty()) {
         const auto tdb = sdk::RETypeDB::get();
 
@@ -4271,7 +4400,7 @@ std::string ObjectExplorer::get_full_enum_value_name(std::string_view enum_name,
 }
 
 std::string ObjectExplorer::get_enum_value_name(std::string_view enum_name, int64_t value) {
-    std::lock_guard l{m_enum_mutex};
+    std::shared_lock l{m_enum_mutex};
 
     if (!m_enums.contains(enum_name.data())) {
         spdlog::info("Unknown enum: {}", enum_name);
@@ -4316,137 +4445,239 @@ uintptr_t ObjectExplorer::get_original_va(void* ptr) {
     return *utility::get_imagebase_va_from_ptr(m_module_chunk.data(), g_framework->get_module(), ptr);
 }
 
-bool ObjectExplorer::is_filtered_type(std::string name) {
-    auto it = m_types.find(name);
+bool ObjectExplorer::is_filtered_method(sdk::REMethodDefinition& m) try {
+    const auto name = std::string_view{m_type_member.data()};
+    if (name.empty()) {
+        return true;
+    }
+
+    const auto regex = m_search_using_regex ? get_cached_regex(m_method_regex, name) : nullptr;
 
-    if (it == m_types.end() || it->second == nullptr) {
+    if (m_search_using_regex && regex == nullptr) {
         return false;
     }
 
-    auto t = it->second;
-    auto tdef = utility::re_type::get_type_definition(t);
-    if (tdef == nullptr) {
-        return false;
+    const auto matches = [&](std::string_view a) {
+        return regex != nullptr ? std::regex_search(a.begin(), a.end(), *regex) : a.find(name) != std::string_view::npos;
+    };
+
+    if (matches(m.get_name())) {
+        return true;
     }
 
-    if (!std::string_view{m_type_member.data()}.empty()) {
-        for (auto& m : tdef->get_methods()) {
-            if (is_filtered_method(m)) {
-                return true;
-            }
-        }
+    const auto method_return_type = m.get_return_type();
+
+    if (method_return_type != nullptr && matches(method_return_type->get_full_name())) {
+        return true;
     }
 
-    if (!std::string_view{m_type_field.data()}.empty()) {
-        for (auto f : tdef->get_fields()) {
-            if (f != nullptr && is_filtered_field(*f)) {
-                return true;
-            }
-        }
+    const auto method_param_names = m.get_param_names();
+    if (std::any_of(method_param_names.begin(), method_param_names.end(), matches)) {
+        return true;
+    }
+
+    const auto method_param_types = m.get_param_types();
+    if (std::any_of(method_param_types.begin(), method_param_types.end(), [&](sdk::RETypeDefinition* a) { return a != nullptr && matches(a->get_name()); })) {
+        return true;
     }
 
+    return false;
+} catch (...) {
     return false;
 }
 
-bool ObjectExplorer::is_filtered_method(sdk::REMethodDefinition& m) try {
-    const auto method_name = m.get_name();
-    const auto name = std::string_view{m_type_member.data()};
+bool ObjectExplorer::is_filtered_field(sdk::REField& f) try {
+    const auto name = std::string_view{m_type_field.data()};
     if (name.empty()) {
         return true;
     }
 
-    if (!m_search_using_regex) {
-        if (std::string_view{method_name}.find(name) != std::string_view::npos) {
-            return true;
-        }
-    } else {
-        if (std::regex_search(method_name, std::regex{name.data()})) {
-            return true;
+    const auto regex = m_search_using_regex ? get_cached_regex(m_field_regex, name) : nullptr;
+
+    if (m_search_using_regex && regex == nullptr) {
+        return false;
+    }
+
+    const auto matches = [&](std::string_view a) {
+        return regex != nullptr ? std::regex_search(a.begin(), a.end(), *regex) : a.find(name) != std::string_view::npos;
+    };
+
+    if (matches(f.get_name())) {
+        return true;
+    }
+
+    const auto field_type = f.get_type();
+
+    return field_type != nullptr && matches(field_type->get_full_name());
+} catch (...) {
+    return false;
+}
+
+const std::regex* ObjectExplorer::get_cached_regex(CachedRegex& cache, std::string_view pattern) {
+    if (cache.pattern != pattern) {
+        cache.pattern = pattern;
+        cache.regex.reset();
+
+        try {
+            cache.regex.emplace(cache.pattern);
+        } catch (const std::regex_error&) {
         }
     }
 
-    const auto method_return_type = m.get_return_type();
-    const std::string method_return_type_name = method_return_type != nullptr ? method_return_type->get_full_name() : "";
+    return cache.regex ? &*cache.regex : nullptr;
+}
+
+std::unique_ptr<ObjectExplorer::SearchIndices> ObjectExplorer::build_search_indices(const std::vector<std::string>& sorted_types, const std::unordered_map<std::string, REType*>& types) try {
+    auto out = std::make_unique<SearchIndices>();
+    out->sorted_types.reserve(sorted_types.size());
+
+    for (uint32_t i = 0; i < sorted_types.size(); ++i) {
+        const auto& name = sorted_types[i];
+        const auto it = types.find(name);
+        const auto t = it != types.end() ? it->second : nullptr;
 
-    if (!m_search_using_regex) {
-        if (method_return_type_name.find(name) != std::string::npos) {
-            return true;
+        out->sorted_types.push_back(t);
+        out->types.add(name, i);
+
+        const auto tdef = t != nullptr ? utility::re_type::get_type_definition(t) : nullptr;
+
+        if (tdef == nullptr) {
+            continue;
         }
-    } else {
-        if (std::regex_search(method_return_type_name, std::regex{name.data()})) {
-            return true;
+
+        // Same strings is_filtered_method and is_filtered_field look at
+        for (auto& m : tdef->get_methods()) try {
+            out->methods.add(m.get_name(), i);
+
+            if (const auto return_type = m.get_return_type(); return_type != nullptr) {
+                out->methods.add(return_type->get_full_name_view(), i);
+            }
+
+            for (const auto param_name : m.get_param_names()) {
+                if (param_name != nullptr) {
+                    out->methods.add(param_name, i);
+                }
+            }
+
+            for (const auto param_type : m.get_param_types()) {
+                if (param_type != nullptr) {
+                    out->methods.add(param_type->get_name(), i);
+                }
+            }
+        } catch (...) {
+        }
+
+        for (auto f : tdef->get_fields()) try {
+            if (f == nullptr) {
+                continue;
+            }
+
+            out->fields.add(f->get_name(), i);
+
+            if (const auto field_type = f->get_type(); field_type != nullptr) {
+                out->fields.add(field_type->get_full_name_view(), i);
+            }
+        } catch (...) {
         }
     }
 
-    std::function<bool(std::string_view a)> search_algo_params{};
+    out->types.finalize();
+    out->methods.finalize();
+    out->fields.finalize();
 
-    if (!m_search_using_regex) {
-        search_algo_params = [name](std::string_view a) { return a.find(name) != std::string_view::npos; };
-    } else {
-        search_algo_params = [name](std::string_view a) { return std::regex_search(a.data(), std::regex{name.data()}); };
+    spdlog::info("Built ObjectExplorer search indices ({} type names, {} method strings, {} field strings)", out->types.size(), out->methods.size(), out->fields.size());
+
+    return out;
+} catch (...) {
+    spdlog::error("Unknown exception caught while building the ObjectExplorer search indices");
+    return nullptr;
+}
+
+void ObjectExplorer::start_search(SearchKind kind, std::string_view needle) {
+    m_search = Search{};
+    m_search->kind = kind;
+    m_search->needle = needle;
+
+    if (m_search_using_regex) {
+        try {
+            m_search->regex.emplace(m_search->needle);
+        } catch (const std::regex_error&) {
+            m_search.reset(); // Nothing matches an invalid pattern
+        }
     }
+}
 
-    const auto method_param_names = m.get_param_names();
-    if (auto i = std::find_if(method_param_names.begin(), method_param_names.end(), search_algo_params);
-        i != method_param_names.end()) {
-        return true;
+void ObjectExplorer::update_search() {
+    if (!m_search) {
+        return;
     }
 
-    std::function<bool(sdk::RETypeDefinition* a)> search_algo_types{};
+    if (m_search_indices == nullptr) {
+        if (m_search_indices_future.valid() && m_search_indices_future.wait_for(std::chrono::seconds{0}) == std::future_status::ready) {
+            m_search_indices = m_search_indices_future.get();
+        }
 
-    if (!m_search_using_regex) {
-        search_algo_types = [name](sdk::RETypeDefinition* a) { return std::string_view{a->get_name()}.find(name) != std::string_view::npos; };
-    } else {
-        search_algo_types = [name](sdk::RETypeDefinition* a) { return std::regex_search(a->get_name(), std::regex{name.data()}); };
+        if (m_search_indices == nullptr) {
+            ImGui::TextUnformatted(m_search_indices_future.valid() ? "Building search index..." : "Search index unavailable");
+            return;
+        }
     }
 
-    const auto method_param_types = m.get_param_types();
-    if (auto i = std::find_if(method_param_types.begin(), method_param_types.end(), search_algo_types);
-        i != method_param_types.end()) {
-        return true;
+    auto& search = *m_search;
+    const auto& index = search.kind == SearchKind::TYPE   ? m_search_indices->types
+                      : search.kind == SearchKind::METHOD ? m_search_indices->methods
+                                                          : m_search_indices->fields;
+
+    if (!search.started) {
+        search.candidates = search.regex ? index.regex_candidates(search.needle) : index.candidates(search.needle);
+        search.matched_types.assign(m_search_indices->sorted_types.size(), false);
+        search.started = true;
     }
 
-    return false;
-} catch (...) {
-    return false;
-}
+    // Only verify as many candidates as fit in a couple milliseconds, the rest is picked up on the next frames
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{2};
+    bool any_new = false;
 
-bool ObjectExplorer::is_filtered_field(sdk::REField& f) try {
-    const auto field_name = f.get_name();
-    const auto name = std::string_view{m_type_field.data()};
-    if (name.empty()) {
-        return true;
-    }
+    for (; search.next_candidate < search.candidates.size(); ++search.next_candidate) {
+        if ((search.next_candidate & 0xFF) == 0 && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+
+        const auto id = search.candidates[search.next_candidate];
+        const auto str = index.get(id);
+        const auto matches = search.regex ? std::regex_search(str.begin(), str.end(), *search.regex) : str.find(search.needle) != std::string_view::npos;
 
-    if (!m_search_using_regex) {
-        if (std::string_view{field_name}.find(name) != std::string_view::npos) {
-            return true;
+        if (!matches) {
+            continue;
         }
-    } else {
-        if (std::regex_search(field_name, std::regex{name.data()})) {
-            return true;
+
+        for (const auto owner : index.get_owners(id)) {
+            if (!search.matched_types[owner]) {
+                search.matched_types[owner] = true;
+                any_new = true;
+            }
         }
     }
 
-    const auto field_type = f.get_type();
-    const std::string field_type_name = field_type != nullptr ? field_type->get_full_name() : "";
+    if (any_new) {
+        // Keep the results in the same order as m_sorted_types
+        m_displayed_types.clear();
 
-    if (!m_search_using_regex) {
-        if (field_type_name.find(name) != std::string::npos) {
-            return true;
-        }
-    } else {
-        if (std::regex_search(field_type_name, std::regex{name.data()})) {
-            return true;
+        for (size_t i = 0; i < search.matched_types.size(); ++i) {
+            if (search.matched_types[i] && m_search_indices->sorted_types[i] != nullptr) {
+                m_displayed_types.push_back(m_search_indices->sorted_types[i]);
+            }
         }
     }
 
-    return false;
-} catch (...) {
-    return false;
+    if (search.next_candidate < search.candidates.size()) {
+        ImGui::Text("Searching... %zu/%zu", search.next_candidate, search.candidates.size());
+    } else {
+        m_search.reset();
+    }
 }
 
-HookManager::PreHookResult ObjectExplorer::pre_hooked_method_internal(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr, sdk::REMethodDefinition* method) {
+HookManager::PreHookResult ObjectExplorer::pre_hooked_method_internal(std::span<uintptr_t> args, std::span<sdk::RETypeDefinition*> arg_tys, uintptr_t ret_addr, sdk::REMethodDefinition* method) {
     auto it = std::find_if(m_hooked_methods.begin(), m_hooked_methods.end(), [method](auto& a) { return a.method == method; });
 
     if (it == m_hooked_methods.end()) {
@@ -4529,6 +4760,6 @@ HookManager::PreHookResult ObjectExplorer::pre_hooked_method_internal(std::vecto
     return result;
 }
 
-HookManager::PreHookResult ObjectExplorer::pre_hooked_method(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr, sdk::REMethodDefinition* method) {
-    return ObjectExplorer::get()->pre_hooked_method_internal(args, arg_tys, ret_addr, method);
+HookManager::PreHookResult ObjectExplorer::pre_hooked_method(void* userdata, std::span<uintptr_t> args, std::span<sdk::RETypeDefinition*> arg_tys, uintptr_t ret_addr) {
+    return ObjectExplorer::get()->pre_hooked_method_internal(args, arg_tys, ret_addr, (sdk::REMethodDefinition*)userdata);
 }
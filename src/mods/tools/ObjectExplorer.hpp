@@ -6,14 +6,17 @@
 #include <unordered_map>
 #include <memory>
 #include <string>
+#include <shared_mutex>
+#include <future>
+#include <optional>
+#include <regex>
 #include <imgui.h>
 #include <json.hpp>
-#include <asmjit/asmjit.h>
-#include <asmjit/x86/x86assembler.h>
 
 #include "utility/Address.hpp"
 #include "Tool.hpp"
 #include "HookManager.hpp"
+#include "TrigramIndex.hpp"
 
 #include <sdk/TDBVer.hpp>
 
@@ -35,6 +38,7 @@ class TreeNode;
 
 namespace genny {
 class Class;
+class Constant;
 }
 
 #ifdef TDB_DUMP_ALLOWED
@@ -50,6 +54,9 @@ struct ParsedParams {
     std::shared_ptr<ParsedType> type{};
     const char* name;
 
+    uint16_t flags{};
+    uint8_t modifier{};
+
     bool by_ref : 1;
     bool by_ptr : 1;
 };
@@ -62,7 +69,13 @@ struct ParsedMethod {
 #endif
     const char* name{};
 
-    std::vector<std::shared_ptr<ParsedParams>> params{};
+    uint32_t index{};
+    uint32_t invoke_id{};
+    uint16_t impl_flags{};
+    uint16_t flags{};
+    int32_t vtable_index{-1};
+
+    std::vector<std::shared_ptr<ParsedParams>> params{}; // nullptr for params whose type couldn't be resolved
     std::shared_ptr<ParsedParams> return_val{};
 };
 
@@ -74,8 +87,12 @@ struct ParsedField {
     sdk::REFieldImpl* f_impl{};
 #endif
     const char* name{};
+    uint32_t index{};
     uint32_t offset_from_fieldptr{};
     uint32_t offset_from_base{};
+    uint16_t flags{};
+    uint32_t init_data_index{};
+    int32_t init_data_offset{};
 };
 
 struct ParsedProperty {
@@ -89,6 +106,7 @@ struct ParsedProperty {
     sdk::REPropertyImpl* p_impl{};
 #endif
     const char* name{};
+    uint32_t index{};
 };
 
 struct ParsedType {
@@ -139,10 +157,14 @@ private:
     void display_hooks();
 
 #ifdef TDB_DUMP_ALLOWED
-    std::shared_ptr<detail::ParsedType> init_type_min(nlohmann::json& il2cpp_dump, sdk::RETypeDB* tdb, uint32_t i);
-    std::shared_ptr<detail::ParsedType> init_type(nlohmann::json& il2cpp_dump, sdk::RETypeDB* tdb, uint32_t i);
+    std::shared_ptr<detail::ParsedType> init_type_min(sdk::RETypeDB* tdb, uint32_t i);
+    std::shared_ptr<detail::ParsedType> init_type(sdk::RETypeDB* tdb, uint32_t i);
     std::string generate_full_name(sdk::RETypeDB* tdb, uint32_t i);
-    void export_deserializer_chain(nlohmann::json& il2cpp_dump, sdk::RETypeDB* tdb, REType* t, std::optional<std::string> real_name = std::nullopt);
+    nlohmann::json get_deserializer_chain(sdk::RETypeDB* tdb, REType* t);
+    nlohmann::json get_field_default(sdk::RETypeDB* tdb, const detail::ParsedField& pf, genny::Constant* cs = nullptr);
+    nlohmann::json dump_param(const detail::ParsedParams& p);
+    void dump_type_record(nlohmann::json& record, sdk::RETypeDB* tdb, const std::vector<uint32_t>& indices);
+    void write_il2cpp_dump(sdk::RETypeDB* tdb, const std::unordered_map<std::string, nlohmann::json>& native_entries, bool compact);
 #endif
     void generate_sdk();
     void report_sdk_dump_progress(float progress);
@@ -187,10 +209,46 @@ private:
 
     uintptr_t get_original_va(void* ptr);
 
-    bool is_filtered_type(std::string name);
     bool is_filtered_method(sdk::REMethodDefinition& m);
     bool is_filtered_field(sdk::REField& f);
 
+    // Indices over the names the "Type Name", "Method Signature" and "Field Signature" boxes search,
+    // owners are indices into m_sorted_types.
+    struct SearchIndices {
+        TrigramIndex types{};
+        TrigramIndex methods{};
+        TrigramIndex fields{};
+        std::vector<REType*> sorted_types{}; // m_sorted_types resolved to their REType
+    };
+
+    enum class SearchKind {
+        TYPE,
+        METHOD,
+        FIELD
+    };
+
+    struct Search {
+        SearchKind kind{};
+        std::string needle{};
+        std::optional<std::regex> regex{};
+        bool started{false};
+        std::vector<uint32_t> candidates{};
+        size_t next_candidate{0};
+        std::vector<bool> matched_types{};
+    };
+
+    struct CachedRegex {
+        std::string pattern{};
+        std::optional<std::regex> regex{};
+    };
+
+    static std::unique_ptr<SearchIndices> build_search_indices(const std::vector<std::string>& sorted_types, const std::unordered_map<std::string, REType*>& types);
+    void start_search(SearchKind kind, std::string_view needle);
+    void update_search();
+
+    // nullptr if the pattern doesn't compile
+    static const std::regex* get_cached_regex(CachedRegex& cache, std::string_view pattern);
+
     template <typename T, typename... Args>
     bool stretched_tree_node(T id, Args... args) {
         auto& style = ImGui::GetStyle();
@@ -217,8 +275,8 @@ private:
         return path;
     }
 
-    HookManager::PreHookResult pre_hooked_method_internal(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr, sdk::REMethodDefinition* method);
-    static HookManager::PreHookResult pre_hooked_method(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr, sdk::REMethodDefinition* method);
+    HookManager::PreHookResult pre_hooked_method_internal(std::span<uintptr_t> args, std::span<sdk::RETypeDefinition*> arg_tys, uintptr_t ret_addr, sdk::REMethodDefinition* method);
+    static HookManager::PreHookResult pre_hooked_method(void* userdata, std::span<uintptr_t> args, std::span<sdk::RETypeDefinition*> arg_tys, uintptr_t ret_addr);
 
     struct PinnedObject {
         Address address{};
@@ -233,7 +291,6 @@ private:
     struct HookedMethod {
         std::string name{};
         sdk::REMethodDefinition* method{nullptr};
-        uintptr_t jitted_function{};
         bool skip{false};
         size_t hook_id{};
         uint32_t call_count{};
@@ -248,8 +305,6 @@ private:
         std::unordered_map<sdk::REMethodDefinition*, CallerContext> callers_context{};
     };
 
-    asmjit::JitRuntime m_jit_runtime;
-
     std::vector<PinnedObject> m_pinned_objects{};
     std::vector<HookedMethod> m_hooked_methods{};
     std::deque<std::string> m_current_path{};
@@ -282,7 +337,13 @@ private:
     std::unordered_map<std::string, REType*> m_types;
     std::vector<std::string> m_sorted_types;
 
-    std::mutex m_enum_mutex;
+    std::future<std::unique_ptr<SearchIndices>> m_search_indices_future{};
+    std::unique_ptr<SearchIndices> m_search_indices{};
+    std::optional<Search> m_search{};
+    CachedRegex m_method_regex{};
+    CachedRegex m_field_regex{};
+
+    std::shared_mutex m_enum_mutex;
 
     // Types currently being displayed
     std::vector<REType*> m_displayed_types;
@@ -296,17 +357,17 @@ private:
         NONE = -1,
         DUMP_INITIALIZATION,
         DUMP_TYPES,
-        DUMP_RSZ,
         DUMP_METHODS,
         DUMP_FIELDS,
         DUMP_PROPERTIES,
-        DUMP_RSZ_2,
         DUMP_DESERIALIZER_CHAIN,
         DUMP_NON_TDB_TYPES,
+        WRITE_JSON,
         GENERATE_SDK
     };
 
     std::atomic<bool> m_dumping_sdk{ false };
+    bool m_compact_sdk_dump{ false };
     std::atomic<float> m_sdk_dump_progress{ 0.0f };
     std::atomic<SdkDumpStage> m_sdk_dump_stage{ SdkDumpStage::NONE };
 };
@@ -0,0 +1,211 @@
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+
+#include "TrigramIndex.hpp"
+
+void TrigramIndex::add(std::string_view str, uint32_t owner) {
+    auto it = m_ids.find(std::string{str});
+
+    if (it == m_ids.end()) {
+        it = m_ids.emplace(std::string{str}, (uint32_t)size()).first;
+
+        m_pool.append(str);
+        m_offsets.push_back((uint32_t)m_pool.size());
+    }
+
+    m_pending_owners.emplace_back(it->second, owner);
+}
+
+void TrigramIndex::finalize() {
+    const auto n = size();
+
+    // Owners, grouped by string id
+    std::sort(m_pending_owners.begin(), m_pending_owners.end());
+    m_pending_owners.erase(std::unique(m_pending_owners.begin(), m_pending_owners.end()), m_pending_owners.end());
+
+    m_owner_offsets.assign(n + 1, 0);
+    m_owners.reserve(m_pending_owners.size());
+
+    for (const auto& [id, owner] : m_pending_owners) {
+        ++m_owner_offsets[id + 1];
+        m_owners.push_back(owner);
+    }
+
+    std::partial_sum(m_owner_offsets.begin(), m_owner_offsets.end(), m_owner_offsets.begin());
+
+    // Postings, a (trigram, id) pair for every position, sorted so each trigram's ids end up contiguous
+    std::vector<uint64_t> pairs{};
+    pairs.reserve(m_pool.size());
+
+    for (uint32_t id = 0; id < n; ++id) {
+        const auto s = get(id);
+
+        for (size_t i = 0; i + 3 <= s.size(); ++i) {
+            pairs.push_back(((uint64_t)trigram_at(s, i) << 32) | id);
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    m_postings.reserve(pairs.size());
+
+    for (const auto pair : pairs) {
+        const auto trigram = (uint32_t)(pair >> 32);
+
+        if (m_trigrams.empty() || m_trigrams.back() != trigram) {
+            m_trigrams.push_back(trigram);
+            m_posting_offsets.push_back((uint32_t)m_postings.size());
+        }
+
+        m_postings.push_back((uint32_t)pair);
+    }
+
+    m_posting_offsets.push_back((uint32_t)m_postings.size());
+
+    m_ids = {};
+    m_pending_owners = {};
+}
+
+std::vector<uint32_t> TrigramIndex::all_ids() const {
+    std::vector<uint32_t> out(size());
+    std::iota(out.begin(), out.end(), 0);
+
+    return out;
+}
+
+std::vector<uint32_t> TrigramIndex::candidates(std::string_view needle) const {
+    if (needle.size() < 3) {
+        return all_ids();
+    }
+
+    std::vector<std::span<const uint32_t>> lists{};
+
+    for (size_t i = 0; i + 3 <= needle.size(); ++i) {
+        const auto trigram = trigram_at(needle, i);
+        const auto it = std::lower_bound(m_trigrams.begin(), m_trigrams.end(), trigram);
+
+        if (it == m_trigrams.end() || *it != trigram) {
+            return {};
+        }
+
+        const auto index = (size_t)(it - m_trigrams.begin());
+        lists.push_back(std::span{m_postings}.subspan(m_posting_offsets[index], m_posting_offsets[index + 1] - m_posting_offsets[index]));
+    }
+
+    // Start from the rarest trigram so the intermediate results stay small
+    std::sort(lists.begin(), lists.end(), [](const auto& a, const auto& b) { return a.size() < b.size(); });
+
+    std::vector<uint32_t> out{lists[0].begin(), lists[0].end()};
+    std::vector<uint32_t> scratch{};
+
+    for (size_t i = 1; i < lists.size() && !out.empty(); ++i) {
+        if (lists[i].data() == lists[i - 1].data()) {
+            continue; // repeated trigram
+        }
+
+        scratch.clear();
+        std::set_intersection(out.begin(), out.end(), lists[i].begin(), lists[i].end(), std::back_inserter(scratch));
+        std::swap(out, scratch);
+    }
+
+    return out;
+}
+
+std::vector<uint32_t> TrigramIndex::regex_candidates(std::string_view pattern) const {
+    // Only literals outside of groups and alternations are guaranteed to be part of every match,
+    // anything unusual just gives up and returns every string.
+    std::string best{};
+    std::string run{};
+    size_t depth = 0;
+
+    const auto flush = [&]() {
+        if (run.size() > best.size()) {
+            best = run;
+        }
+
+        run.clear();
+    };
+
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        const auto c = pattern[i];
+
+        switch (c) {
+        case '|':
+            return all_ids();
+        case '\\':
+            if (i + 1 >= pattern.size()) {
+                return all_ids();
+            }
+
+            if (std::isalnum((uint8_t)pattern[i + 1])) {
+                // Character classes, anchors, backreferences and escape sequences
+                flush();
+
+                switch (pattern[i + 1]) {
+                case 'x': i += 2; break;
+                case 'u': i += 4; break;
+                case 'c': i += 1; break;
+                default: break;
+                }
+            } else if (depth == 0) {
+                run.push_back(pattern[i + 1]);
+            }
+
+            ++i;
+            break;
+        case '[':
+            flush();
+
+            for (++i; i < pattern.size() && pattern[i] != ']'; ++i) {
+                if (pattern[i] == '\\') {
+                    ++i;
+                }
+            }
+
+            break;
+        case '(':
+            flush();
+            ++depth;
+            break;
+        case ')':
+            flush();
+            depth = depth > 0 ? depth - 1 : 0;
+            break;
+        case '*':
+        case '?':
+        case '{':
+            // The previous character is optional
+            if (!run.empty()) {
+                run.pop_back();
+            }
+
+            flush();
+
+            if (c == '{') {
+                i = std::min(pattern.find('}', i), pattern.size());
+            }
+
+            break;
+        case '+':
+        case '.':
+        case '^':
+        case '$':
+            flush();
+            break;
+        default:
+            if (depth == 0) {
+                run.push_back(c);
+            } else {
+                flush();
+            }
+
+            break;
+        }
+    }
+
+    flush();
+
+    return candidates(best);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Substring index over a set of strings, used by the ObjectExplorer searches.
+// Every string is stored once and can belong to any number of owners (e.g. the types that have a method with that name).
+// Queries return candidate string ids, which still need to be checked against the actual needle or regex.
+class TrigramIndex {
+public:
+    void add(std::string_view str, uint32_t owner);
+
+    // Builds the posting lists, nothing can be added afterwards
+    void finalize();
+
+    size_t size() const {
+        return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+    }
+
+    std::string_view get(uint32_t id) const {
+        return std::string_view{m_pool}.substr(m_offsets[id], m_offsets[id + 1] - m_offsets[id]);
+    }
+
+    std::span<const uint32_t> get_owners(uint32_t id) const {
+        return std::span{m_owners}.subspan(m_owner_offsets[id], m_owner_offsets[id + 1] - m_owner_offsets[id]);
+    }
+
+    // Every string containing all the trigrams of needle, sorted by id.
+    // Needles shorter than a trigram can't be narrowed down, so every string is returned.
+    std::vector<uint32_t> candidates(std::string_view needle) const;
+
+    // Same as candidates(), but for a regex pattern. Narrows down using the longest literal
+    // every match has to contain, falls back to every string if there's none.
+    std::vector<uint32_t> regex_candidates(std::string_view pattern) const;
+
+private:
+    static uint32_t trigram_at(std::string_view s, size_t i) {
+        return ((uint32_t)(uint8_t)s[i] << 16) | ((uint32_t)(uint8_t)s[i + 1] << 8) | (uint32_t)(uint8_t)s[i + 2];
+    }
+
+    std::vector<uint32_t> all_ids() const;
+
+    // Only used while adding
+    std::unordered_map<std::string, uint32_t> m_ids{};
+    std::vector<std::pair<uint32_t, uint32_t>> m_pending_owners{};
+
+    std::string m_pool{};
+    std::vector<uint32_t> m_offsets{0};
+
+    // String id -> owners
+    std::vector<uint32_t> m_owner_offsets{};
+    std::vector<uint32_t> m_owners{};
+
+    // Sorted trigrams, m_postings[m_posting_offsets[i]..m_posting_offsets[i + 1]] are the ids containing m_trigrams[i]
+    std::vector<uint32_t> m_trigrams{};
+    std::vector<uint32_t> m_posting_offsets{};
+    std::vector<uint32_t> m_postings{};
+};
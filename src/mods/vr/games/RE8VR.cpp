@@ -472,7 +472,7 @@ void RE8VR::update_body_ik(glm::quat* camera_rotation, Vector4f* camera_pos) {
 
     auto transform = m_player->transform;
 
-    static uint32_t head_hash = sdk::murmur_hash::calc32("Head");
+    static constexpr auto head_hash = sdk::murmur_hash::calc32_constexpr(L"Head");
     
     const auto transform_rot = sdk::get_transform_rotation(transform);
     const auto transform_pos = sdk::get_transform_position(transform);
@@ -1018,11 +1018,11 @@ void RE8VR::fix_player_shadow() {
                 auto mesh_gameobject = mesh->ownerGameObject;
 
                 if (mesh_gameobject != nullptr && mesh_gameobject->transform != nullptr) {
-                    static auto head_hash = sdk::murmur_hash::calc32("Head");
-                    static auto neck_hash = sdk::murmur_hash::calc32("Neck");
-                    static auto neck_1_hash = sdk::murmur_hash::calc32("Neck_1");
-                    static auto neck_0_hash = sdk::murmur_hash::calc32("Neck_0");
-                    static auto chest_hash = sdk::murmur_hash::calc32("Chest");
+                    static constexpr auto head_hash = sdk::murmur_hash::calc32_constexpr(L"Head");
+                    static constexpr auto neck_hash = sdk::murmur_hash::calc32_constexpr(L"Neck");
+                    static constexpr auto neck_1_hash = sdk::murmur_hash::calc32_constexpr(L"Neck_1");
+                    static constexpr auto neck_0_hash = sdk::murmur_hash::calc32_constexpr(L"Neck_0");
+                    static constexpr auto chest_hash = sdk::murmur_hash::calc32_constexpr(L"Chest");
                     
                     // Must be done in reverse order to preserve the head position.
                     copy_joint(chest_hash, m_player->transform, mesh_gameobject->transform);
@@ -1046,11 +1046,11 @@ void RE8VR::fix_player_shadow() {
             auto mesh_gameobject = upper_mesh->ownerGameObject;
 
             if (mesh_gameobject != nullptr && mesh_gameobject->transform != nullptr) {
-                static auto head_hash = sdk::murmur_hash::calc32("Head");
-                static auto neck_hash = sdk::murmur_hash::calc32("Neck");
-                static auto neck_1_hash = sdk::murmur_hash::calc32("Neck_1");
-                static auto neck_0_hash = sdk::murmur_hash::calc32("Neck_0");
-                static auto chest_hash = sdk::murmur_hash::calc32("Chest");
+                static constexpr auto head_hash = sdk::murmur_hash::calc32_constexpr(L"Head");
+                static constexpr auto neck_hash = sdk::murmur_hash::calc32_constexpr(L"Neck");
+                static constexpr auto neck_1_hash = sdk::murmur_hash::calc32_constexpr(L"Neck_1");
+                static constexpr auto neck_0_hash = sdk::murmur_hash::calc32_constexpr(L"Neck_0");
+                static constexpr auto chest_hash = sdk::murmur_hash::calc32_constexpr(L"Chest");
                 
                 // Must be done in reverse order to preserve the head position.
                 copy_joint(chest_hash, m_player->transform, mesh_gameobject->transform);
@@ -1378,7 +1378,7 @@ void RE8VR::update_block_gesture() {
     m_wants_block = left_hand_up && right_hand_up;
 }
 
-HookManager::PreHookResult RE8VR::pre_shadow_late_update(std::vector<uintptr_t>& args, std::vector<sdk::RETypeDefinition*>& arg_tys, uintptr_t ret_addr) {
+HookManager::PreHookResult RE8VR::pre_shadow_late_update(std::span<uintptr_t> args, std::span<sdk::RETypeDefinition*> arg_tys, uintptr_t ret_addr) {
     auto& vr = VR::get();
     auto& re8vr = RE8VR::get();
 